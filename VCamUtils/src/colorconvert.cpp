@@ -17,8 +17,11 @@
  * Web-Site: http://webcamoid.github.io/
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <ostream>
+#include <vector>
 
 #include "colorconvert.h"
 #include "videoformat.h"
@@ -31,8 +34,20 @@ namespace AkVCam
             ColorConvert *self {nullptr};
             ColorConvert::YuvColorSpace m_yuvColorSpace {ColorConvert::YuvColorSpace_ITUR_BT601};
             ColorConvert::YuvColorSpaceType m_yuvColorSpaceType {ColorConvert::YuvColorSpaceType_StudioSwing};
+            std::vector<int32_t> m_tables8bits;
+            ColorConvert::Precision m_colorPrecision {ColorConvert::Precision_64};
+            ColorConvert::Precision m_alphaPrecision {ColorConvert::Precision_64};
+            int64_t m_maxAlphaInputs[3] {0, 0, 0};
+            ColorConvert::AlphaMode m_alphaMode {ColorConvert::AlphaMode_Straight};
+            uint32_t m_backgroundColor {0xff000000};
 
             explicit ColorConvertPrivate(ColorConvert *self);
+            ColorConvert::Precision colorPrecision(const int64_t *maxInputs,
+                                                   int64_t *maxSums=nullptr) const;
+            ColorConvert::Precision alphaPrecision(const int64_t *maxInputs,
+                                                   int64_t maxAlpha) const;
+            void copyTables8bits(const ColorConvertPrivate *other);
+            void loadTables8bits(int abits, int bbits, int cbits);
             void rbConstants(ColorConvert::YuvColorSpace colorSpace,
                              int64_t &kr,
                              int64_t &kb,
@@ -88,13 +103,16 @@ namespace AkVCam
                                     int ybits,
                                     int ubits,
                                     int vbits);
-            void loadAlphaRgbMatrix(int alphaBits);
-            void loadAlphaYuvMatrix(ColorConvert::YuvColorSpaceType yuvColorSpaceType,
-                                    int alphaBits,
-                                    int ybits,
-                                    int ubits,
-                                    int vbits);
-            void loadAlphaGrayMatrix(int alphaBits, int graybits);
+            void colorPoint(VideoFormatSpec::VideoFormatType formatType,
+                            uint32_t color,
+                            int obitsx,
+                            int obitsy,
+                            int obitsz,
+                            int64_t *point) const;
+            void loadAlphaMatrix(int alphaBits,
+                                 int obits,
+                                 const int64_t *black,
+                                 const int64_t *background);
     };
 }
 
@@ -125,14 +143,22 @@ AkVCam::ColorConvert::ColorConvert(const ColorConvert &other)
     this->m00 = other.m00; this->m01 = other.m01; this->m02 = other.m02; this->m03 = other.m03;
     this->m10 = other.m10; this->m11 = other.m11; this->m12 = other.m12; this->m13 = other.m13;
     this->m20 = other.m20; this->m21 = other.m21; this->m22 = other.m22; this->m23 = other.m23;
-    this->a00 = other.a00; this->a01 = other.a01; this->a02 = other.a02;
-    this->a10 = other.a10; this->a11 = other.a11; this->a12 = other.a12;
-    this->a20 = other.a20; this->a21 = other.a21; this->a22 = other.a22;
+    this->a00 = other.a00; this->a01 = other.a01; this->a02 = other.a02; this->a03 = other.a03;
+    this->a10 = other.a10; this->a11 = other.a11; this->a12 = other.a12; this->a13 = other.a13;
+    this->a20 = other.a20; this->a21 = other.a21; this->a22 = other.a22; this->a23 = other.a23;
     this->xmin = other.xmin; this->xmax = other.xmax;
     this->ymin = other.ymin; this->ymax = other.ymax;
     this->zmin = other.zmin; this->zmax = other.zmax;
     this->colorShift = other.colorShift;
     this->alphaShift = other.alphaShift;
+    this->d->m_colorPrecision = other.d->m_colorPrecision;
+    this->d->m_alphaPrecision = other.d->m_alphaPrecision;
+    std::copy_n(other.d->m_maxAlphaInputs, 3, this->d->m_maxAlphaInputs);
+    this->d->m_alphaMode = other.d->m_alphaMode;
+    this->d->m_backgroundColor = other.d->m_backgroundColor;
+    this->matrix32bits = other.matrix32bits;
+    this->alpha32bits = other.alpha32bits;
+    this->d->copyTables8bits(other.d);
 }
 
 AkVCam::ColorConvert::~ColorConvert()
@@ -148,14 +174,22 @@ AkVCam::ColorConvert &AkVCam::ColorConvert::operator =(const ColorConvert &other
         this->m00 = other.m00; this->m01 = other.m01; this->m02 = other.m02; this->m03 = other.m03;
         this->m10 = other.m10; this->m11 = other.m11; this->m12 = other.m12; this->m13 = other.m13;
         this->m20 = other.m20; this->m21 = other.m21; this->m22 = other.m22; this->m23 = other.m23;
-        this->a00 = other.a00; this->a01 = other.a01; this->a02 = other.a02;
-        this->a10 = other.a10; this->a11 = other.a11; this->a12 = other.a12;
-        this->a20 = other.a20; this->a21 = other.a21; this->a22 = other.a22;
+        this->a00 = other.a00; this->a01 = other.a01; this->a02 = other.a02; this->a03 = other.a03;
+        this->a10 = other.a10; this->a11 = other.a11; this->a12 = other.a12; this->a13 = other.a13;
+        this->a20 = other.a20; this->a21 = other.a21; this->a22 = other.a22; this->a23 = other.a23;
         this->xmin = other.xmin; this->xmax = other.xmax;
         this->ymin = other.ymin; this->ymax = other.ymax;
         this->zmin = other.zmin; this->zmax = other.zmax;
         this->colorShift = other.colorShift;
         this->alphaShift = other.alphaShift;
+        this->d->m_colorPrecision = other.d->m_colorPrecision;
+        this->d->m_alphaPrecision = other.d->m_alphaPrecision;
+        std::copy_n(other.d->m_maxAlphaInputs, 3, this->d->m_maxAlphaInputs);
+        this->d->m_alphaMode = other.d->m_alphaMode;
+        this->d->m_backgroundColor = other.d->m_backgroundColor;
+        this->matrix32bits = other.matrix32bits;
+        this->alpha32bits = other.alpha32bits;
+        this->d->copyTables8bits(other.d);
     }
 
     return *this;
@@ -181,6 +215,26 @@ void AkVCam::ColorConvert::setYuvColorSpaceType(YuvColorSpaceType yuvColorSpaceT
     this->d->m_yuvColorSpaceType = yuvColorSpaceType;
 }
 
+AkVCam::ColorConvert::AlphaMode AkVCam::ColorConvert::alphaMode() const
+{
+    return this->d->m_alphaMode;
+}
+
+uint32_t AkVCam::ColorConvert::backgroundColor() const
+{
+    return this->d->m_backgroundColor;
+}
+
+void AkVCam::ColorConvert::setAlphaMode(AlphaMode alphaMode)
+{
+    this->d->m_alphaMode = alphaMode;
+}
+
+void AkVCam::ColorConvert::setBackgroundColor(uint32_t backgroundColor)
+{
+    this->d->m_backgroundColor = backgroundColor;
+}
+
 void AkVCam::ColorConvert::loadColorMatrix(ColorMatrix colorMatrix,
                                            int ibitsa,
                                            int ibitsb,
@@ -260,6 +314,26 @@ void AkVCam::ColorConvert::loadColorMatrix(ColorMatrix colorMatrix,
     default:
         break;
     }
+
+    const int64_t maxInputs[] {
+        (int64_t(1) << ibitsa) - 1,
+        (int64_t(1) << ibitsb) - 1,
+        (int64_t(1) << ibitsc) - 1,
+    };
+    int64_t maxSums[3];
+    this->d->m_colorPrecision = this->d->colorPrecision(maxInputs, maxSums);
+    this->matrix32bits =
+            this->d->m_colorPrecision != ColorConvert::Precision_64;
+
+    /* applyVector() and applyPoint() don't clamp their outputs, and some
+     * paths blend the inputs directly, so the alpha matrix must accept any
+     * of them.
+     */
+    for (int i = 0; i < 3; ++i)
+        this->d->m_maxAlphaInputs[i] =
+                std::max(maxInputs[i], (maxSums[i] >> this->colorShift) + 1);
+
+    this->d->loadTables8bits(ibitsa, ibitsb, ibitsc);
 }
 
 void AkVCam::ColorConvert::loadAlphaMatrix(VideoFormatSpec::VideoFormatType formatType,
@@ -268,29 +342,46 @@ void AkVCam::ColorConvert::loadAlphaMatrix(VideoFormatSpec::VideoFormatType form
                                            int obitsy,
                                            int obitsz)
 {
-    switch (formatType) {
-    case VideoFormatSpec::VFT_RGB:
-        this->d->loadAlphaRgbMatrix(ibitsAlpha);
-
-        break;
-
-    case VideoFormatSpec::VFT_YUV:
-        this->d->loadAlphaYuvMatrix(this->d->m_yuvColorSpaceType,
-                                    ibitsAlpha,
-                                    obitsx,
-                                    obitsy,
-                                    obitsz);
-
-        break;
-
-    case VideoFormatSpec::VFT_Gray:
-        this->d->loadAlphaGrayMatrix(ibitsAlpha, obitsx);
+    int64_t black[3];
+    this->d->colorPoint(formatType, 0xff000000, obitsx, obitsy, obitsz, black);
+    int64_t background[3];
+    this->d->colorPoint(formatType,
+                        this->d->m_backgroundColor,
+                        obitsx,
+                        obitsy,
+                        obitsz,
+                        background);
+    this->d->loadAlphaMatrix(ibitsAlpha,
+                             std::max({obitsx, obitsy, obitsz}),
+                             black,
+                             background);
+
+    // The alpha is applied to the output of the color matrix.
+    const int64_t maxInputs[] {
+        std::max({std::abs(this->xmin),
+                  std::abs(this->xmax),
+                  this->d->m_maxAlphaInputs[0]}),
+        std::max({std::abs(this->ymin),
+                  std::abs(this->ymax),
+                  this->d->m_maxAlphaInputs[1]}),
+        std::max({std::abs(this->zmin),
+                  std::abs(this->zmax),
+                  this->d->m_maxAlphaInputs[2]}),
+    };
+    this->d->m_alphaPrecision =
+            this->d->alphaPrecision(maxInputs, (int64_t(1) << ibitsAlpha) - 1);
+    this->alpha32bits =
+            this->d->m_alphaPrecision != ColorConvert::Precision_64;
+}
 
-        break;
+AkVCam::ColorConvert::Precision AkVCam::ColorConvert::colorPrecision() const
+{
+    return this->d->m_colorPrecision;
+}
 
-    default:
-        break;
-    }
+AkVCam::ColorConvert::Precision AkVCam::ColorConvert::alphaPrecision() const
+{
+    return this->d->m_alphaPrecision;
 }
 
 void AkVCam::ColorConvert::loadMatrix(const VideoFormatSpec &from,
@@ -481,12 +572,174 @@ std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::ColorMatrix co
     return os;
 }
 
+#define DEFINE_CASE_PRECISION(precision) \
+    case AkVCam::ColorConvert::precision: \
+        os << #precision; \
+        \
+        break;
+
+std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::Precision precision)
+{
+    switch (precision) {
+    DEFINE_CASE_PRECISION(Precision_16)
+    DEFINE_CASE_PRECISION(Precision_32)
+    DEFINE_CASE_PRECISION(Precision_64)
+
+    default:
+        os << "Precision_Unknown";
+
+        break;
+    }
+
+    return os;
+}
+
+#define DEFINE_CASE_ALPHA_MODE(mode) \
+    case AkVCam::ColorConvert::mode: \
+        os << #mode; \
+        \
+        break;
+
+std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::AlphaMode alphaMode)
+{
+    switch (alphaMode) {
+    DEFINE_CASE_ALPHA_MODE(AlphaMode_Straight)
+    DEFINE_CASE_ALPHA_MODE(AlphaMode_Premultiplied)
+
+    default:
+        os << "AlphaMode_Unknown";
+
+        break;
+    }
+
+    return os;
+}
+
 AkVCam::ColorConvertPrivate::ColorConvertPrivate(ColorConvert *self):
     self(self)
 {
 
 }
 
+AkVCam::ColorConvert::Precision AkVCam::ColorConvertPrivate::colorPrecision(const int64_t *maxInputs,
+                                                                            int64_t *maxSums) const
+{
+    static const int64_t max16 = std::numeric_limits<int16_t>::max();
+    static const int64_t max32 = std::numeric_limits<int32_t>::max();
+
+    const int64_t matrix[3][4] {
+        {self->m00, self->m01, self->m02, self->m03},
+        {self->m10, self->m11, self->m12, self->m13},
+        {self->m20, self->m21, self->m22, self->m23},
+    };
+
+    auto precision = ColorConvert::Precision_16;
+
+    for (int row = 0; row < 3; ++row) {
+        // Worst case of a * m0 + b * m1 + c * m2 + m3
+
+        int64_t sum = std::abs(matrix[row][3]);
+
+        for (int col = 0; col < 3; ++col) {
+            auto k = std::abs(matrix[row][col]);
+
+            if (k > max16 && precision == ColorConvert::Precision_16)
+                precision = ColorConvert::Precision_32;
+
+            sum += maxInputs[col] * k;
+        }
+
+        if (maxSums)
+            maxSums[row] = sum;
+
+        if (sum > max32)
+            precision = ColorConvert::Precision_64;
+    }
+
+    return precision;
+}
+
+AkVCam::ColorConvert::Precision AkVCam::ColorConvertPrivate::alphaPrecision(const int64_t *maxInputs,
+                                                                            int64_t maxAlpha) const
+{
+    static const int64_t max16 = std::numeric_limits<int16_t>::max();
+    static const int64_t max32 = std::numeric_limits<int32_t>::max();
+
+    const int64_t matrix[3][4] {
+        {self->a00, self->a01, self->a02, self->a03},
+        {self->a10, self->a11, self->a12, self->a13},
+        {self->a20, self->a21, self->a22, self->a23},
+    };
+
+    auto precision = ColorConvert::Precision_16;
+
+    for (int row = 0; row < 3; ++row) {
+        // Worst case of a * (p * k0 + k1) + p * k3 + k2
+
+        int64_t product = maxInputs[row] * std::abs(matrix[row][0])
+                          + std::abs(matrix[row][1]);
+        int64_t sum = maxAlpha * product
+                      + maxInputs[row] * std::abs(matrix[row][3])
+                      + std::abs(matrix[row][2]);
+
+        if (std::abs(matrix[row][0]) > max16
+            || std::abs(matrix[row][1]) > max16
+            || std::abs(matrix[row][3]) > max16
+            || product > max16)
+            precision = ColorConvert::Precision_32;
+
+        if (sum > max32)
+            return ColorConvert::Precision_64;
+    }
+
+    return precision;
+}
+
+void AkVCam::ColorConvertPrivate::copyTables8bits(const ColorConvertPrivate *other)
+{
+    this->m_tables8bits = other->m_tables8bits;
+    self->tables8bits = this->m_tables8bits.empty()?
+                            nullptr:
+                            this->m_tables8bits.data();
+}
+
+void AkVCam::ColorConvertPrivate::loadTables8bits(int abits,
+                                                  int bbits,
+                                                  int cbits)
+{
+    this->m_tables8bits.clear();
+    self->tables8bits = nullptr;
+
+    if (abits > 8 || bbits > 8 || cbits > 8)
+        return;
+
+    // The sum of the three products must fit in 32 bits.
+
+    static const int64_t maxInputs[] {255, 255, 255};
+
+    if (this->colorPrecision(maxInputs) == ColorConvert::Precision_64)
+        return;
+
+    const int64_t matrix[3][4] {
+        {self->m00, self->m01, self->m02, self->m03},
+        {self->m10, self->m11, self->m12, self->m13},
+        {self->m20, self->m21, self->m22, self->m23},
+    };
+
+    this->m_tables8bits.resize(3 * 3 * 256);
+    auto table = this->m_tables8bits.data();
+
+    for (int row = 0; row < 3; ++row)
+        for (int col = 0; col < 3; ++col) {
+            auto offset = col == 0? matrix[row][3]: 0;
+
+            for (int value = 0; value < 256; ++value)
+                *table++ = int32_t(value * matrix[row][col] + offset);
+        }
+
+    self->tables8bits = this->m_tables8bits.data();
+}
+
 void AkVCam::ColorConvertPrivate::rbConstants(AkVCam::ColorConvert::YuvColorSpace colorSpace,
                                               int64_t &kr,
                                               int64_t &kb,
@@ -949,82 +1202,76 @@ void AkVCam::ColorConvertPrivate::loadGray2yuvMatrix(ColorConvert::YuvColorSpace
     self->colorShift = shift;
 }
 
-void AkVCam::ColorConvertPrivate::loadAlphaRgbMatrix(int alphaBits)
+void AkVCam::ColorConvertPrivate::colorPoint(VideoFormatSpec::VideoFormatType formatType,
+                                             uint32_t color,
+                                             int obitsx,
+                                             int obitsy,
+                                             int obitsz,
+                                             int64_t *point) const
 {
-    int64_t amax = (1L << alphaBits) - 1;
-    self->alphaShift = alphaBits;
-    int64_t shiftDiv = 1L << self->alphaShift;
-    int64_t rounding = 1L << (self->alphaShift - 1);
-
-    auto k = this->roundedDiv(shiftDiv, amax);
-
-    self->a00 = k; self->a01 = 0; self->a02 = rounding;
-    self->a10 = k; self->a11 = 0; self->a12 = rounding;
-    self->a20 = k; self->a21 = 0; self->a22 = rounding;
+    auto colorMatrix = ColorConvert::ColorMatrix_ABC2XYZ;
 
-}
-
-void AkVCam::ColorConvertPrivate::loadAlphaYuvMatrix(ColorConvert::YuvColorSpaceType yuvColorSpaceType,
-                                                     int alphaBits,
-                                                     int ybits,
-                                                     int ubits,
-                                                     int vbits)
-{
-    int64_t amax = (1L << alphaBits) - 1;
-    self->alphaShift = alphaBits;
-    int64_t shiftDiv = 1L << self->alphaShift;
-    int64_t rounding = 1L << (self->alphaShift - 1);
-
-    uint64_t k = shiftDiv / amax;
+    switch (formatType) {
+    case VideoFormatSpec::VFT_YUV:
+        colorMatrix = ColorConvert::ColorMatrix_RGB2YUV;
 
-    int64_t minY = 0;
-    int64_t maxY = 0;
-    this->limitsY(ybits, yuvColorSpaceType, minY, maxY);
-    int64_t ky = -this->roundedDiv(shiftDiv * minY, amax);
+        break;
 
-    int64_t minU = 0;
-    int64_t maxU = 0;
-    this->limitsUV(ubits, yuvColorSpaceType, minU, maxU);
-    int64_t ku = -this->roundedDiv(shiftDiv * (minU + maxU), 2 * amax);
+    case VideoFormatSpec::VFT_Gray:
+        colorMatrix = ColorConvert::ColorMatrix_RGB2GRAY;
 
-    int64_t minV = 0;
-    int64_t maxV = 0;
-    this->limitsUV(vbits, yuvColorSpaceType, minV, maxV);
-    int64_t kv = -this->roundedDiv(shiftDiv * (minV + maxV), 2 * amax);
+        break;
 
-    int64_t ciy = rounding + shiftDiv * minY;
-    int64_t ciu = rounding + shiftDiv * (minU + maxU) / 2;
-    int64_t civ = rounding + shiftDiv * (minV + maxV) / 2;
+    default:
+        break;
+    }
 
-    self->a00 = k; self->a01 = ky; self->a02 = ciy;
-    self->a10 = k; self->a11 = ku; self->a12 = ciu;
-    self->a20 = k; self->a21 = kv; self->a22 = civ;
+    ColorConvert colorConvert(this->m_yuvColorSpace, this->m_yuvColorSpaceType);
+    colorConvert.loadColorMatrix(colorMatrix, 8, 8, 8, obitsx, obitsy, obitsz);
+    colorConvert.applyMatrix((color >> 16) & 0xff,
+                             (color >> 8) & 0xff,
+                             color & 0xff,
+                             point,
+                             point + 1,
+                             point + 2);
 }
 
-void AkVCam::ColorConvertPrivate::loadAlphaGrayMatrix(int alphaBits,
-                                                      int graybits)
+void AkVCam::ColorConvertPrivate::loadAlphaMatrix(int alphaBits,
+                                                  int obits,
+                                                  const int64_t *black,
+                                                  const int64_t *background)
 {
-    ColorConvert::YuvColorSpaceType otype = ColorConvert::YuvColorSpaceType_FullSwing;
-
-    int64_t amax = (1L << alphaBits) - 1;
-    self->alphaShift = alphaBits;
-    int64_t shiftDiv = 1L << self->alphaShift;
-    int64_t rounding = 1L << (self->alphaShift - 1);
-
-    auto k = this->roundedDiv(self->alphaShift, amax);
-
-    int64_t minU = 0;
-    int64_t maxU = 0;
-    this->limitsUV(graybits, otype, minU, maxU);
-
-    int64_t minV = 0;
-    int64_t maxV = 0;
-    this->limitsUV(graybits, otype, minV, maxV);
+    /* The shift is big enough for rounding the blending exactly, as long as
+     * the products fit in 64 bits.
+     */
+    int64_t amax = (int64_t(1) << alphaBits) - 1;
+    self->alphaShift = std::min(2 * alphaBits + obits + 1, 61 - obits);
+    int64_t shiftDiv = int64_t(1) << self->alphaShift;
+    int64_t rounding = int64_t(1) << (self->alphaShift - 1);
 
-    int64_t ciu = rounding + shiftDiv * (minU + maxU) / 2;
-    int64_t civ = rounding + shiftDiv * (minV + maxV) / 2;
+    auto k = this->roundedDiv(shiftDiv, amax);
+    int64_t *matrix[3][4] {
+        {&self->a00, &self->a01, &self->a02, &self->a03},
+        {&self->a10, &self->a11, &self->a12, &self->a13},
+        {&self->a20, &self->a21, &self->a22, &self->a23},
+    };
 
-    self->a00 = k; self->a01 = 0; self->a02 = rounding;
-    self->a10 = 0; self->a11 = 0; self->a12 = ciu;
-    self->a20 = 0; self->a21 = 0; self->a22 = civ;
+    for (int row = 0; row < 3; ++row) {
+        if (this->m_alphaMode == ColorConvert::AlphaMode_Premultiplied) {
+            // p + (background - black) * (amax - a) / amax
+
+            auto diff = background[row] - black[row];
+            *matrix[row][0] = 0;
+            *matrix[row][1] = -diff * k;
+            *matrix[row][2] = diff * shiftDiv + rounding;
+            *matrix[row][3] = shiftDiv;
+        } else {
+            // (p * a + background * (amax - a)) / amax
+
+            *matrix[row][0] = k;
+            *matrix[row][1] = -background[row] * k;
+            *matrix[row][2] = background[row] * shiftDiv + rounding;
+            *matrix[row][3] = 0;
+        }
+    }
 }
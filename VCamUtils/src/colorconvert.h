@@ -20,6 +20,8 @@
 #ifndef AKVCAMUTILS_COLORCONVERT_H
 #define AKVCAMUTILS_COLORCONVERT_H
 
+#include <cstdint>
+
 #include "videoformattypes.h"
 #include "videoformatspec.h"
 #include "utils.h"
@@ -57,6 +59,23 @@ namespace AkVCam
                 ColorMatrix_GRAY2YUV,
             };
 
+            enum Precision
+            {
+                Precision_16,
+                Precision_32,
+                Precision_64,
+            };
+
+            enum AlphaMode
+            {
+                // The color components are independent of the alpha.
+                AlphaMode_Straight,
+
+                // The color components were already multiplied by the alpha,
+                // that is, composited over black.
+                AlphaMode_Premultiplied,
+            };
+
             ColorConvert();
             ColorConvert(YuvColorSpace yuvColorSpace,
                          YuvColorSpaceType yuvColorSpaceType=YuvColorSpaceType_StudioSwing);
@@ -69,6 +88,16 @@ namespace AkVCam
             YuvColorSpaceType yuvColorSpaceType() const;
             void setYuvColorSpace(YuvColorSpace yuvColorSpace);
             void setYuvColorSpaceType(YuvColorSpaceType yuvColorSpaceType);
+
+            /* The frames with alpha are composited over the background color
+             * when converted to a format without alpha. The alpha of the
+             * background color is ignored.
+             */
+            AlphaMode alphaMode() const;
+            uint32_t backgroundColor() const;
+            void setAlphaMode(AlphaMode alphaMode);
+            void setBackgroundColor(uint32_t backgroundColor);
+
             void loadColorMatrix(ColorMatrix colorMatrix,
                                  int ibitsa,
                                  int ibitsb,
@@ -86,17 +115,68 @@ namespace AkVCam
             void loadMatrix(PixelFormat from,
                             PixelFormat to);
 
+            /* Smallest integer width that can be used for applying the
+             * loaded matrices without overflowing, for the bit depths given
+             * to loadColorMatrix() and loadAlphaMatrix().
+             *
+             * Precision_16 means that the coefficients fit in 16 bits and the
+             * sums of the products fit in 32 bits, so the vector units can
+             * multiply and accumulate in 16x16->32 bits lanes. Precision_32
+             * means that the coefficients and the sums fit in 32 bits, then the
+             * scalar paths use 32 bits arithmetic on 32 bits CPUs, where the
+             * 64 bits products are emulated.
+             */
+            Precision colorPrecision() const;
+            Precision alphaPrecision() const;
+
             inline void applyMatrix(int64_t a, int64_t b, int64_t c,
                                     int64_t *x, int64_t *y, int64_t *z) const
             {
+                if (this->use32bits(this->matrix32bits)) {
+                    *x = bound<int64_t>(this->xmin, this->mad32(a, this->m00, b, this->m01, c, this->m02, this->m03) >> this->colorShift, this->xmax);
+                    *y = bound<int64_t>(this->ymin, this->mad32(a, this->m10, b, this->m11, c, this->m12, this->m13) >> this->colorShift, this->ymax);
+                    *z = bound<int64_t>(this->zmin, this->mad32(a, this->m20, b, this->m21, c, this->m22, this->m23) >> this->colorShift, this->zmax);
+
+                    return;
+                }
+
                 *x = bound(this->xmin, (a * this->m00 + b * this->m01 + c * this->m02 + this->m03) >> this->colorShift, this->xmax);
                 *y = bound(this->ymin, (a * this->m10 + b * this->m11 + c * this->m12 + this->m13) >> this->colorShift, this->ymax);
                 *z = bound(this->zmin, (a * this->m20 + b * this->m21 + c * this->m22 + this->m23) >> this->colorShift, this->zmax);
             }
 
+            // Whether the 8 bits input tables are available.
+            inline bool has8bitsTables() const
+            {
+                return this->tables8bits != nullptr;
+            }
+
+            /* Same as applyMatrix() for 8 bits inputs, but reading the
+             * product of each input component by its coefficient from a
+             * table. The results are exactly the same.
+             */
+            inline void applyMatrix8bits(int64_t a, int64_t b, int64_t c,
+                                         int64_t *x, int64_t *y, int64_t *z) const
+            {
+                auto tx = this->tables8bits;
+                auto ty = tx + 3 * 256;
+                auto tz = ty + 3 * 256;
+                *x = bound<int64_t>(this->xmin, (tx[a] + tx[256 + b] + tx[512 + c]) >> this->colorShift, this->xmax);
+                *y = bound<int64_t>(this->ymin, (ty[a] + ty[256 + b] + ty[512 + c]) >> this->colorShift, this->ymax);
+                *z = bound<int64_t>(this->zmin, (tz[a] + tz[256 + b] + tz[512 + c]) >> this->colorShift, this->zmax);
+            }
+
             inline void applyVector(int64_t a, int64_t b, int64_t c,
                                     int64_t *x, int64_t *y, int64_t *z) const
             {
+                if (this->use32bits(this->matrix32bits)) {
+                    *x = this->mad32(a, this->m00, this->m03) >> this->colorShift;
+                    *y = this->mad32(b, this->m11, this->m13) >> this->colorShift;
+                    *z = this->mad32(c, this->m22, this->m23) >> this->colorShift;
+
+                    return;
+                }
+
                 *x = (a * this->m00 + this->m03) >> this->colorShift;
                 *y = (b * this->m11 + this->m13) >> this->colorShift;
                 *z = (c * this->m22 + this->m23) >> this->colorShift;
@@ -105,6 +185,14 @@ namespace AkVCam
             inline void applyPoint(int64_t p,
                                    int64_t *x, int64_t *y, int64_t *z) const
             {
+                if (this->use32bits(this->matrix32bits)) {
+                    *x = this->mad32(p, this->m00, this->m03) >> this->colorShift;
+                    *y = this->mad32(p, this->m10, this->m13) >> this->colorShift;
+                    *z = this->mad32(p, this->m20, this->m23) >> this->colorShift;
+
+                    return;
+                }
+
                 *x = (p * this->m00 + this->m03) >> this->colorShift;
                 *y = (p * this->m10 + this->m13) >> this->colorShift;
                 *z = (p * this->m20 + this->m23) >> this->colorShift;
@@ -113,20 +201,47 @@ namespace AkVCam
             inline void applyPoint(int64_t a, int64_t b, int64_t c,
                                    int64_t *p) const
             {
+                if (this->use32bits(this->matrix32bits)) {
+                    *p = bound<int64_t>(this->xmin, this->mad32(a, this->m00, b, this->m01, c, this->m02, this->m03) >> this->colorShift, this->xmax);
+
+                    return;
+                }
+
                 *p = bound(this->xmin, (a * this->m00 + b * this->m01 + c * this->m02 + this->m03) >> this->colorShift, this->xmax);
             }
 
+            inline void applyPoint8bits(int64_t a, int64_t b, int64_t c,
+                                        int64_t *p) const
+            {
+                auto tx = this->tables8bits;
+                *p = bound<int64_t>(this->xmin, (tx[a] + tx[256 + b] + tx[512 + c]) >> this->colorShift, this->xmax);
+            }
+
             inline void applyPoint(int64_t p, int64_t *q) const
             {
+                if (this->use32bits(this->matrix32bits)) {
+                    *q = this->mad32(p, this->m00, this->m03) >> this->colorShift;
+
+                    return;
+                }
+
                 *q = (p * this->m00 + this->m03) >> this->colorShift;
             }
 
             inline void applyAlpha(int64_t x, int64_t y, int64_t z, int64_t a,
                                    int64_t *xa, int64_t *ya, int64_t *za) const
             {
-                *xa = bound<int64_t>(this->xmin, (a * (x * this->a00 + this->a01) + this->a02) >> this->alphaShift, this->xmax);
-                *ya = bound<int64_t>(this->ymin, (a * (y * this->a10 + this->a11) + this->a12) >> this->alphaShift, this->ymax);
-                *za = bound<int64_t>(this->zmin, (a * (z * this->a20 + this->a21) + this->a22) >> this->alphaShift, this->zmax);
+                if (this->use32bits(this->alpha32bits)) {
+                    *xa = bound<int64_t>(this->xmin, this->mad32(a, this->mad32(x, this->a00, this->a01), x, this->a03, this->a02) >> this->alphaShift, this->xmax);
+                    *ya = bound<int64_t>(this->ymin, this->mad32(a, this->mad32(y, this->a10, this->a11), y, this->a13, this->a12) >> this->alphaShift, this->ymax);
+                    *za = bound<int64_t>(this->zmin, this->mad32(a, this->mad32(z, this->a20, this->a21), z, this->a23, this->a22) >> this->alphaShift, this->zmax);
+
+                    return;
+                }
+
+                *xa = bound<int64_t>(this->xmin, (a * (x * this->a00 + this->a01) + x * this->a03 + this->a02) >> this->alphaShift, this->xmax);
+                *ya = bound<int64_t>(this->ymin, (a * (y * this->a10 + this->a11) + y * this->a13 + this->a12) >> this->alphaShift, this->ymax);
+                *za = bound<int64_t>(this->zmin, (a * (z * this->a20 + this->a21) + z * this->a23 + this->a22) >> this->alphaShift, this->zmax);
             }
 
             inline void applyAlpha(int64_t a,
@@ -137,7 +252,13 @@ namespace AkVCam
 
             inline void applyAlpha(int64_t p, int64_t a, int64_t *pa) const
             {
-                *pa = bound<int64_t>(this->ymin, (a * (p * this->a00 + this->a01) + this->a02) >> this->alphaShift, this->ymax);
+                if (this->use32bits(this->alpha32bits)) {
+                    *pa = bound<int64_t>(this->xmin, this->mad32(a, this->mad32(p, this->a00, this->a01), p, this->a03, this->a02) >> this->alphaShift, this->xmax);
+
+                    return;
+                }
+
+                *pa = bound<int64_t>(this->xmin, (a * (p * this->a00 + this->a01) + p * this->a03 + this->a02) >> this->alphaShift, this->xmax);
             }
 
             inline void applyAlpha(int64_t a, int64_t *p) const
@@ -170,18 +291,21 @@ namespace AkVCam
                     colorMatrix[11] = static_cast<T>(this->m23);
                 }
 
-                // Copy the alpha matrix (3x3)
+                // Copy the alpha matrix (3x4)
 
                 if (alphaMatrix) {
-                    alphaMatrix[0] = static_cast<T>(this->a00);
-                    alphaMatrix[1] = static_cast<T>(this->a01);
-                    alphaMatrix[2] = static_cast<T>(this->a02);
-                    alphaMatrix[3] = static_cast<T>(this->a10);
-                    alphaMatrix[4] = static_cast<T>(this->a11);
-                    alphaMatrix[5] = static_cast<T>(this->a12);
-                    alphaMatrix[6] = static_cast<T>(this->a20);
-                    alphaMatrix[7] = static_cast<T>(this->a21);
-                    alphaMatrix[8] = static_cast<T>(this->a22);
+                    alphaMatrix[0]  = static_cast<T>(this->a00);
+                    alphaMatrix[1]  = static_cast<T>(this->a01);
+                    alphaMatrix[2]  = static_cast<T>(this->a02);
+                    alphaMatrix[3]  = static_cast<T>(this->a03);
+                    alphaMatrix[4]  = static_cast<T>(this->a10);
+                    alphaMatrix[5]  = static_cast<T>(this->a11);
+                    alphaMatrix[6]  = static_cast<T>(this->a12);
+                    alphaMatrix[7]  = static_cast<T>(this->a13);
+                    alphaMatrix[8]  = static_cast<T>(this->a20);
+                    alphaMatrix[9]  = static_cast<T>(this->a21);
+                    alphaMatrix[10] = static_cast<T>(this->a22);
+                    alphaMatrix[11] = static_cast<T>(this->a23);
                 }
 
                 // Copy limits
@@ -210,16 +334,50 @@ namespace AkVCam
         private:
             ColorConvertPrivate *d;
 
+            inline static bool use32bits(bool fits32bits)
+            {
+                return sizeof(void *) < sizeof(int64_t) && fits32bits;
+            }
+
+            inline static int32_t mad32(int64_t a, int64_t ka, int64_t k)
+            {
+                return int32_t(a) * int32_t(ka) + int32_t(k);
+            }
+
+            inline static int32_t mad32(int64_t a, int64_t ka,
+                                        int64_t b, int64_t kb,
+                                        int64_t k)
+            {
+                return int32_t(a) * int32_t(ka)
+                       + int32_t(b) * int32_t(kb)
+                       + int32_t(k);
+            }
+
+            inline static int32_t mad32(int64_t a, int64_t ka,
+                                        int64_t b, int64_t kb,
+                                        int64_t c, int64_t kc,
+                                        int64_t k)
+            {
+                return int32_t(a) * int32_t(ka)
+                       + int32_t(b) * int32_t(kb)
+                       + int32_t(c) * int32_t(kc)
+                       + int32_t(k);
+            }
+
         protected:
             // Color matrix
             int64_t m00 {0}, m01 {0}, m02 {0}, m03 {0};
             int64_t m10 {0}, m11 {0}, m12 {0}, m13 {0};
             int64_t m20 {0}, m21 {0}, m22 {0}, m23 {0};
 
-            // Alpha matrix
-            int64_t a00 {0}, a01 {0}, a02 {0};
-            int64_t a10 {0}, a11 {0}, a12 {0};
-            int64_t a20 {0}, a21 {0}, a22 {0};
+            /* Alpha matrix, the components are composited over the
+             * background as:
+             *
+             * (a * (p * k0 + k1) + p * k3 + k2) >> alphaShift
+             */
+            int64_t a00 {0}, a01 {0}, a02 {0}, a03 {0};
+            int64_t a10 {0}, a11 {0}, a12 {0}, a13 {0};
+            int64_t a20 {0}, a21 {0}, a22 {0}, a23 {0};
 
             int64_t xmin {0}, xmax {0};
             int64_t ymin {0}, ymax {0};
@@ -228,6 +386,16 @@ namespace AkVCam
             int64_t colorShift {0};
             int64_t alphaShift {0};
 
+            /* Products of every 8 bits input value by the color matrix
+             * coefficients, indexed as [output][input][value]. The offsets
+             * are added to the first input.
+             */
+            const int32_t *tables8bits {nullptr};
+
+            // Whether the matrices can be applied with 32 bits arithmetic.
+            bool matrix32bits {false};
+            bool alpha32bits {false};
+
         friend class ColorConvertPrivate;
     };
 }
@@ -235,5 +403,7 @@ namespace AkVCam
 std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::YuvColorSpace yuvColorSpace);
 std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType);
 std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::ColorMatrix colorMatrix);
+std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::Precision precision);
+std::ostream &operator <<(std::ostream &os, AkVCam::ColorConvert::AlphaMode alphaMode);
 
 #endif // AKVCAMUTILS_COLORCONVERT_H
@@ -21,160 +21,106 @@
 #include <cstdlib>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 #include "fraction.h"
 #include "utils.h"
 
 namespace AkVCam
 {
-    class FractionPrivate
-    {
-        public:
-            int64_t m_num;
-            int64_t m_den;
-
-            template<typename T> inline static int sign(T value)
-            {
-                return value < 0? -1: 1;
-            }
-    };
-}
+    static_assert(std::is_trivially_copyable_v<Fraction>,
+                  "Fraction must be copyable without allocating");
 
-AkVCam::Fraction::Fraction()
-{
-    this->d = new FractionPrivate;
-    this->d->m_num = 0;
-    this->d->m_den = 0;
+    template<typename T> inline static int signOf(T value)
+    {
+        return value < 0? -1: 1;
+    }
 }
 
-AkVCam::Fraction::Fraction(int64_t num, int64_t den)
+AkVCam::Fraction::Fraction(int64_t num, int64_t den):
+    m_num(num),
+    m_den(den)
 {
-    this->d = new FractionPrivate;
-    this->d->m_num = num;
-    this->d->m_den = den;
 }
 
 AkVCam::Fraction::Fraction(const std::string &str)
 {
-    this->d = new FractionPrivate;
-    this->d->m_num = 0;
-    this->d->m_den = 1;
+    this->m_num = 0;
+    this->m_den = 1;
     auto pos = str.find('/');
 
     if (pos == std::string::npos) {
         auto strCpy = trimmed(str);
-        this->d->m_num = uint32_t(strtol(strCpy.c_str(), nullptr, 10));
+        this->m_num = uint32_t(strtol(strCpy.c_str(), nullptr, 10));
     } else {
         auto numStr = trimmed(str.substr(0, pos));
         auto denStr = trimmed(str.substr(pos + 1));
 
-        this->d->m_num = uint32_t(strtol(numStr.c_str(), nullptr, 10));
-        this->d->m_den = uint32_t(strtol(denStr.c_str(), nullptr, 10));
+        this->m_num = uint32_t(strtol(numStr.c_str(), nullptr, 10));
+        this->m_den = uint32_t(strtol(denStr.c_str(), nullptr, 10));
 
-        if (this->d->m_den < 1) {
-            this->d->m_num = 0;
-            this->d->m_den = 1;
+        if (this->m_den < 1) {
+            this->m_num = 0;
+            this->m_den = 1;
         }
     }
 }
 
-AkVCam::Fraction::Fraction(const Fraction &other)
-{
-    this->d = new FractionPrivate;
-    this->d->m_num = other.d->m_num;
-    this->d->m_den = other.d->m_den;
-}
-
-AkVCam::Fraction::~Fraction()
-{
-    delete this->d;
-}
-
-AkVCam::Fraction &AkVCam::Fraction::operator =(const Fraction &other)
-{
-    if (this != &other) {
-        this->d->m_num = other.d->m_num;
-        this->d->m_den = other.d->m_den;
-    }
-
-    return *this;
-}
-
 bool AkVCam::Fraction::operator ==(const Fraction &other) const
 {
-    if (this->d->m_den == 0 && other.d->m_den != 0)
+    if (this->m_den == 0 && other.m_den != 0)
         return false;
 
-    if (this->d->m_den != 0 && other.d->m_den == 0)
+    if (this->m_den != 0 && other.m_den == 0)
         return false;
 
-    return this->d->m_num * other.d->m_den == this->d->m_den * other.d->m_num;
+    return this->m_num * other.m_den == this->m_den * other.m_num;
 }
 
 bool AkVCam::Fraction::operator <(const Fraction &other) const
 {
-    return this->d->m_num * other.d->m_den < this->d->m_den * other.d->m_num;
+    return this->m_num * other.m_den < this->m_den * other.m_num;
 }
 
 AkVCam::Fraction::operator bool() const
 {
-    return this->d->m_den != 0;
-}
-
-int64_t AkVCam::Fraction::num() const
-{
-    return this->d->m_num;
-}
-
-int64_t &AkVCam::Fraction::num()
-{
-    return this->d->m_num;
-}
-
-int64_t AkVCam::Fraction::den() const
-{
-    return this->d->m_den;
-}
-
-int64_t &AkVCam::Fraction::den()
-{
-    return this->d->m_den;
+    return this->m_den != 0;
 }
 
 double AkVCam::Fraction::value() const
 {
-    if (!this->d->m_den)
+    if (!this->m_den)
         return std::numeric_limits<double>::quiet_NaN();
 
-    return double(this->d->m_num) / double(this->d->m_den);
+    return double(this->m_num) / double(this->m_den);
 }
 
 std::string AkVCam::Fraction::toString() const
 {
     std::stringstream ss;
-    ss << this->d->m_num << '/' << this->d->m_den;
+    ss << this->m_num << '/' << this->m_den;
 
     return ss.str();
 }
 
 bool AkVCam::Fraction::isValid() const
 {
-    return this->d->m_den != 0;
+    return this->m_den != 0;
 }
 
 bool AkVCam::Fraction::isNull() const
 {
-    return this->d->m_num == 0 || this->d->m_den == 0;
+    return this->m_num == 0 || this->m_den == 0;
 }
 
 bool AkVCam::Fraction::isInfinity() const
 {
-    return this->d->m_num != 0 && this->d->m_den == 0;
+    return this->m_num != 0 && this->m_den == 0;
 }
 
 int AkVCam::Fraction::sign() const
 {
-    return FractionPrivate::sign(this->d->m_num) == FractionPrivate::sign(this->d->m_den)? 1: -1;
+    return signOf(this->m_num) == signOf(this->m_den)? 1: -1;
 }
 
 bool AkVCam::Fraction::isFraction(const std::string &str)
@@ -26,26 +26,43 @@
 namespace AkVCam
 {
     class Fraction;
-    class FractionPrivate;
     using FractionRange = std::pair<Fraction, Fraction>;
 
+    // The fraction is stored inline and it's trivially copyable, so copying
+    // it never allocates.
     class Fraction
     {
         public:
-            Fraction();
+            Fraction() = default;
             Fraction(int64_t num, int64_t den);
             Fraction(const std::string &str);
-            Fraction(const Fraction &other);
-            virtual ~Fraction();
-            Fraction &operator =(const Fraction &other);
+            Fraction(const Fraction &other) = default;
+            ~Fraction() = default;
+            Fraction &operator =(const Fraction &other) = default;
             bool operator ==(const Fraction &other) const;
             bool operator <(const Fraction &other) const;
             operator bool() const;
 
-            int64_t num() const;
-            int64_t &num();
-            int64_t den() const;
-            int64_t &den();
+            inline int64_t num() const
+            {
+                return this->m_num;
+            }
+
+            inline int64_t &num()
+            {
+                return this->m_num;
+            }
+
+            inline int64_t den() const
+            {
+                return this->m_den;
+            }
+
+            inline int64_t &den()
+            {
+                return this->m_den;
+            }
+
             double value() const;
             std::string toString() const;
             bool isValid() const;
@@ -55,7 +72,8 @@ namespace AkVCam
             static bool isFraction(const std::string &str);
 
         private:
-            FractionPrivate *d;
+            int64_t m_num {0};
+            int64_t m_den {0};
     };
 }
 
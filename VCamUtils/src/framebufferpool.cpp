@@ -0,0 +1,399 @@
+/* akvirtualcamera, virtual camera for Mac and Windows.
+ * Copyright (C) 2025  Gonzalo Exequiel Pedone
+ *
+ * akvirtualcamera is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * akvirtualcamera is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with akvirtualcamera. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Web-Site: http://webcamoid.github.io/
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "framebufferpool.h"
+
+// Default maximum size of the idle buffers.
+#define POOL_MAX_SIZE (128 * 1024 * 1024)
+
+// Maximum number of idle buffers kept by each thread, enough for the
+// pixels and the private data of a few frames.
+#define THREAD_CACHE_SIZE 8
+
+// Bytes reserved after the pixels of each buffer for the control block of
+// its shared pointer.
+#define CONTROL_BLOCK_SIZE 128
+
+namespace AkVCam
+{
+    struct PooledBuffer
+    {
+        uint8_t *data;
+        size_t size;
+        size_t alignment;
+
+        inline bool isSame(size_t size, size_t alignment) const
+        {
+            return this->size == size && this->alignment == alignment;
+        }
+
+        // The control block is stored after the pixels.
+        inline uint8_t *controlBlock() const
+        {
+            return this->data + controlBlockOffset(this->size);
+        }
+
+        inline static size_t controlBlockOffset(size_t size)
+        {
+            const size_t align = alignof(std::max_align_t);
+
+            return (size + align - 1) & ~(align - 1);
+        }
+    };
+
+    /* Allocates the control block of the shared pointer of a buffer in the
+     * same memory of the buffer, so the buffers are recycled without
+     * allocating.
+     *
+     * The buffer goes back to the pool when the control block is
+     * deallocated, since that is the last time its memory is used, and not
+     * when the pixels are released.
+     */
+    template <typename T>
+    class PoolAllocator
+    {
+        public:
+            using value_type = T;
+
+            PooledBuffer m_buffer;
+            std::weak_ptr<FrameBufferPoolPrivate> m_pool;
+
+            PoolAllocator(const PooledBuffer &buffer,
+                          const std::weak_ptr<FrameBufferPoolPrivate> &pool):
+                m_buffer(buffer),
+                m_pool(pool)
+            {
+            }
+
+            template <typename U>
+            PoolAllocator(const PoolAllocator<U> &other):
+                m_buffer(other.m_buffer),
+                m_pool(other.m_pool)
+            {
+            }
+
+            T *allocate(size_t n);
+            void deallocate(T *ptr, size_t n);
+
+            template <typename U>
+            inline bool operator ==(const PoolAllocator<U> &other) const
+            {
+                return this->m_buffer.data == other.m_buffer.data;
+            }
+
+            template <typename U>
+            inline bool operator !=(const PoolAllocator<U> &other) const
+            {
+                return this->m_buffer.data != other.m_buffer.data;
+            }
+    };
+
+    class FrameBufferPoolPrivate
+    {
+        public:
+            std::weak_ptr<FrameBufferPoolPrivate> m_self;
+            std::mutex m_mutex;
+
+            // Idle buffers shared by all threads, from the least to the most
+            // recently released.
+            std::vector<PooledBuffer> m_buffers;
+
+            // Size of the idle buffers, including the ones kept by the
+            // threads.
+            std::atomic<size_t> m_size {0};
+            std::atomic<size_t> m_maxSize {POOL_MAX_SIZE};
+
+            ~FrameBufferPoolPrivate();
+            uint8_t *take(size_t size, size_t alignment);
+            void recycle(const PooledBuffer &buffer);
+
+            // Makes room for size bytes of idle buffers, freeing the least
+            // recently released shared buffers if needed.
+            bool reserve(size_t size);
+
+            static uint8_t *allocate(size_t size, size_t alignment);
+            static void release(const PooledBuffer &buffer);
+    };
+
+    // Idle buffers kept by a thread, from the least to the most recently
+    // released.
+    class ThreadBufferCache
+    {
+        public:
+            std::weak_ptr<FrameBufferPoolPrivate> m_pool;
+            std::vector<PooledBuffer> m_buffers;
+
+            ~ThreadBufferCache();
+    };
+
+    /* The flag is trivially destructible, so it can still be read while the
+     * thread destroys the cache or after that, when the buffers released
+     * from other thread local objects must go to the shared list.
+     */
+    static thread_local bool threadCacheDestroyed = false;
+
+    static ThreadBufferCache *threadBufferCache();
+}
+
+AkVCam::FrameBufferPool::FrameBufferPool()
+{
+    this->d = std::make_shared<FrameBufferPoolPrivate>();
+    this->d->m_self = this->d;
+}
+
+AkVCam::FrameBufferPool::~FrameBufferPool()
+{
+}
+
+AkVCam::FrameBufferPool &AkVCam::FrameBufferPool::instance()
+{
+    static FrameBufferPool pool;
+
+    return pool;
+}
+
+AkVCam::FrameBufferPool::Buffer AkVCam::FrameBufferPool::buffer(size_t size,
+                                                                size_t alignment)
+{
+    auto data = this->d->take(size, alignment);
+
+    if (!data)
+        data = FrameBufferPoolPrivate::allocate(size, alignment);
+
+    // The allocator recycles the buffer, so there is nothing to delete.
+    return Buffer(data,
+                  [] (uint8_t *) {},
+                  PoolAllocator<uint8_t>({data, size, alignment}, this->d));
+}
+
+size_t AkVCam::FrameBufferPool::maxSize() const
+{
+    return this->d->m_maxSize;
+}
+
+void AkVCam::FrameBufferPool::setMaxSize(size_t maxSize)
+{
+    this->d->m_maxSize = maxSize;
+    this->d->reserve(0);
+}
+
+size_t AkVCam::FrameBufferPool::size() const
+{
+    return this->d->m_size;
+}
+
+void AkVCam::FrameBufferPool::clear()
+{
+    auto cache = threadBufferCache();
+
+    if (cache) {
+        for (auto &buffer: cache->m_buffers) {
+            this->d->m_size -= buffer.size;
+            FrameBufferPoolPrivate::release(buffer);
+        }
+
+        cache->m_buffers.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(this->d->m_mutex);
+
+    for (auto &buffer: this->d->m_buffers) {
+        this->d->m_size -= buffer.size;
+        FrameBufferPoolPrivate::release(buffer);
+    }
+
+    this->d->m_buffers.clear();
+}
+
+AkVCam::FrameBufferPoolPrivate::~FrameBufferPoolPrivate()
+{
+    for (auto &buffer: this->m_buffers)
+        release(buffer);
+}
+
+uint8_t *AkVCam::FrameBufferPoolPrivate::take(size_t size, size_t alignment)
+{
+    // Try first with the buffers released by this thread, the most recent
+    // ones are the most likely to be still in the cache.
+
+    auto cache = threadBufferCache();
+
+    if (cache) {
+        auto &buffers = cache->m_buffers;
+
+        for (auto it = buffers.rbegin(); it != buffers.rend(); ++it)
+            if (it->isSame(size, alignment)) {
+                auto data = it->data;
+                buffers.erase(std::next(it).base());
+                this->m_size -= size;
+
+                return data;
+            }
+    }
+
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+
+    for (auto it = this->m_buffers.rbegin(); it != this->m_buffers.rend(); ++it)
+        if (it->isSame(size, alignment)) {
+            auto data = it->data;
+            this->m_buffers.erase(std::next(it).base());
+            this->m_size -= size;
+
+            return data;
+        }
+
+    return nullptr;
+}
+
+void AkVCam::FrameBufferPoolPrivate::recycle(const PooledBuffer &buffer)
+{
+    if (!this->reserve(buffer.size)) {
+        release(buffer);
+
+        return;
+    }
+
+    auto shared = buffer;
+    auto cache = threadBufferCache();
+
+    if (cache) {
+        auto &buffers = cache->m_buffers;
+
+        if (cache->m_pool.expired())
+            cache->m_pool = this->m_self;
+
+        if (buffers.size() < THREAD_CACHE_SIZE) {
+            buffers.push_back(buffer);
+
+            return;
+        }
+
+        // The thread cache is full, share its least recently released
+        // buffer with the other threads.
+        shared = buffers.front();
+        buffers.erase(buffers.begin());
+        buffers.push_back(buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_buffers.push_back(shared);
+}
+
+bool AkVCam::FrameBufferPoolPrivate::reserve(size_t size)
+{
+    size_t maxSize = this->m_maxSize;
+
+    if (size > maxSize)
+        return false;
+
+    if (this->m_size.fetch_add(size) + size <= maxSize)
+        return true;
+
+    this->m_size -= size;
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    auto it = this->m_buffers.begin();
+
+    for (; it != this->m_buffers.end() && this->m_size + size > maxSize; ++it) {
+        this->m_size -= it->size;
+        release(*it);
+    }
+
+    this->m_buffers.erase(this->m_buffers.begin(), it);
+
+    if (this->m_size + size > maxSize)
+        return false;
+
+    this->m_size += size;
+
+    return true;
+}
+
+uint8_t *AkVCam::FrameBufferPoolPrivate::allocate(size_t size,
+                                                  size_t alignment)
+{
+    size = PooledBuffer::controlBlockOffset(size) + CONTROL_BLOCK_SIZE;
+
+    return static_cast<uint8_t *>(::operator new[](size,
+                                                   std::align_val_t(alignment)));
+}
+
+void AkVCam::FrameBufferPoolPrivate::release(const PooledBuffer &buffer)
+{
+    ::operator delete[](buffer.data, std::align_val_t(buffer.alignment));
+}
+
+template <typename T>
+T *AkVCam::PoolAllocator<T>::allocate(size_t n)
+{
+    if (n * sizeof(T) <= CONTROL_BLOCK_SIZE
+        && alignof(T) <= alignof(std::max_align_t))
+        return reinterpret_cast<T *>(this->m_buffer.controlBlock());
+
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+void AkVCam::PoolAllocator<T>::deallocate(T *ptr, size_t n)
+{
+    if (reinterpret_cast<uint8_t *>(ptr) != this->m_buffer.controlBlock())
+        ::operator delete(ptr, n * sizeof(T));
+
+    auto pool = this->m_pool.lock();
+
+    if (pool)
+        pool->recycle(this->m_buffer);
+    else
+        FrameBufferPoolPrivate::release(this->m_buffer);
+}
+
+AkVCam::ThreadBufferCache::~ThreadBufferCache()
+{
+    threadCacheDestroyed = true;
+    auto pool = this->m_pool.lock();
+
+    if (!pool) {
+        for (auto &buffer: this->m_buffers)
+            FrameBufferPoolPrivate::release(buffer);
+
+        return;
+    }
+
+    // Give the buffers to the other threads.
+
+    std::lock_guard<std::mutex> lock(pool->m_mutex);
+    pool->m_buffers.insert(pool->m_buffers.end(),
+                           this->m_buffers.begin(),
+                           this->m_buffers.end());
+}
+
+AkVCam::ThreadBufferCache *AkVCam::threadBufferCache()
+{
+    if (threadCacheDestroyed)
+        return nullptr;
+
+    static thread_local ThreadBufferCache cache;
+
+    return &cache;
+}
@@ -0,0 +1,78 @@
+/* akvirtualcamera, virtual camera for Mac and Windows.
+ * Copyright (C) 2025  Gonzalo Exequiel Pedone
+ *
+ * akvirtualcamera is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * akvirtualcamera is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with akvirtualcamera. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Web-Site: http://webcamoid.github.io/
+ */
+
+#ifndef AKVCAMUTILS_FRAMEBUFFERPOOL_H
+#define AKVCAMUTILS_FRAMEBUFFERPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace AkVCam
+{
+    class FrameBufferPoolPrivate;
+
+    /* Recycles the pixel buffers of the frames.
+     *
+     * The released buffers are kept for the next frames with the same size
+     * and alignment, so a stream of frames of the same format stops
+     * allocating pixel buffers after the first frames. Each thread keeps the
+     * last buffers it released, so most buffers are recycled without
+     * locking, and the older ones go to a list shared by all threads. When
+     * the idle buffers exceed maxSize() the least recently released ones are
+     * freed. The control block of the shared pointer of each buffer is
+     * stored in the buffer itself, so recycling a buffer does not allocate
+     * at all.
+     */
+    class FrameBufferPool
+    {
+        public:
+            using Buffer = std::shared_ptr<uint8_t []>;
+
+            FrameBufferPool(const FrameBufferPool &other) = delete;
+            FrameBufferPool &operator =(const FrameBufferPool &other) = delete;
+
+            static FrameBufferPool &instance();
+
+            // Returns a buffer of the given size and alignment, the buffer
+            // goes back to the pool when the last reference is released.
+            Buffer buffer(size_t size, size_t alignment);
+
+            // Maximum size in bytes of the idle buffers.
+            size_t maxSize() const;
+            void setMaxSize(size_t maxSize);
+
+            // Size in bytes of the idle buffers.
+            size_t size() const;
+
+            // Frees the idle buffers shared by all threads, and the ones kept
+            // by the calling thread.
+            void clear();
+
+        private:
+            // The released buffers can outlive the pool, so these only keep
+            // a weak reference to it.
+            std::shared_ptr<FrameBufferPoolPrivate> d;
+
+            FrameBufferPool();
+            ~FrameBufferPool();
+    };
+}
+
+#endif // AKVCAMUTILS_FRAMEBUFFERPOOL_H
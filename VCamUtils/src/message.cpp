@@ -17,6 +17,7 @@
  * Web-Site: http://webcamoid.github.io/
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include "message.h"
@@ -466,6 +467,7 @@ AkVCam::MsgFrameReady::MsgFrameReady(const Message &message):
         totalSize += sizeof(PixelFormat);
         totalSize += sizeof(int);
         totalSize += sizeof(int);
+        totalSize += 3 * sizeof(int64_t) + sizeof(uint64_t);
 
         size_t dataSize = 0;
         memcpy(&dataSize, message.data().data() + totalSize, sizeof(size_t));
@@ -501,16 +503,39 @@ AkVCam::MsgFrameReady::MsgFrameReady(const Message &message):
     memcpy(&height, message.data().data() + offset, sizeof(height));
     offset += sizeof(height);
 
+    int64_t pts = -1;
+    memcpy(&pts, message.data().data() + offset, sizeof(pts));
+    offset += sizeof(pts);
+
+    int64_t captureTime = -1;
+    memcpy(&captureTime, message.data().data() + offset, sizeof(captureTime));
+    offset += sizeof(captureTime);
+
+    int64_t duration = 0;
+    memcpy(&duration, message.data().data() + offset, sizeof(duration));
+    offset += sizeof(duration);
+
+    uint64_t sequence = 0;
+    memcpy(&sequence, message.data().data() + offset, sizeof(sequence));
+    offset += sizeof(sequence);
+
     size_t dataSize = 0;
     memcpy(&dataSize, message.data().data() + offset, sizeof(size_t));
     offset += sizeof(size_t);
 
     if (dataSize > 0) {
         this->d->m_frame = {VideoFormat(fourcc, width, height)};
-        memcpy(this->d->m_frame.data(), message.data().data() + offset, dataSize);
+        memcpy(this->d->m_frame.data(),
+               message.data().data() + offset,
+               std::min(dataSize, this->d->m_frame.size()));
         offset += dataSize;
     }
 
+    this->d->m_frame.setPts(pts);
+    this->d->m_frame.setCaptureTime(captureTime);
+    this->d->m_frame.setDuration(duration);
+    this->d->m_frame.setSequence(sequence);
+
     memcpy(&this->d->m_isActive, message.data().data() + offset, sizeof(this->d->m_isActive));
 }
 
@@ -541,13 +566,22 @@ bool AkVCam::MsgFrameReady::operator ==(const MsgFrameReady &other) const
 
 AkVCam::Message AkVCam::MsgFrameReady::toMessage() const
 {
+    /* The pixels are sent with the layout of the frames allocated by
+     * VideoFrame(format), so the frames wrapping external planes or
+     * referencing a rectangle of other frame are sent too.
+     */
+    size_t dataSize = this->d->m_frame?
+                          this->d->m_frame.format().dataSize():
+                          0;
     size_t totalSize = sizeof(size_t)
                        + this->d->m_device.size()
                        + sizeof(PixelFormat)
                        + sizeof(int)
                        + sizeof(int)
+                       + 3 * sizeof(int64_t)
+                       + sizeof(uint64_t)
                        + sizeof(size_t)
-                       + this->d->m_frame.size()
+                       + dataSize
                        + sizeof(this->d->m_isActive);
     std::vector<char> data(totalSize);
     size_t offset = 0;
@@ -573,12 +607,28 @@ AkVCam::Message AkVCam::MsgFrameReady::toMessage() const
     memcpy(data.data() + offset, &height, sizeof(height));
     offset += sizeof(height);
 
-    size_t dataSize = this->d->m_frame.size();
+    auto pts = this->d->m_frame.pts();
+    memcpy(data.data() + offset, &pts, sizeof(pts));
+    offset += sizeof(pts);
+
+    auto captureTime = this->d->m_frame.captureTime();
+    memcpy(data.data() + offset, &captureTime, sizeof(captureTime));
+    offset += sizeof(captureTime);
+
+    auto duration = this->d->m_frame.duration();
+    memcpy(data.data() + offset, &duration, sizeof(duration));
+    offset += sizeof(duration);
+
+    auto sequence = this->d->m_frame.sequence();
+    memcpy(data.data() + offset, &sequence, sizeof(sequence));
+    offset += sizeof(sequence);
+
     memcpy(data.data() + offset, &dataSize, sizeof(size_t));
     offset += sizeof(size_t);
 
     if (dataSize > 0) {
-        memcpy(data.data() + offset, this->d->m_frame.constData(), dataSize);
+        this->d->m_frame.copyTo(reinterpret_cast<uint8_t *>(data.data() + offset),
+                                dataSize);
         offset += dataSize;
     }
 
@@ -691,6 +741,7 @@ AkVCam::MsgBroadcast::MsgBroadcast(const Message &message):
         totalSize += sizeof(PixelFormat);
         totalSize += sizeof(int);
         totalSize += sizeof(int);
+        totalSize += 3 * sizeof(int64_t) + sizeof(uint64_t);
 
         size_t dataSize = 0;
         memcpy(&dataSize, message.data().data() + totalSize, sizeof(size_t));
@@ -727,6 +778,22 @@ AkVCam::MsgBroadcast::MsgBroadcast(const Message &message):
     memcpy(&height, message.data().data() + offset, sizeof(height));
     offset += sizeof(height);
 
+    int64_t pts = -1;
+    memcpy(&pts, message.data().data() + offset, sizeof(pts));
+    offset += sizeof(pts);
+
+    int64_t captureTime = -1;
+    memcpy(&captureTime, message.data().data() + offset, sizeof(captureTime));
+    offset += sizeof(captureTime);
+
+    int64_t duration = 0;
+    memcpy(&duration, message.data().data() + offset, sizeof(duration));
+    offset += sizeof(duration);
+
+    uint64_t sequence = 0;
+    memcpy(&sequence, message.data().data() + offset, sizeof(sequence));
+    offset += sizeof(sequence);
+
     size_t dataSize = 0;
     memcpy(&dataSize, message.data().data() + offset, sizeof(size_t));
     offset += sizeof(size_t);
@@ -739,6 +806,11 @@ AkVCam::MsgBroadcast::MsgBroadcast(const Message &message):
                    message.data().data() + offset,
                    std::min(dataSize, this->d->m_frame.size()));
     }
+
+    this->d->m_frame.setPts(pts);
+    this->d->m_frame.setCaptureTime(captureTime);
+    this->d->m_frame.setDuration(duration);
+    this->d->m_frame.setSequence(sequence);
 }
 
 AkVCam::MsgBroadcast::~MsgBroadcast()
@@ -768,14 +840,20 @@ bool AkVCam::MsgBroadcast::operator ==(const MsgBroadcast &other) const
 
 AkVCam::Message AkVCam::MsgBroadcast::toMessage() const
 {
+    // Same layout of the pixels as MsgFrameReady.
+    size_t dataSize = this->d->m_frame?
+                          this->d->m_frame.format().dataSize():
+                          0;
     size_t totalSize = sizeof(size_t)
                        + this->d->m_device.size()
                        + sizeof(this->d->m_pid)
                        + sizeof(PixelFormat)
                        + sizeof(int)
                        + sizeof(int)
+                       + 3 * sizeof(int64_t)
+                       + sizeof(uint64_t)
                        + sizeof(size_t)
-                       + this->d->m_frame.size();
+                       + dataSize;
     std::vector<char> data(totalSize);
     size_t offset = 0;
 
@@ -803,12 +881,28 @@ AkVCam::Message AkVCam::MsgBroadcast::toMessage() const
     memcpy(data.data() + offset, &height, sizeof(height));
     offset += sizeof(height);
 
-    size_t dataSize = this->d->m_frame.size();
+    auto pts = this->d->m_frame.pts();
+    memcpy(data.data() + offset, &pts, sizeof(pts));
+    offset += sizeof(pts);
+
+    auto captureTime = this->d->m_frame.captureTime();
+    memcpy(data.data() + offset, &captureTime, sizeof(captureTime));
+    offset += sizeof(captureTime);
+
+    auto duration = this->d->m_frame.duration();
+    memcpy(data.data() + offset, &duration, sizeof(duration));
+    offset += sizeof(duration);
+
+    auto sequence = this->d->m_frame.sequence();
+    memcpy(data.data() + offset, &sequence, sizeof(sequence));
+    offset += sizeof(sequence);
+
     memcpy(data.data() + offset, &dataSize, sizeof(size_t));
     offset += sizeof(size_t);
 
     if (dataSize > 0)
-        memcpy(data.data() + offset, this->d->m_frame.constData(), dataSize);
+        this->d->m_frame.copyTo(reinterpret_cast<uint8_t *>(data.data() + offset),
+                                dataSize);
 
     return {AKVCAM_SERVICE_MSG_BROADCAST, this->queryId(), data};
 }
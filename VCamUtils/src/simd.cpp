@@ -0,0 +1,2260 @@
+/* akvirtualcamera, virtual camera for Mac and Windows.
+ * Copyright (C) 2025  Gonzalo Exequiel Pedone
+ *
+ * akvirtualcamera is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * akvirtualcamera is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with akvirtualcamera. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Web-Site: http://webcamoid.github.io/
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <ostream>
+
+#if defined(__x86_64__) \
+    || defined(__i386__) \
+    || defined(_M_X64) \
+    || defined(_M_IX86)
+    #define AKVCAM_SIMD_X86
+    #include <immintrin.h>
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#elif defined(__aarch64__) \
+      || defined(_M_ARM64) \
+      || defined(__ARM_NEON)
+    #define AKVCAM_SIMD_NEON
+    #include <arm_neon.h>
+
+    #if defined(__APPLE__)
+        #include <sys/sysctl.h>
+    #elif defined(_WIN32)
+        #include <windows.h>
+    #elif defined(__linux__)
+        #include <sys/auxv.h>
+    #endif
+#endif
+
+/* The vector kernels are built for the baseline of the target architecture,
+ * so each x86 kernel must declare the instruction set it uses. MSVC does not
+ * needs it, the intrinsics are always available.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define AKVCAM_TARGET_SSE2
+    #define AKVCAM_TARGET_AVX2
+#else
+    #define AKVCAM_TARGET_SSE2 __attribute__((target("sse2")))
+    #define AKVCAM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#include "simd.h"
+#include "logger.h"
+
+namespace AkVCam
+{
+    namespace SimdPrivate
+    {
+        using Matrix3to3Type = void (*)(const Simd::ColorMatrix &matrix,
+                                        const uint8_t *a,
+                                        const uint8_t *b,
+                                        const uint8_t *c,
+                                        uint8_t *x,
+                                        uint8_t *y,
+                                        uint8_t *z,
+                                        int width);
+        using Matrix3to1Type = void (*)(const Simd::ColorMatrix &matrix,
+                                        const uint8_t *a,
+                                        const uint8_t *b,
+                                        const uint8_t *c,
+                                        uint8_t *x,
+                                        int width);
+        using Point1to3Type = void (*)(const Simd::ColorMatrix &matrix,
+                                       const uint8_t *p,
+                                       uint8_t *x,
+                                       uint8_t *y,
+                                       uint8_t *z,
+                                       int width);
+        using AlphaBlendType = void (*)(const Simd::AlphaMatrix &matrix,
+                                        const uint8_t *a,
+                                        uint8_t *const *planes,
+                                        int components,
+                                        int width);
+        using ArgbType = void (*)(uint32_t *line, int width);
+        using FillType = void (*)(uint8_t *data,
+                                  size_t size,
+                                  size_t pixelSize);
+
+        struct Kernels
+        {
+            Simd::Instruction instruction;
+            int blockSize;
+            Matrix3to3Type matrix3to3;
+            Matrix3to1Type matrix3to1;
+            Point1to3Type point1to3;
+            AlphaBlendType alphaBlend;
+            ArgbType grayScale;
+            ArgbType swapRgb;
+            ArgbType mirror;
+            FillType fill;
+        };
+
+        const Kernels &kernels();
+        Kernels selectKernels();
+        bool isSupported(Simd::Instruction instruction,
+                         Simd::Instruction cpuInstruction);
+
+        /* Scalar kernels, used for the pixels that does not fills a whole
+         * vector and when no vector unit is available.
+         */
+
+        template<bool clamp>
+        inline uint8_t scalarPoint(const Simd::ColorMatrix &matrix,
+                                   int row,
+                                   int32_t a,
+                                   int32_t b,
+                                   int32_t c)
+        {
+            int32_t p = (a * matrix.m[row][0]
+                         + b * matrix.m[row][1]
+                         + c * matrix.m[row][2]
+                         + matrix.offset[row]) >> matrix.shift;
+
+            if constexpr (clamp) {
+                if (p < matrix.min[row])
+                    p = matrix.min[row];
+                else if (p > matrix.max[row])
+                    p = matrix.max[row];
+            }
+
+            return uint8_t(p);
+        }
+
+        inline void scalarMatrix3to3(const Simd::ColorMatrix &matrix,
+                                     const uint8_t *a,
+                                     const uint8_t *b,
+                                     const uint8_t *c,
+                                     uint8_t *x,
+                                     uint8_t *y,
+                                     uint8_t *z,
+                                     int offset,
+                                     int width)
+        {
+            for (int i = offset; i < width; ++i) {
+                x[i] = scalarPoint<true>(matrix, 0, a[i], b[i], c[i]);
+                y[i] = scalarPoint<true>(matrix, 1, a[i], b[i], c[i]);
+                z[i] = scalarPoint<true>(matrix, 2, a[i], b[i], c[i]);
+            }
+        }
+
+        inline void scalarMatrix3to1(const Simd::ColorMatrix &matrix,
+                                     const uint8_t *a,
+                                     const uint8_t *b,
+                                     const uint8_t *c,
+                                     uint8_t *x,
+                                     int offset,
+                                     int width)
+        {
+            for (int i = offset; i < width; ++i)
+                x[i] = scalarPoint<true>(matrix, 0, a[i], b[i], c[i]);
+        }
+
+        inline void scalarPoint1to3(const Simd::ColorMatrix &matrix,
+                                    const uint8_t *p,
+                                    uint8_t *x,
+                                    uint8_t *y,
+                                    uint8_t *z,
+                                    int offset,
+                                    int width)
+        {
+            for (int i = offset; i < width; ++i) {
+                x[i] = scalarPoint<false>(matrix, 0, p[i], 0, 0);
+                y[i] = scalarPoint<false>(matrix, 1, p[i], 0, 0);
+                z[i] = scalarPoint<false>(matrix, 2, p[i], 0, 0);
+            }
+        }
+
+        inline uint8_t scalarAlpha(const Simd::AlphaMatrix &matrix,
+                                   int row,
+                                   int32_t p,
+                                   int32_t a)
+        {
+            auto background = matrix.background[row];
+            int32_t q = 0;
+
+            if (matrix.premultiplied) {
+                int32_t diff = (std::abs(background) * (255 - a) + 127) / 255;
+                q = background < 0? p - diff: p + diff;
+            } else {
+                q = (p * a + background * (255 - a) + 127) / 255;
+            }
+
+            if (q < matrix.min[row])
+                q = matrix.min[row];
+            else if (q > matrix.max[row])
+                q = matrix.max[row];
+
+            return uint8_t(q);
+        }
+
+        inline void scalarAlphaBlend(const Simd::AlphaMatrix &matrix,
+                                     const uint8_t *a,
+                                     uint8_t *const *planes,
+                                     int components,
+                                     int offset,
+                                     int width)
+        {
+            for (int i = offset; i < width; ++i)
+                for (int c = 0; c < components; ++c)
+                    planes[c][i] = scalarAlpha(matrix, c, planes[c][i], a[i]);
+        }
+
+        inline void scalarGrayScale(uint32_t *line, int offset, int width)
+        {
+            for (int x = offset; x < width; ++x) {
+                auto pixel = line[x];
+                uint32_t r = (pixel >> 16) & 0xff;
+                uint32_t g = (pixel >> 8) & 0xff;
+                uint32_t b = pixel & 0xff;
+                uint32_t luma = (11 * r + 16 * g + 5 * b) >> 5;
+                line[x] = (pixel & 0xff000000)
+                        | (luma << 16)
+                        | (luma << 8)
+                        | luma;
+            }
+        }
+
+        inline void scalarSwapRgb(uint32_t *line, int offset, int width)
+        {
+            for (int x = offset; x < width; ++x) {
+                auto pixel = line[x];
+                line[x] = (pixel & 0xff00ff00)
+                        | ((pixel >> 16) & 0xff)
+                        | ((pixel & 0xff) << 16);
+            }
+        }
+
+        inline void scalarMirror(uint32_t *line, int left, int right)
+        {
+            for (; right - left > 1; ++left, --right)
+                std::swap(line[left], line[right - 1]);
+        }
+
+        inline void scalarFill(uint8_t *data, size_t size, size_t pixelSize)
+        {
+            if (pixelSize < 1)
+                return;
+
+            // Duplicate the filled area on each step.
+
+            auto filled = std::min(pixelSize, size);
+
+            while (filled < size) {
+                auto copyBytes = std::min(filled, size - filled);
+                memcpy(data + filled, data, copyBytes);
+                filled += copyBytes;
+            }
+        }
+
+        void scalarMatrix3to3Kernel(const Simd::ColorMatrix &matrix,
+                                    const uint8_t *a,
+                                    const uint8_t *b,
+                                    const uint8_t *c,
+                                    uint8_t *x,
+                                    uint8_t *y,
+                                    uint8_t *z,
+                                    int width)
+        {
+            scalarMatrix3to3(matrix, a, b, c, x, y, z, 0, width);
+        }
+
+        void scalarMatrix3to1Kernel(const Simd::ColorMatrix &matrix,
+                                    const uint8_t *a,
+                                    const uint8_t *b,
+                                    const uint8_t *c,
+                                    uint8_t *x,
+                                    int width)
+        {
+            scalarMatrix3to1(matrix, a, b, c, x, 0, width);
+        }
+
+        void scalarPoint1to3Kernel(const Simd::ColorMatrix &matrix,
+                                   const uint8_t *p,
+                                   uint8_t *x,
+                                   uint8_t *y,
+                                   uint8_t *z,
+                                   int width)
+        {
+            scalarPoint1to3(matrix, p, x, y, z, 0, width);
+        }
+
+        void scalarAlphaBlendKernel(const Simd::AlphaMatrix &matrix,
+                                    const uint8_t *a,
+                                    uint8_t *const *planes,
+                                    int components,
+                                    int width)
+        {
+            scalarAlphaBlend(matrix, a, planes, components, 0, width);
+        }
+
+        void scalarGrayScaleKernel(uint32_t *line, int width)
+        {
+            scalarGrayScale(line, 0, width);
+        }
+
+        void scalarSwapRgbKernel(uint32_t *line, int width)
+        {
+            scalarSwapRgb(line, 0, width);
+        }
+
+        void scalarMirrorKernel(uint32_t *line, int width)
+        {
+            scalarMirror(line, 0, width);
+        }
+
+        inline Simd::ColorMatrix pointMatrix(const Simd::ColorMatrix &matrix)
+        {
+            // Only the first column of the matrix is used by the point
+            // kernels.
+
+            auto pointMatrix = matrix;
+
+            for (int row = 0; row < 3; ++row) {
+                pointMatrix.m[row][1] = 0;
+                pointMatrix.m[row][2] = 0;
+            }
+
+            return pointMatrix;
+        }
+
+        // Size of the smallest block of bytes that repeats the pattern and
+        // fills the whole vector registers, or 0 if it's too big.
+        inline size_t fillPeriod(size_t pixelSize, size_t registerSize)
+        {
+            if (pixelSize < 1)
+                return 0;
+
+            auto period = std::lcm(pixelSize, registerSize);
+
+            return period <= 4 * registerSize? period: 0;
+        }
+
+#ifdef AKVCAM_SIMD_X86
+        /* SSE2 kernels, 16 pixels by iteration.
+         *
+         * The 8 bits inputs are widened to 16 bits and interleaved in (a, b)
+         * and (c, 0) pairs, so each row of the matrix is resolved with two
+         * _mm_madd_epi16 calls.
+         */
+
+        struct Sse2Row
+        {
+            __m128i kab;
+            __m128i kc;
+            __m128i offset;
+            __m128i min;
+            __m128i max;
+        };
+
+        inline int32_t pair16(int16_t low, int16_t high)
+        {
+            return int32_t(uint32_t(uint16_t(low))
+                           | (uint32_t(uint16_t(high)) << 16));
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline Sse2Row sse2Row(const Simd::ColorMatrix &matrix, int row)
+        {
+            return {
+                _mm_set1_epi32(pair16(matrix.m[row][0], matrix.m[row][1])),
+                _mm_set1_epi32(pair16(matrix.m[row][2], 0)),
+                _mm_set1_epi32(matrix.offset[row]),
+                _mm_set1_epi16(matrix.min[row]),
+                _mm_set1_epi16(matrix.max[row])
+            };
+        }
+
+        template<bool clamp>
+        AKVCAM_TARGET_SSE2
+        inline __m128i sse2Convert(const __m128i *ab,
+                                   const __m128i *cz,
+                                   const Sse2Row &row,
+                                   __m128i shift)
+        {
+            __m128i sum[4];
+
+            for (int i = 0; i < 4; ++i) {
+                auto dot = _mm_add_epi32(_mm_madd_epi16(ab[i], row.kab),
+                                         _mm_madd_epi16(cz[i], row.kc));
+                sum[i] = _mm_sra_epi32(_mm_add_epi32(dot, row.offset), shift);
+            }
+
+            if constexpr (clamp) {
+                auto lo = _mm_packs_epi32(sum[0], sum[1]);
+                auto hi = _mm_packs_epi32(sum[2], sum[3]);
+                lo = _mm_min_epi16(_mm_max_epi16(lo, row.min), row.max);
+                hi = _mm_min_epi16(_mm_max_epi16(hi, row.min), row.max);
+
+                return _mm_packus_epi16(lo, hi);
+            } else {
+                auto mask = _mm_set1_epi32(0xff);
+                auto lo = _mm_packs_epi32(_mm_and_si128(sum[0], mask),
+                                          _mm_and_si128(sum[1], mask));
+                auto hi = _mm_packs_epi32(_mm_and_si128(sum[2], mask),
+                                          _mm_and_si128(sum[3], mask));
+
+                return _mm_packus_epi16(lo, hi);
+            }
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline void sse2Load(const uint8_t *a,
+                             const uint8_t *b,
+                             const uint8_t *c,
+                             __m128i *ab,
+                             __m128i *cz)
+        {
+            auto zero = _mm_setzero_si128();
+            auto a8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+            auto b8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+            auto c8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c));
+            auto alo = _mm_unpacklo_epi8(a8, zero);
+            auto ahi = _mm_unpackhi_epi8(a8, zero);
+            auto blo = _mm_unpacklo_epi8(b8, zero);
+            auto bhi = _mm_unpackhi_epi8(b8, zero);
+            auto clo = _mm_unpacklo_epi8(c8, zero);
+            auto chi = _mm_unpackhi_epi8(c8, zero);
+
+            ab[0] = _mm_unpacklo_epi16(alo, blo);
+            ab[1] = _mm_unpackhi_epi16(alo, blo);
+            ab[2] = _mm_unpacklo_epi16(ahi, bhi);
+            ab[3] = _mm_unpackhi_epi16(ahi, bhi);
+
+            cz[0] = _mm_unpacklo_epi16(clo, zero);
+            cz[1] = _mm_unpackhi_epi16(clo, zero);
+            cz[2] = _mm_unpacklo_epi16(chi, zero);
+            cz[3] = _mm_unpackhi_epi16(chi, zero);
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline int sse2Matrix3to3(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  uint8_t *y,
+                                  uint8_t *z,
+                                  int offset,
+                                  int width)
+        {
+            auto rowX = sse2Row(matrix, 0);
+            auto rowY = sse2Row(matrix, 1);
+            auto rowZ = sse2Row(matrix, 2);
+            auto shift = _mm_cvtsi32_si128(matrix.shift);
+            int i = offset;
+
+            for (; i + 16 <= width; i += 16) {
+                __m128i ab[4];
+                __m128i cz[4];
+                sse2Load(a + i, b + i, c + i, ab, cz);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(x + i),
+                                 sse2Convert<true>(ab, cz, rowX, shift));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(y + i),
+                                 sse2Convert<true>(ab, cz, rowY, shift));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(z + i),
+                                 sse2Convert<true>(ab, cz, rowZ, shift));
+            }
+
+            return i;
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline int sse2Matrix3to1(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  int offset,
+                                  int width)
+        {
+            auto rowX = sse2Row(matrix, 0);
+            auto shift = _mm_cvtsi32_si128(matrix.shift);
+            int i = offset;
+
+            for (; i + 16 <= width; i += 16) {
+                __m128i ab[4];
+                __m128i cz[4];
+                sse2Load(a + i, b + i, c + i, ab, cz);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(x + i),
+                                 sse2Convert<true>(ab, cz, rowX, shift));
+            }
+
+            return i;
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline int sse2Point1to3(const Simd::ColorMatrix &matrix,
+                                 const uint8_t *p,
+                                 uint8_t *x,
+                                 uint8_t *y,
+                                 uint8_t *z,
+                                 int offset,
+                                 int width)
+        {
+            auto point = pointMatrix(matrix);
+            auto rowX = sse2Row(point, 0);
+            auto rowY = sse2Row(point, 1);
+            auto rowZ = sse2Row(point, 2);
+            auto shift = _mm_cvtsi32_si128(matrix.shift);
+            auto zero = _mm_setzero_si128();
+            int i = offset;
+
+            for (; i + 16 <= width; i += 16) {
+                auto p8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+                auto plo = _mm_unpacklo_epi8(p8, zero);
+                auto phi = _mm_unpackhi_epi8(p8, zero);
+
+                __m128i pz[4] {
+                    _mm_unpacklo_epi16(plo, zero),
+                    _mm_unpackhi_epi16(plo, zero),
+                    _mm_unpacklo_epi16(phi, zero),
+                    _mm_unpackhi_epi16(phi, zero),
+                };
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(x + i),
+                                 sse2Convert<false>(pz, pz, rowX, shift));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(y + i),
+                                 sse2Convert<false>(pz, pz, rowY, shift));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(z + i),
+                                 sse2Convert<false>(pz, pz, rowZ, shift));
+            }
+
+            return i;
+        }
+
+        /* The alpha kernels multiply the 8 bits components in 16 bits lanes,
+         * and divide by 255 with:
+         *
+         * round(t / 255) = ((t + 128) + ((t + 128) >> 8)) >> 8
+         *
+         * which is exact for 0 <= t <= 255 * 255.
+         */
+
+        struct Sse2Alpha
+        {
+            __m128i background;
+            __m128i positive;
+            __m128i negative;
+            __m128i fill;
+            __m128i min;
+            __m128i max;
+        };
+
+        AKVCAM_TARGET_SSE2
+        inline Sse2Alpha sse2Alpha(const Simd::AlphaMatrix &matrix, int row)
+        {
+            auto background = matrix.background[row];
+
+            return {
+                _mm_set1_epi16(background),
+                _mm_set1_epi16(std::max<int16_t>(background, 0)),
+                _mm_set1_epi16(std::max<int16_t>(-background, 0)),
+                _mm_set1_epi8(char(std::clamp(background,
+                                              matrix.min[row],
+                                              matrix.max[row]))),
+                _mm_set1_epi8(char(matrix.min[row])),
+                _mm_set1_epi8(char(matrix.max[row]))
+            };
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline __m128i sse2Div255(__m128i t)
+        {
+            t = _mm_add_epi16(t, _mm_set1_epi16(128));
+
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        }
+
+        template<bool premultiplied>
+        AKVCAM_TARGET_SSE2
+        inline __m128i sse2Blend(__m128i p,
+                                 const __m128i *a,
+                                 const __m128i *ia,
+                                 const Sse2Alpha &row)
+        {
+            __m128i blended;
+
+            if constexpr (premultiplied) {
+                auto positive =
+                        _mm_packus_epi16(sse2Div255(_mm_mullo_epi16(ia[0], row.positive)),
+                                         sse2Div255(_mm_mullo_epi16(ia[1], row.positive)));
+                auto negative =
+                        _mm_packus_epi16(sse2Div255(_mm_mullo_epi16(ia[0], row.negative)),
+                                         sse2Div255(_mm_mullo_epi16(ia[1], row.negative)));
+                blended = _mm_subs_epu8(_mm_adds_epu8(p, positive), negative);
+            } else {
+                auto zero = _mm_setzero_si128();
+                auto lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), a[0]),
+                                        _mm_mullo_epi16(ia[0], row.background));
+                auto hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), a[1]),
+                                        _mm_mullo_epi16(ia[1], row.background));
+                blended = _mm_packus_epi16(sse2Div255(lo), sse2Div255(hi));
+            }
+
+            return _mm_min_epu8(_mm_max_epu8(blended, row.min), row.max);
+        }
+
+        template<bool premultiplied>
+        AKVCAM_TARGET_SSE2
+        inline int sse2AlphaBlend(const Simd::AlphaMatrix &matrix,
+                                  const uint8_t *a,
+                                  uint8_t *const *planes,
+                                  int components,
+                                  int offset,
+                                  int width)
+        {
+            Sse2Alpha rows[3];
+
+            for (int c = 0; c < components; ++c)
+                rows[c] = sse2Alpha(matrix, c);
+
+            auto zero = _mm_setzero_si128();
+            auto opaque = _mm_set1_epi8(char(0xff));
+            int i = offset;
+
+            for (; i + 16 <= width; i += 16) {
+                auto a8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(a8, opaque)) == 0xffff) {
+                    for (int c = 0; c < components; ++c) {
+                        auto p = reinterpret_cast<__m128i *>(planes[c] + i);
+                        auto &row = rows[c];
+                        _mm_storeu_si128(p,
+                                         _mm_min_epu8(_mm_max_epu8(_mm_loadu_si128(p),
+                                                                   row.min),
+                                                      row.max));
+                    }
+
+                    continue;
+                }
+
+                if constexpr (!premultiplied) {
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(a8, zero)) == 0xffff) {
+                        for (int c = 0; c < components; ++c)
+                            _mm_storeu_si128(reinterpret_cast<__m128i *>(planes[c] + i),
+                                             rows[c].fill);
+
+                        continue;
+                    }
+                }
+
+                auto ia8 = _mm_xor_si128(a8, opaque);
+                __m128i as[2] {
+                    _mm_unpacklo_epi8(a8, zero),
+                    _mm_unpackhi_epi8(a8, zero),
+                };
+                __m128i ias[2] {
+                    _mm_unpacklo_epi8(ia8, zero),
+                    _mm_unpackhi_epi8(ia8, zero),
+                };
+
+                for (int c = 0; c < components; ++c) {
+                    auto p = reinterpret_cast<__m128i *>(planes[c] + i);
+                    _mm_storeu_si128(p,
+                                     sse2Blend<premultiplied>(_mm_loadu_si128(p),
+                                                              as,
+                                                              ias,
+                                                              rows[c]));
+                }
+            }
+
+            return i;
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline __m128i sse2Gray(__m128i pixels)
+        {
+            auto mask = _mm_set1_epi32(0xff);
+            auto r = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+            auto g = _mm_and_si128(_mm_srli_epi32(pixels, 8), mask);
+            auto b = _mm_and_si128(pixels, mask);
+
+            // 11 * r + 16 * g + 5 * b
+            auto luma = _mm_add_epi32(_mm_slli_epi32(r, 3),
+                                      _mm_slli_epi32(r, 1));
+            luma = _mm_add_epi32(luma, r);
+            luma = _mm_add_epi32(luma, _mm_slli_epi32(g, 4));
+            luma = _mm_add_epi32(luma, _mm_slli_epi32(b, 2));
+            luma = _mm_add_epi32(luma, b);
+            luma = _mm_srli_epi32(luma, 5);
+
+            auto alpha = _mm_and_si128(pixels, _mm_set1_epi32(int(0xff000000)));
+            luma = _mm_or_si128(luma, _mm_slli_epi32(luma, 8));
+            luma = _mm_or_si128(luma, _mm_slli_epi32(luma, 8));
+
+            return _mm_or_si128(alpha, luma);
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline int sse2GrayScale(uint32_t *line, int offset, int width)
+        {
+            int x = offset;
+
+            for (; x + 4 <= width; x += 4) {
+                auto pixels = reinterpret_cast<__m128i *>(line + x);
+                _mm_storeu_si128(pixels, sse2Gray(_mm_loadu_si128(pixels)));
+            }
+
+            return x;
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline __m128i sse2SwapRgb(__m128i pixels)
+        {
+            auto mask = _mm_set1_epi32(0xff);
+            auto ag = _mm_and_si128(pixels, _mm_set1_epi32(int(0xff00ff00)));
+            auto r = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+            auto b = _mm_slli_epi32(_mm_and_si128(pixels, mask), 16);
+
+            return _mm_or_si128(ag, _mm_or_si128(r, b));
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline int sse2SwapRgb(uint32_t *line, int offset, int width)
+        {
+            int x = offset;
+
+            for (; x + 4 <= width; x += 4) {
+                auto pixels = reinterpret_cast<__m128i *>(line + x);
+                _mm_storeu_si128(pixels, sse2SwapRgb(_mm_loadu_si128(pixels)));
+            }
+
+            return x;
+        }
+
+        AKVCAM_TARGET_SSE2
+        inline void sse2Mirror(uint32_t *line, int *left, int *right)
+        {
+            for (; *right - *left >= 8; *left += 4, *right -= 4) {
+                auto leftPixels = reinterpret_cast<__m128i *>(line + *left);
+                auto rightPixels = reinterpret_cast<__m128i *>(line + *right - 4);
+                auto l = _mm_loadu_si128(leftPixels);
+                auto r = _mm_loadu_si128(rightPixels);
+                _mm_storeu_si128(leftPixels,
+                                 _mm_shuffle_epi32(r, _MM_SHUFFLE(0, 1, 2, 3)));
+                _mm_storeu_si128(rightPixels,
+                                 _mm_shuffle_epi32(l, _MM_SHUFFLE(0, 1, 2, 3)));
+            }
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2Matrix3to3Kernel(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  uint8_t *y,
+                                  uint8_t *z,
+                                  int width)
+        {
+            int i = sse2Matrix3to3(matrix, a, b, c, x, y, z, 0, width);
+            scalarMatrix3to3(matrix, a, b, c, x, y, z, i, width);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2Matrix3to1Kernel(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  int width)
+        {
+            int i = sse2Matrix3to1(matrix, a, b, c, x, 0, width);
+            scalarMatrix3to1(matrix, a, b, c, x, i, width);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2Point1to3Kernel(const Simd::ColorMatrix &matrix,
+                                 const uint8_t *p,
+                                 uint8_t *x,
+                                 uint8_t *y,
+                                 uint8_t *z,
+                                 int width)
+        {
+            int i = sse2Point1to3(matrix, p, x, y, z, 0, width);
+            scalarPoint1to3(matrix, p, x, y, z, i, width);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2AlphaBlendKernel(const Simd::AlphaMatrix &matrix,
+                                  const uint8_t *a,
+                                  uint8_t *const *planes,
+                                  int components,
+                                  int width)
+        {
+            int i = matrix.premultiplied?
+                        sse2AlphaBlend<true>(matrix, a, planes, components, 0, width):
+                        sse2AlphaBlend<false>(matrix, a, planes, components, 0, width);
+            scalarAlphaBlend(matrix, a, planes, components, i, width);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2GrayScaleKernel(uint32_t *line, int width)
+        {
+            int x = sse2GrayScale(line, 0, width);
+            scalarGrayScale(line, x, width);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2SwapRgbKernel(uint32_t *line, int width)
+        {
+            int x = sse2SwapRgb(line, 0, width);
+            scalarSwapRgb(line, x, width);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2MirrorKernel(uint32_t *line, int width)
+        {
+            int left = 0;
+            int right = width;
+            sse2Mirror(line, &left, &right);
+            scalarMirror(line, left, right);
+        }
+
+        AKVCAM_TARGET_SSE2
+        void sse2FillKernel(uint8_t *data, size_t size, size_t pixelSize)
+        {
+            auto period = fillPeriod(pixelSize, 16);
+
+            if (period < 1 || size < 2 * period) {
+                scalarFill(data, size, pixelSize);
+
+                return;
+            }
+
+            scalarFill(data, period, pixelSize);
+            auto nRegisters = period / 16;
+            __m128i pattern[4];
+
+            for (size_t i = 0; i < nRegisters; ++i)
+                pattern[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i));
+
+            size_t offset = period;
+
+            for (; offset + period <= size; offset += period)
+                for (size_t i = 0; i < nRegisters; ++i)
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(data + offset + 16 * i),
+                                     pattern[i]);
+
+            memcpy(data + offset, data, size - offset);
+        }
+
+        /* AVX2 kernels, 32 pixels by iteration.
+         *
+         * Same as the SSE2 kernels, but since the pack instructions works by
+         * 128 bits lane, the final bytes must be reordered with a 64 bits
+         * permutation.
+         */
+
+        struct Avx2Row
+        {
+            __m256i kab;
+            __m256i kc;
+            __m256i offset;
+            __m256i min;
+            __m256i max;
+        };
+
+        AKVCAM_TARGET_AVX2
+        inline Avx2Row avx2Row(const Simd::ColorMatrix &matrix, int row)
+        {
+            return {
+                _mm256_set1_epi32(pair16(matrix.m[row][0], matrix.m[row][1])),
+                _mm256_set1_epi32(pair16(matrix.m[row][2], 0)),
+                _mm256_set1_epi32(matrix.offset[row]),
+                _mm256_set1_epi16(matrix.min[row]),
+                _mm256_set1_epi16(matrix.max[row])
+            };
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline __m256i avx2Load(const uint8_t *data)
+        {
+            auto data8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+
+            return _mm256_cvtepu8_epi16(data8);
+        }
+
+        template<bool clamp>
+        AKVCAM_TARGET_AVX2
+        inline __m256i avx2Convert16(__m256i a,
+                                     __m256i b,
+                                     __m256i c,
+                                     const Avx2Row &row,
+                                     __m128i shift)
+        {
+            auto zero = _mm256_setzero_si256();
+            auto ablo = _mm256_unpacklo_epi16(a, b);
+            auto abhi = _mm256_unpackhi_epi16(a, b);
+            auto czlo = _mm256_unpacklo_epi16(c, zero);
+            auto czhi = _mm256_unpackhi_epi16(c, zero);
+            auto lo = _mm256_add_epi32(_mm256_madd_epi16(ablo, row.kab),
+                                       _mm256_madd_epi16(czlo, row.kc));
+            auto hi = _mm256_add_epi32(_mm256_madd_epi16(abhi, row.kab),
+                                       _mm256_madd_epi16(czhi, row.kc));
+            lo = _mm256_sra_epi32(_mm256_add_epi32(lo, row.offset), shift);
+            hi = _mm256_sra_epi32(_mm256_add_epi32(hi, row.offset), shift);
+
+            if constexpr (!clamp) {
+                auto mask = _mm256_set1_epi32(0xff);
+                lo = _mm256_and_si256(lo, mask);
+                hi = _mm256_and_si256(hi, mask);
+            }
+
+            // The unpack and the pack are both done by lane, so the 16 bits
+            // values are left in the original order.
+
+            auto sum = _mm256_packs_epi32(lo, hi);
+
+            if constexpr (clamp)
+                sum = _mm256_min_epi16(_mm256_max_epi16(sum, row.min), row.max);
+
+            return sum;
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline __m256i avx2Pack(__m256i lo, __m256i hi)
+        {
+            auto packed = _mm256_packus_epi16(lo, hi);
+
+            return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline void avx2Store(uint8_t *data, __m256i lo, __m256i hi)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data),
+                                avx2Pack(lo, hi));
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline int avx2Matrix3to3(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  uint8_t *y,
+                                  uint8_t *z,
+                                  int offset,
+                                  int width)
+        {
+            auto rowX = avx2Row(matrix, 0);
+            auto rowY = avx2Row(matrix, 1);
+            auto rowZ = avx2Row(matrix, 2);
+            auto shift = _mm_cvtsi32_si128(matrix.shift);
+            int i = offset;
+
+            for (; i + 32 <= width; i += 32) {
+                auto alo = avx2Load(a + i);
+                auto ahi = avx2Load(a + i + 16);
+                auto blo = avx2Load(b + i);
+                auto bhi = avx2Load(b + i + 16);
+                auto clo = avx2Load(c + i);
+                auto chi = avx2Load(c + i + 16);
+
+                avx2Store(x + i,
+                          avx2Convert16<true>(alo, blo, clo, rowX, shift),
+                          avx2Convert16<true>(ahi, bhi, chi, rowX, shift));
+                avx2Store(y + i,
+                          avx2Convert16<true>(alo, blo, clo, rowY, shift),
+                          avx2Convert16<true>(ahi, bhi, chi, rowY, shift));
+                avx2Store(z + i,
+                          avx2Convert16<true>(alo, blo, clo, rowZ, shift),
+                          avx2Convert16<true>(ahi, bhi, chi, rowZ, shift));
+            }
+
+            return i;
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline int avx2Matrix3to1(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  int offset,
+                                  int width)
+        {
+            auto rowX = avx2Row(matrix, 0);
+            auto shift = _mm_cvtsi32_si128(matrix.shift);
+            int i = offset;
+
+            for (; i + 32 <= width; i += 32) {
+                auto alo = avx2Load(a + i);
+                auto ahi = avx2Load(a + i + 16);
+                auto blo = avx2Load(b + i);
+                auto bhi = avx2Load(b + i + 16);
+                auto clo = avx2Load(c + i);
+                auto chi = avx2Load(c + i + 16);
+
+                avx2Store(x + i,
+                          avx2Convert16<true>(alo, blo, clo, rowX, shift),
+                          avx2Convert16<true>(ahi, bhi, chi, rowX, shift));
+            }
+
+            return i;
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline int avx2Point1to3(const Simd::ColorMatrix &matrix,
+                                 const uint8_t *p,
+                                 uint8_t *x,
+                                 uint8_t *y,
+                                 uint8_t *z,
+                                 int offset,
+                                 int width)
+        {
+            auto point = pointMatrix(matrix);
+            auto rowX = avx2Row(point, 0);
+            auto rowY = avx2Row(point, 1);
+            auto rowZ = avx2Row(point, 2);
+            auto shift = _mm_cvtsi32_si128(matrix.shift);
+            auto zero = _mm256_setzero_si256();
+            int i = offset;
+
+            for (; i + 32 <= width; i += 32) {
+                auto plo = avx2Load(p + i);
+                auto phi = avx2Load(p + i + 16);
+
+                avx2Store(x + i,
+                          avx2Convert16<false>(plo, zero, zero, rowX, shift),
+                          avx2Convert16<false>(phi, zero, zero, rowX, shift));
+                avx2Store(y + i,
+                          avx2Convert16<false>(plo, zero, zero, rowY, shift),
+                          avx2Convert16<false>(phi, zero, zero, rowY, shift));
+                avx2Store(z + i,
+                          avx2Convert16<false>(plo, zero, zero, rowZ, shift),
+                          avx2Convert16<false>(phi, zero, zero, rowZ, shift));
+            }
+
+            return i;
+        }
+
+        struct Avx2Alpha
+        {
+            __m256i background;
+            __m256i positive;
+            __m256i negative;
+            __m256i fill;
+            __m256i min;
+            __m256i max;
+        };
+
+        AKVCAM_TARGET_AVX2
+        inline Avx2Alpha avx2Alpha(const Simd::AlphaMatrix &matrix, int row)
+        {
+            auto background = matrix.background[row];
+
+            return {
+                _mm256_set1_epi16(background),
+                _mm256_set1_epi16(std::max<int16_t>(background, 0)),
+                _mm256_set1_epi16(std::max<int16_t>(-background, 0)),
+                _mm256_set1_epi8(char(std::clamp(background,
+                                                 matrix.min[row],
+                                                 matrix.max[row]))),
+                _mm256_set1_epi8(char(matrix.min[row])),
+                _mm256_set1_epi8(char(matrix.max[row]))
+            };
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline __m256i avx2Div255(__m256i t)
+        {
+            t = _mm256_add_epi16(t, _mm256_set1_epi16(128));
+
+            return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+        }
+
+        template<bool premultiplied>
+        AKVCAM_TARGET_AVX2
+        inline __m256i avx2Blend(const uint8_t *data,
+                                 const __m256i *a,
+                                 const __m256i *ia,
+                                 const Avx2Alpha &row)
+        {
+            __m256i blended;
+
+            if constexpr (premultiplied) {
+                auto positive =
+                        avx2Pack(avx2Div255(_mm256_mullo_epi16(ia[0], row.positive)),
+                                 avx2Div255(_mm256_mullo_epi16(ia[1], row.positive)));
+                auto negative =
+                        avx2Pack(avx2Div255(_mm256_mullo_epi16(ia[0], row.negative)),
+                                 avx2Div255(_mm256_mullo_epi16(ia[1], row.negative)));
+                auto p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+                blended = _mm256_subs_epu8(_mm256_adds_epu8(p, positive),
+                                           negative);
+            } else {
+                auto lo = _mm256_add_epi16(_mm256_mullo_epi16(avx2Load(data), a[0]),
+                                           _mm256_mullo_epi16(ia[0], row.background));
+                auto hi = _mm256_add_epi16(_mm256_mullo_epi16(avx2Load(data + 16), a[1]),
+                                           _mm256_mullo_epi16(ia[1], row.background));
+                blended = avx2Pack(avx2Div255(lo), avx2Div255(hi));
+            }
+
+            return _mm256_min_epu8(_mm256_max_epu8(blended, row.min), row.max);
+        }
+
+        template<bool premultiplied>
+        AKVCAM_TARGET_AVX2
+        inline int avx2AlphaBlend(const Simd::AlphaMatrix &matrix,
+                                  const uint8_t *a,
+                                  uint8_t *const *planes,
+                                  int components,
+                                  int offset,
+                                  int width)
+        {
+            Avx2Alpha rows[3];
+
+            for (int c = 0; c < components; ++c)
+                rows[c] = avx2Alpha(matrix, c);
+
+            auto zero = _mm256_setzero_si256();
+            auto opaque = _mm256_set1_epi8(char(0xff));
+            int i = offset;
+
+            for (; i + 32 <= width; i += 32) {
+                auto a8 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a8, opaque)) == -1) {
+                    for (int c = 0; c < components; ++c) {
+                        auto p = reinterpret_cast<__m256i *>(planes[c] + i);
+                        auto &row = rows[c];
+                        _mm256_storeu_si256(p,
+                                            _mm256_min_epu8(_mm256_max_epu8(_mm256_loadu_si256(p),
+                                                                            row.min),
+                                                            row.max));
+                    }
+
+                    continue;
+                }
+
+                if constexpr (!premultiplied) {
+                    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a8, zero)) == -1) {
+                        for (int c = 0; c < components; ++c)
+                            _mm256_storeu_si256(reinterpret_cast<__m256i *>(planes[c] + i),
+                                                rows[c].fill);
+
+                        continue;
+                    }
+                }
+
+                __m256i as[2] {
+                    avx2Load(a + i),
+                    avx2Load(a + i + 16),
+                };
+                auto max = _mm256_set1_epi16(255);
+                __m256i ias[2] {
+                    _mm256_sub_epi16(max, as[0]),
+                    _mm256_sub_epi16(max, as[1]),
+                };
+
+                for (int c = 0; c < components; ++c) {
+                    auto blended = avx2Blend<premultiplied>(planes[c] + i,
+                                                            as,
+                                                            ias,
+                                                            rows[c]);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(planes[c] + i),
+                                        blended);
+                }
+            }
+
+            return i;
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline int avx2GrayScale(uint32_t *line, int offset, int width)
+        {
+            auto mask = _mm256_set1_epi32(0xff);
+            auto alphaMask = _mm256_set1_epi32(int(0xff000000));
+            int x = offset;
+
+            for (; x + 8 <= width; x += 8) {
+                auto pixels = reinterpret_cast<__m256i *>(line + x);
+                auto p = _mm256_loadu_si256(pixels);
+                auto r = _mm256_and_si256(_mm256_srli_epi32(p, 16), mask);
+                auto g = _mm256_and_si256(_mm256_srli_epi32(p, 8), mask);
+                auto b = _mm256_and_si256(p, mask);
+
+                auto luma = _mm256_mullo_epi32(r, _mm256_set1_epi32(11));
+                luma = _mm256_add_epi32(luma, _mm256_slli_epi32(g, 4));
+                luma = _mm256_add_epi32(luma, _mm256_mullo_epi32(b, _mm256_set1_epi32(5)));
+                luma = _mm256_srli_epi32(luma, 5);
+                luma = _mm256_or_si256(luma, _mm256_slli_epi32(luma, 8));
+                luma = _mm256_or_si256(luma, _mm256_slli_epi32(luma, 8));
+
+                _mm256_storeu_si256(pixels,
+                                    _mm256_or_si256(_mm256_and_si256(p, alphaMask),
+                                                    luma));
+            }
+
+            return x;
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline int avx2SwapRgb(uint32_t *line, int offset, int width)
+        {
+            // Swap the bytes 0 and 2 of each pixel.
+            auto shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7,
+                                            10, 9, 8, 11, 14, 13, 12, 15,
+                                            2, 1, 0, 3, 6, 5, 4, 7,
+                                            10, 9, 8, 11, 14, 13, 12, 15);
+            int x = offset;
+
+            for (; x + 8 <= width; x += 8) {
+                auto pixels = reinterpret_cast<__m256i *>(line + x);
+                _mm256_storeu_si256(pixels,
+                                    _mm256_shuffle_epi8(_mm256_loadu_si256(pixels),
+                                                        shuffle));
+            }
+
+            return x;
+        }
+
+        AKVCAM_TARGET_AVX2
+        inline void avx2Mirror(uint32_t *line, int *left, int *right)
+        {
+            auto reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+            for (; *right - *left >= 16; *left += 8, *right -= 8) {
+                auto leftPixels = reinterpret_cast<__m256i *>(line + *left);
+                auto rightPixels = reinterpret_cast<__m256i *>(line + *right - 8);
+                auto l = _mm256_loadu_si256(leftPixels);
+                auto r = _mm256_loadu_si256(rightPixels);
+                _mm256_storeu_si256(leftPixels,
+                                    _mm256_permutevar8x32_epi32(r, reverse));
+                _mm256_storeu_si256(rightPixels,
+                                    _mm256_permutevar8x32_epi32(l, reverse));
+            }
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2Matrix3to3Kernel(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  uint8_t *y,
+                                  uint8_t *z,
+                                  int width)
+        {
+            int i = avx2Matrix3to3(matrix, a, b, c, x, y, z, 0, width);
+            i = sse2Matrix3to3(matrix, a, b, c, x, y, z, i, width);
+            scalarMatrix3to3(matrix, a, b, c, x, y, z, i, width);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2Matrix3to1Kernel(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  int width)
+        {
+            int i = avx2Matrix3to1(matrix, a, b, c, x, 0, width);
+            i = sse2Matrix3to1(matrix, a, b, c, x, i, width);
+            scalarMatrix3to1(matrix, a, b, c, x, i, width);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2Point1to3Kernel(const Simd::ColorMatrix &matrix,
+                                 const uint8_t *p,
+                                 uint8_t *x,
+                                 uint8_t *y,
+                                 uint8_t *z,
+                                 int width)
+        {
+            int i = avx2Point1to3(matrix, p, x, y, z, 0, width);
+            i = sse2Point1to3(matrix, p, x, y, z, i, width);
+            scalarPoint1to3(matrix, p, x, y, z, i, width);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2AlphaBlendKernel(const Simd::AlphaMatrix &matrix,
+                                  const uint8_t *a,
+                                  uint8_t *const *planes,
+                                  int components,
+                                  int width)
+        {
+            int i = 0;
+
+            if (matrix.premultiplied) {
+                i = avx2AlphaBlend<true>(matrix, a, planes, components, 0, width);
+                i = sse2AlphaBlend<true>(matrix, a, planes, components, i, width);
+            } else {
+                i = avx2AlphaBlend<false>(matrix, a, planes, components, 0, width);
+                i = sse2AlphaBlend<false>(matrix, a, planes, components, i, width);
+            }
+
+            scalarAlphaBlend(matrix, a, planes, components, i, width);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2GrayScaleKernel(uint32_t *line, int width)
+        {
+            int x = avx2GrayScale(line, 0, width);
+            x = sse2GrayScale(line, x, width);
+            scalarGrayScale(line, x, width);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2SwapRgbKernel(uint32_t *line, int width)
+        {
+            int x = avx2SwapRgb(line, 0, width);
+            x = sse2SwapRgb(line, x, width);
+            scalarSwapRgb(line, x, width);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2MirrorKernel(uint32_t *line, int width)
+        {
+            int left = 0;
+            int right = width;
+            avx2Mirror(line, &left, &right);
+            sse2Mirror(line, &left, &right);
+            scalarMirror(line, left, right);
+        }
+
+        AKVCAM_TARGET_AVX2
+        void avx2FillKernel(uint8_t *data, size_t size, size_t pixelSize)
+        {
+            auto period = fillPeriod(pixelSize, 32);
+
+            if (period < 1 || size < 2 * period) {
+                sse2FillKernel(data, size, pixelSize);
+
+                return;
+            }
+
+            scalarFill(data, period, pixelSize);
+            auto nRegisters = period / 32;
+            __m256i pattern[4];
+
+            for (size_t i = 0; i < nRegisters; ++i)
+                pattern[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 32 * i));
+
+            size_t offset = period;
+
+            for (; offset + period <= size; offset += period)
+                for (size_t i = 0; i < nRegisters; ++i)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + offset + 32 * i),
+                                        pattern[i]);
+
+            memcpy(data + offset, data, size - offset);
+        }
+
+        Simd::Instruction x86Instruction()
+        {
+            uint32_t regs[4] {0, 0, 0, 0};
+            uint32_t maxLeaf = 0;
+
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            maxLeaf = uint32_t(info[0]);
+            __cpuid(info, 1);
+
+            for (int i = 0; i < 4; ++i)
+                regs[i] = uint32_t(info[i]);
+#else
+            maxLeaf = __get_cpuid_max(0, nullptr);
+            __get_cpuid(1, regs, regs + 1, regs + 2, regs + 3);
+#endif
+
+            static const uint32_t sse2Bit = 1 << 26;
+            static const uint32_t osxsaveBit = 1 << 27;
+            static const uint32_t avxBit = 1 << 28;
+            static const uint32_t avx2Bit = 1 << 5;
+
+            if (!(regs[3] & sse2Bit))
+                return Simd::Instruction_None;
+
+            if (maxLeaf < 7
+                || !(regs[2] & osxsaveBit)
+                || !(regs[2] & avxBit))
+                return Simd::Instruction_SSE2;
+
+            // Check that the OS saves the YMM registers.
+
+#ifdef _MSC_VER
+            auto xcr0 = uint64_t(_xgetbv(0));
+#else
+            uint32_t xcr0Low = 0;
+            uint32_t xcr0High = 0;
+            __asm__ volatile ("xgetbv"
+                              : "=a" (xcr0Low), "=d" (xcr0High)
+                              : "c" (0));
+            auto xcr0 = uint64_t(xcr0Low) | (uint64_t(xcr0High) << 32);
+#endif
+
+            if ((xcr0 & 0x6) != 0x6)
+                return Simd::Instruction_SSE2;
+
+#ifdef _MSC_VER
+            __cpuidex(info, 7, 0);
+
+            for (int i = 0; i < 4; ++i)
+                regs[i] = uint32_t(info[i]);
+#else
+            __get_cpuid_count(7, 0, regs, regs + 1, regs + 2, regs + 3);
+#endif
+
+            return regs[1] & avx2Bit?
+                        Simd::Instruction_AVX2:
+                        Simd::Instruction_SSE2;
+        }
+#endif
+
+#ifdef AKVCAM_SIMD_NEON
+        /* NEON kernels, 16 pixels by iteration.
+         *
+         * The products are accumulated with widening multiply-add, and the
+         * arithmetic right shift is done as a left shift by a negative amount.
+         */
+
+        struct NeonRow
+        {
+            int16_t m0;
+            int16_t m1;
+            int16_t m2;
+            int32x4_t offset;
+            int32x4_t shift;
+            int16x8_t min;
+            int16x8_t max;
+        };
+
+        inline NeonRow neonRow(const Simd::ColorMatrix &matrix, int row)
+        {
+            return {
+                matrix.m[row][0],
+                matrix.m[row][1],
+                matrix.m[row][2],
+                vdupq_n_s32(matrix.offset[row]),
+                vdupq_n_s32(-matrix.shift),
+                vdupq_n_s16(matrix.min[row]),
+                vdupq_n_s16(matrix.max[row])
+            };
+        }
+
+        inline int16x8_t neonWiden(uint8x8_t data)
+        {
+            return vreinterpretq_s16_u16(vmovl_u8(data));
+        }
+
+        template<bool clamp>
+        inline uint8x8_t neonConvert8(int16x8_t a,
+                                      int16x8_t b,
+                                      int16x8_t c,
+                                      const NeonRow &row)
+        {
+            auto lo = vmlal_n_s16(row.offset, vget_low_s16(a), row.m0);
+            lo = vmlal_n_s16(lo, vget_low_s16(b), row.m1);
+            lo = vmlal_n_s16(lo, vget_low_s16(c), row.m2);
+            lo = vshlq_s32(lo, row.shift);
+
+            auto hi = vmlal_n_s16(row.offset, vget_high_s16(a), row.m0);
+            hi = vmlal_n_s16(hi, vget_high_s16(b), row.m1);
+            hi = vmlal_n_s16(hi, vget_high_s16(c), row.m2);
+            hi = vshlq_s32(hi, row.shift);
+
+            if constexpr (clamp) {
+                auto sum = vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+                sum = vminq_s16(vmaxq_s16(sum, row.min), row.max);
+
+                return vqmovun_s16(sum);
+            } else {
+                auto mask = vdupq_n_s32(0xff);
+                auto sum = vcombine_s16(vmovn_s32(vandq_s32(lo, mask)),
+                                        vmovn_s32(vandq_s32(hi, mask)));
+
+                return vqmovun_s16(sum);
+            }
+        }
+
+        template<bool clamp>
+        inline uint8x16_t neonConvert16(uint8x16_t a,
+                                        uint8x16_t b,
+                                        uint8x16_t c,
+                                        const NeonRow &row)
+        {
+            auto lo = neonConvert8<clamp>(neonWiden(vget_low_u8(a)),
+                                          neonWiden(vget_low_u8(b)),
+                                          neonWiden(vget_low_u8(c)),
+                                          row);
+            auto hi = neonConvert8<clamp>(neonWiden(vget_high_u8(a)),
+                                          neonWiden(vget_high_u8(b)),
+                                          neonWiden(vget_high_u8(c)),
+                                          row);
+
+            return vcombine_u8(lo, hi);
+        }
+
+        void neonMatrix3to3Kernel(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  uint8_t *y,
+                                  uint8_t *z,
+                                  int width)
+        {
+            auto rowX = neonRow(matrix, 0);
+            auto rowY = neonRow(matrix, 1);
+            auto rowZ = neonRow(matrix, 2);
+            int i = 0;
+
+            for (; i + 16 <= width; i += 16) {
+                auto a8 = vld1q_u8(a + i);
+                auto b8 = vld1q_u8(b + i);
+                auto c8 = vld1q_u8(c + i);
+
+                vst1q_u8(x + i, neonConvert16<true>(a8, b8, c8, rowX));
+                vst1q_u8(y + i, neonConvert16<true>(a8, b8, c8, rowY));
+                vst1q_u8(z + i, neonConvert16<true>(a8, b8, c8, rowZ));
+            }
+
+            scalarMatrix3to3(matrix, a, b, c, x, y, z, i, width);
+        }
+
+        void neonMatrix3to1Kernel(const Simd::ColorMatrix &matrix,
+                                  const uint8_t *a,
+                                  const uint8_t *b,
+                                  const uint8_t *c,
+                                  uint8_t *x,
+                                  int width)
+        {
+            auto rowX = neonRow(matrix, 0);
+            int i = 0;
+
+            for (; i + 16 <= width; i += 16) {
+                auto a8 = vld1q_u8(a + i);
+                auto b8 = vld1q_u8(b + i);
+                auto c8 = vld1q_u8(c + i);
+
+                vst1q_u8(x + i, neonConvert16<true>(a8, b8, c8, rowX));
+            }
+
+            scalarMatrix3to1(matrix, a, b, c, x, i, width);
+        }
+
+        void neonPoint1to3Kernel(const Simd::ColorMatrix &matrix,
+                                 const uint8_t *p,
+                                 uint8_t *x,
+                                 uint8_t *y,
+                                 uint8_t *z,
+                                 int width)
+        {
+            auto point = pointMatrix(matrix);
+            auto rowX = neonRow(point, 0);
+            auto rowY = neonRow(point, 1);
+            auto rowZ = neonRow(point, 2);
+            auto zero = vdupq_n_u8(0);
+            int i = 0;
+
+            for (; i + 16 <= width; i += 16) {
+                auto p8 = vld1q_u8(p + i);
+
+                vst1q_u8(x + i, neonConvert16<false>(p8, zero, zero, rowX));
+                vst1q_u8(y + i, neonConvert16<false>(p8, zero, zero, rowY));
+                vst1q_u8(z + i, neonConvert16<false>(p8, zero, zero, rowZ));
+            }
+
+            scalarPoint1to3(matrix, p, x, y, z, i, width);
+        }
+
+        struct NeonAlpha
+        {
+            uint8x8_t background;
+            uint8x8_t positive;
+            uint8x8_t negative;
+            uint8x16_t fill;
+            uint8x16_t min;
+            uint8x16_t max;
+        };
+
+        inline NeonAlpha neonAlpha(const Simd::AlphaMatrix &matrix, int row)
+        {
+            auto background = matrix.background[row];
+
+            return {
+                vdup_n_u8(uint8_t(std::clamp<int16_t>(background, 0, 255))),
+                vdup_n_u8(uint8_t(std::max<int16_t>(background, 0))),
+                vdup_n_u8(uint8_t(std::max<int16_t>(-background, 0))),
+                vdupq_n_u8(uint8_t(std::clamp(background,
+                                              matrix.min[row],
+                                              matrix.max[row]))),
+                vdupq_n_u8(uint8_t(matrix.min[row])),
+                vdupq_n_u8(uint8_t(matrix.max[row]))
+            };
+        }
+
+        // Same division by 255 of the x86 kernels, with rounding narrows.
+        inline uint8x8_t neonDiv255(uint16x8_t t)
+        {
+            return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+        }
+
+        inline uint8_t neonMin(uint8x16_t data)
+        {
+            auto min = vpmin_u8(vget_low_u8(data), vget_high_u8(data));
+            min = vpmin_u8(min, min);
+            min = vpmin_u8(min, min);
+            min = vpmin_u8(min, min);
+
+            return vget_lane_u8(min, 0);
+        }
+
+        inline uint8_t neonMax(uint8x16_t data)
+        {
+            auto max = vpmax_u8(vget_low_u8(data), vget_high_u8(data));
+            max = vpmax_u8(max, max);
+            max = vpmax_u8(max, max);
+            max = vpmax_u8(max, max);
+
+            return vget_lane_u8(max, 0);
+        }
+
+        template<bool premultiplied>
+        inline uint8x16_t neonBlend(uint8x16_t p,
+                                    uint8x16_t a,
+                                    uint8x16_t ia,
+                                    const NeonAlpha &row)
+        {
+            uint8x16_t blended;
+
+            if constexpr (premultiplied) {
+                auto positive =
+                        vcombine_u8(neonDiv255(vmull_u8(vget_low_u8(ia), row.positive)),
+                                    neonDiv255(vmull_u8(vget_high_u8(ia), row.positive)));
+                auto negative =
+                        vcombine_u8(neonDiv255(vmull_u8(vget_low_u8(ia), row.negative)),
+                                    neonDiv255(vmull_u8(vget_high_u8(ia), row.negative)));
+                blended = vqsubq_u8(vqaddq_u8(p, positive), negative);
+            } else {
+                auto lo = vmlal_u8(vmull_u8(vget_low_u8(p), vget_low_u8(a)),
+                                   vget_low_u8(ia),
+                                   row.background);
+                auto hi = vmlal_u8(vmull_u8(vget_high_u8(p), vget_high_u8(a)),
+                                   vget_high_u8(ia),
+                                   row.background);
+                blended = vcombine_u8(neonDiv255(lo), neonDiv255(hi));
+            }
+
+            return vminq_u8(vmaxq_u8(blended, row.min), row.max);
+        }
+
+        template<bool premultiplied>
+        inline int neonAlphaBlend(const Simd::AlphaMatrix &matrix,
+                                  const uint8_t *a,
+                                  uint8_t *const *planes,
+                                  int components,
+                                  int width)
+        {
+            NeonAlpha rows[3];
+
+            for (int c = 0; c < components; ++c)
+                rows[c] = neonAlpha(matrix, c);
+
+            auto opaque = vdupq_n_u8(0xff);
+            int i = 0;
+
+            for (; i + 16 <= width; i += 16) {
+                auto a8 = vld1q_u8(a + i);
+
+                if (neonMin(a8) == 0xff) {
+                    for (int c = 0; c < components; ++c) {
+                        auto &row = rows[c];
+                        auto p = vld1q_u8(planes[c] + i);
+                        vst1q_u8(planes[c] + i,
+                                 vminq_u8(vmaxq_u8(p, row.min), row.max));
+                    }
+
+                    continue;
+                }
+
+                if constexpr (!premultiplied) {
+                    if (neonMax(a8) == 0) {
+                        for (int c = 0; c < components; ++c)
+                            vst1q_u8(planes[c] + i, rows[c].fill);
+
+                        continue;
+                    }
+                }
+
+                auto ia8 = vsubq_u8(opaque, a8);
+
+                for (int c = 0; c < components; ++c)
+                    vst1q_u8(planes[c] + i,
+                             neonBlend<premultiplied>(vld1q_u8(planes[c] + i),
+                                                      a8,
+                                                      ia8,
+                                                      rows[c]));
+            }
+
+            return i;
+        }
+
+        void neonAlphaBlendKernel(const Simd::AlphaMatrix &matrix,
+                                  const uint8_t *a,
+                                  uint8_t *const *planes,
+                                  int components,
+                                  int width)
+        {
+            int i = matrix.premultiplied?
+                        neonAlphaBlend<true>(matrix, a, planes, components, width):
+                        neonAlphaBlend<false>(matrix, a, planes, components, width);
+            scalarAlphaBlend(matrix, a, planes, components, i, width);
+        }
+
+        /* The ARGB kernels deinterleaves 16 pixels in B, G, R, A planes
+         * (little endian byte order).
+         */
+
+        void neonGrayScaleKernel(uint32_t *line, int width)
+        {
+            auto kr = vdup_n_u8(11);
+            auto kg = vdup_n_u8(16);
+            auto kb = vdup_n_u8(5);
+            int x = 0;
+
+            for (; x + 16 <= width; x += 16) {
+                auto data = reinterpret_cast<uint8_t *>(line + x);
+                auto pixels = vld4q_u8(data);
+                auto &b = pixels.val[0];
+                auto &g = pixels.val[1];
+                auto &r = pixels.val[2];
+
+                auto lo = vmull_u8(vget_low_u8(r), kr);
+                lo = vmlal_u8(lo, vget_low_u8(g), kg);
+                lo = vmlal_u8(lo, vget_low_u8(b), kb);
+                auto hi = vmull_u8(vget_high_u8(r), kr);
+                hi = vmlal_u8(hi, vget_high_u8(g), kg);
+                hi = vmlal_u8(hi, vget_high_u8(b), kb);
+
+                auto luma = vcombine_u8(vshrn_n_u16(lo, 5), vshrn_n_u16(hi, 5));
+                pixels.val[0] = luma;
+                pixels.val[1] = luma;
+                pixels.val[2] = luma;
+                vst4q_u8(data, pixels);
+            }
+
+            scalarGrayScale(line, x, width);
+        }
+
+        void neonSwapRgbKernel(uint32_t *line, int width)
+        {
+            int x = 0;
+
+            for (; x + 16 <= width; x += 16) {
+                auto data = reinterpret_cast<uint8_t *>(line + x);
+                auto pixels = vld4q_u8(data);
+                auto b = pixels.val[0];
+                pixels.val[0] = pixels.val[2];
+                pixels.val[2] = b;
+                vst4q_u8(data, pixels);
+            }
+
+            scalarSwapRgb(line, x, width);
+        }
+
+        inline uint32x4_t neonReverse(uint32x4_t pixels)
+        {
+            auto swapped = vrev64q_u32(pixels);
+
+            return vcombine_u32(vget_high_u32(swapped), vget_low_u32(swapped));
+        }
+
+        void neonMirrorKernel(uint32_t *line, int width)
+        {
+            int left = 0;
+            int right = width;
+
+            for (; right - left >= 8; left += 4, right -= 4) {
+                auto l = vld1q_u32(line + left);
+                auto r = vld1q_u32(line + right - 4);
+                vst1q_u32(line + left, neonReverse(r));
+                vst1q_u32(line + right - 4, neonReverse(l));
+            }
+
+            scalarMirror(line, left, right);
+        }
+
+        void neonFillKernel(uint8_t *data, size_t size, size_t pixelSize)
+        {
+            auto period = fillPeriod(pixelSize, 16);
+
+            if (period < 1 || size < 2 * period) {
+                scalarFill(data, size, pixelSize);
+
+                return;
+            }
+
+            scalarFill(data, period, pixelSize);
+            auto nRegisters = period / 16;
+            uint8x16_t pattern[4];
+
+            for (size_t i = 0; i < nRegisters; ++i)
+                pattern[i] = vld1q_u8(data + 16 * i);
+
+            size_t offset = period;
+
+            for (; offset + period <= size; offset += period)
+                for (size_t i = 0; i < nRegisters; ++i)
+                    vst1q_u8(data + offset + 16 * i, pattern[i]);
+
+            memcpy(data + offset, data, size - offset);
+        }
+
+        Simd::Instruction neonInstruction()
+        {
+            bool hasNeon = false;
+
+#if defined(__APPLE__)
+            int neon = 0;
+            size_t size = sizeof(neon);
+
+            if (sysctlbyname("hw.optional.neon", &neon, &size, nullptr, 0) == 0)
+                hasNeon = neon != 0;
+#elif defined(_WIN32)
+            hasNeon = IsProcessorFeaturePresent(PF_ARM_NEON_INSTRUCTIONS_AVAILABLE);
+#elif defined(__linux__) && defined(__aarch64__)
+            static const unsigned long hwcapAsimd = 1 << 1;
+            hasNeon = getauxval(AT_HWCAP) & hwcapAsimd;
+#elif defined(__linux__)
+            static const unsigned long hwcapNeon = 1 << 12;
+            hasNeon = getauxval(AT_HWCAP) & hwcapNeon;
+#elif defined(__aarch64__)
+            // NEON is mandatory in ARMv8.
+            hasNeon = true;
+#endif
+
+            return hasNeon? Simd::Instruction_NEON: Simd::Instruction_None;
+        }
+#endif
+    }
+}
+
+AkVCam::Simd::Instruction AkVCam::Simd::cpuInstruction()
+{
+    static const auto instruction = [] () {
+#if defined(AKVCAM_SIMD_X86)
+        return SimdPrivate::x86Instruction();
+#elif defined(AKVCAM_SIMD_NEON)
+        return SimdPrivate::neonInstruction();
+#else
+        return Instruction_None;
+#endif
+    } ();
+
+    return instruction;
+}
+
+AkVCam::Simd::Instruction AkVCam::Simd::instruction()
+{
+    return SimdPrivate::kernels().instruction;
+}
+
+int AkVCam::Simd::blockSize()
+{
+    return SimdPrivate::kernels().blockSize;
+}
+
+bool AkVCam::Simd::loadColorMatrix(const int64_t *colorMatrix,
+                                   const int64_t *minValues,
+                                   const int64_t *maxValues,
+                                   int64_t colorShift,
+                                   ColorMatrix *matrix)
+{
+    if (!colorMatrix || !minValues || !maxValues || !matrix)
+        return false;
+
+    if (colorShift < 0 || colorShift > 31)
+        return false;
+
+    for (int row = 0; row < 3; ++row) {
+        auto coefficients = colorMatrix + 4 * row;
+
+        // Worst case accumulation for a 8 bits input, this must fit in the
+        // 32 bits lanes.
+
+        int64_t sum = 0;
+
+        for (int col = 0; col < 3; ++col) {
+            auto k = coefficients[col];
+
+            if (k < std::numeric_limits<int16_t>::min()
+                || k > std::numeric_limits<int16_t>::max())
+                return false;
+
+            sum += 255 * std::abs(k);
+            matrix->m[row][col] = int16_t(k);
+        }
+
+        auto offset = coefficients[3];
+        sum += std::abs(offset);
+
+        if (sum > std::numeric_limits<int32_t>::max())
+            return false;
+
+        if (minValues[row] < 0
+            || maxValues[row] > 255
+            || minValues[row] > maxValues[row])
+            return false;
+
+        matrix->offset[row] = int32_t(offset);
+        matrix->min[row] = int16_t(minValues[row]);
+        matrix->max[row] = int16_t(maxValues[row]);
+    }
+
+    matrix->shift = int(colorShift);
+
+    return true;
+}
+
+bool AkVCam::Simd::loadAlphaMatrix(const int64_t *alphaMatrix,
+                                   const int64_t *minValues,
+                                   const int64_t *maxValues,
+                                   int64_t alphaShift,
+                                   AlphaMatrix *matrix)
+{
+    if (!alphaMatrix || !minValues || !maxValues || !matrix)
+        return false;
+
+    if (alphaShift < 1 || alphaShift > 62)
+        return false;
+
+    /* The kernels implement the blending of ColorConvert for a 8 bits alpha,
+     * so recover the background from the coefficients and check that they
+     * match.
+     */
+
+    int64_t shiftDiv = int64_t(1) << alphaShift;
+    int64_t rounding = int64_t(1) << (alphaShift - 1);
+    int64_t k = (2 * shiftDiv + 255) / 510;
+    bool premultiplied = alphaMatrix[3] != 0;
+
+    for (int row = 0; row < 3; ++row) {
+        auto coefficients = alphaMatrix + 4 * row;
+        auto offset = coefficients[2] - rounding;
+
+        if (offset & (shiftDiv - 1))
+            return false;
+
+        auto background = offset / shiftDiv;
+
+        if (premultiplied) {
+            if (coefficients[0] != 0
+                || coefficients[3] != shiftDiv
+                || background < -255
+                || background > 255)
+                return false;
+        } else {
+            if (coefficients[0] != k
+                || coefficients[3] != 0
+                || background < 0
+                || background > 255)
+                return false;
+        }
+
+        if (coefficients[1] != -background * k)
+            return false;
+
+        if (minValues[row] < 0
+            || maxValues[row] > 255
+            || minValues[row] > maxValues[row])
+            return false;
+
+        matrix->background[row] = int16_t(background);
+        matrix->min[row] = int16_t(minValues[row]);
+        matrix->max[row] = int16_t(maxValues[row]);
+    }
+
+    matrix->premultiplied = premultiplied;
+
+    return true;
+}
+
+AkVCam::Simd::Instruction AkVCam::Simd::instructionFromString(const std::string &instruction)
+{
+    std::string str;
+
+    for (auto &c: instruction)
+        str += char(tolower(c));
+
+    if (str == "sse2")
+        return Instruction_SSE2;
+
+    if (str == "avx2")
+        return Instruction_AVX2;
+
+    if (str == "neon")
+        return Instruction_NEON;
+
+    if (str == "none")
+        return Instruction_None;
+
+    return Instruction_Unknown;
+}
+
+std::string AkVCam::Simd::instructionToString(Instruction instruction)
+{
+    switch (instruction) {
+    case Instruction_SSE2:
+        return "sse2";
+
+    case Instruction_AVX2:
+        return "avx2";
+
+    case Instruction_NEON:
+        return "neon";
+
+    case Instruction_None:
+        return "none";
+
+    default:
+        break;
+    }
+
+    return "unknown";
+}
+
+void AkVCam::Simd::matrix3to3(const ColorMatrix &matrix,
+                              const uint8_t *a,
+                              const uint8_t *b,
+                              const uint8_t *c,
+                              uint8_t *x,
+                              uint8_t *y,
+                              uint8_t *z,
+                              int width)
+{
+    SimdPrivate::kernels().matrix3to3(matrix, a, b, c, x, y, z, width);
+}
+
+void AkVCam::Simd::matrix3to1(const ColorMatrix &matrix,
+                              const uint8_t *a,
+                              const uint8_t *b,
+                              const uint8_t *c,
+                              uint8_t *x,
+                              int width)
+{
+    SimdPrivate::kernels().matrix3to1(matrix, a, b, c, x, width);
+}
+
+void AkVCam::Simd::point1to3(const ColorMatrix &matrix,
+                             const uint8_t *p,
+                             uint8_t *x,
+                             uint8_t *y,
+                             uint8_t *z,
+                             int width)
+{
+    SimdPrivate::kernels().point1to3(matrix, p, x, y, z, width);
+}
+
+void AkVCam::Simd::alphaBlend3(const AlphaMatrix &matrix,
+                               const uint8_t *a,
+                               uint8_t *x,
+                               uint8_t *y,
+                               uint8_t *z,
+                               int width)
+{
+    uint8_t *planes[] {x, y, z};
+    SimdPrivate::kernels().alphaBlend(matrix, a, planes, 3, width);
+}
+
+void AkVCam::Simd::alphaBlend1(const AlphaMatrix &matrix,
+                               const uint8_t *a,
+                               uint8_t *x,
+                               int width)
+{
+    SimdPrivate::kernels().alphaBlend(matrix, a, &x, 1, width);
+}
+
+void AkVCam::Simd::grayScale(uint32_t *line, int width)
+{
+    SimdPrivate::kernels().grayScale(line, width);
+}
+
+void AkVCam::Simd::swapRgb(uint32_t *line, int width)
+{
+    SimdPrivate::kernels().swapRgb(line, width);
+}
+
+void AkVCam::Simd::mirror(uint32_t *line, int width)
+{
+    SimdPrivate::kernels().mirror(line, width);
+}
+
+void AkVCam::Simd::fill(uint8_t *data, size_t size, size_t pixelSize)
+{
+    SimdPrivate::kernels().fill(data, size, pixelSize);
+}
+
+const AkVCam::SimdPrivate::Kernels &AkVCam::SimdPrivate::kernels()
+{
+    static const auto kernels = selectKernels();
+
+    return kernels;
+}
+
+AkVCam::SimdPrivate::Kernels AkVCam::SimdPrivate::selectKernels()
+{
+    auto instruction = Simd::cpuInstruction();
+    auto forcedInstruction = getenv(AKVCAM_SIMD_ENV);
+
+    if (forcedInstruction) {
+        auto forced = Simd::instructionFromString(forcedInstruction);
+
+        if (forced == Simd::Instruction_Unknown) {
+            AkLogWarning("Ignoring unknown %s value: %s",
+                         AKVCAM_SIMD_ENV,
+                         forcedInstruction);
+        } else if (!isSupported(forced, instruction)) {
+            AkLogWarning("Ignoring %s=%s, not supported by the CPU",
+                         AKVCAM_SIMD_ENV,
+                         forcedInstruction);
+        } else {
+            AkLogInfo("Instruction set forced to %s by %s",
+                      Simd::instructionToString(forced).c_str(),
+                      AKVCAM_SIMD_ENV);
+            instruction = forced;
+        }
+    }
+
+    switch (instruction) {
+#ifdef AKVCAM_SIMD_X86
+    case Simd::Instruction_AVX2:
+        return {
+            Simd::Instruction_AVX2,
+            32,
+            avx2Matrix3to3Kernel,
+            avx2Matrix3to1Kernel,
+            avx2Point1to3Kernel,
+            avx2AlphaBlendKernel,
+            avx2GrayScaleKernel,
+            avx2SwapRgbKernel,
+            avx2MirrorKernel,
+            avx2FillKernel
+        };
+
+    case Simd::Instruction_SSE2:
+        return {
+            Simd::Instruction_SSE2,
+            16,
+            sse2Matrix3to3Kernel,
+            sse2Matrix3to1Kernel,
+            sse2Point1to3Kernel,
+            sse2AlphaBlendKernel,
+            sse2GrayScaleKernel,
+            sse2SwapRgbKernel,
+            sse2MirrorKernel,
+            sse2FillKernel
+        };
+#endif
+
+#ifdef AKVCAM_SIMD_NEON
+    case Simd::Instruction_NEON:
+        return {
+            Simd::Instruction_NEON,
+            16,
+            neonMatrix3to3Kernel,
+            neonMatrix3to1Kernel,
+            neonPoint1to3Kernel,
+            neonAlphaBlendKernel,
+            neonGrayScaleKernel,
+            neonSwapRgbKernel,
+            neonMirrorKernel,
+            neonFillKernel
+        };
+#endif
+
+    default:
+        break;
+    }
+
+    return {
+        Simd::Instruction_None,
+        1,
+        scalarMatrix3to3Kernel,
+        scalarMatrix3to1Kernel,
+        scalarPoint1to3Kernel,
+        scalarAlphaBlendKernel,
+        scalarGrayScaleKernel,
+        scalarSwapRgbKernel,
+        scalarMirrorKernel,
+        scalarFill
+    };
+}
+
+bool AkVCam::SimdPrivate::isSupported(Simd::Instruction instruction,
+                                      Simd::Instruction cpuInstruction)
+{
+    switch (instruction) {
+    case Simd::Instruction_None:
+        return true;
+
+    case Simd::Instruction_SSE2:
+        return cpuInstruction == Simd::Instruction_SSE2
+               || cpuInstruction == Simd::Instruction_AVX2;
+
+    case Simd::Instruction_AVX2:
+        return cpuInstruction == Simd::Instruction_AVX2;
+
+    case Simd::Instruction_NEON:
+        return cpuInstruction == Simd::Instruction_NEON;
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+#define DEFINE_CASE_INS(ins) \
+    case AkVCam::Simd::ins: \
+        os << #ins; \
+        \
+        break;
+
+std::ostream &operator <<(std::ostream &os, AkVCam::Simd::Instruction instruction)
+{
+    switch (instruction) {
+    DEFINE_CASE_INS(Instruction_None)
+    DEFINE_CASE_INS(Instruction_SSE2)
+    DEFINE_CASE_INS(Instruction_AVX2)
+    DEFINE_CASE_INS(Instruction_NEON)
+
+    default:
+        os << "Instruction_Unknown";
+
+        break;
+    }
+
+    return os;
+}
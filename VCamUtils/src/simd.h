@@ -0,0 +1,153 @@
+/* akvirtualcamera, virtual camera for Mac and Windows.
+ * Copyright (C) 2025  Gonzalo Exequiel Pedone
+ *
+ * akvirtualcamera is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * akvirtualcamera is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with akvirtualcamera. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Web-Site: http://webcamoid.github.io/
+ */
+
+#ifndef AKVCAMUTILS_SIMD_H
+#define AKVCAMUTILS_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/* The instruction set used by the kernels is detected at runtime the first
+ * time a kernel is called. Set this environment variable to "none", "sse2",
+ * "avx2" or "neon" to force a lower instruction set, unknown values and the
+ * instruction sets not supported by the CPU are ignored.
+ */
+#define AKVCAM_SIMD_ENV "AKVCAM_SIMD"
+
+namespace AkVCam
+{
+    class Simd
+    {
+        public:
+            enum Instruction
+            {
+                Instruction_Unknown = -1,
+                Instruction_None,
+                Instruction_SSE2,
+                Instruction_AVX2,
+                Instruction_NEON,
+            };
+
+            /* Color matrix for 8 bits components.
+             *
+             * The coefficients are reduced to 16 bits and the offsets to
+             * 32 bits, so the products can be accumulated in 32 bits lanes
+             * without overflowing.
+             */
+            struct ColorMatrix
+            {
+                int16_t m[3][3];
+                int32_t offset[3];
+                int16_t min[3];
+                int16_t max[3];
+                int shift;
+            };
+
+            /* Alpha matrix for 8 bits components and 8 bits alpha.
+             *
+             * For straight alpha the components are composited over the
+             * background, for premultiplied alpha the background is the
+             * difference between the background color and black, and it's
+             * added to the components weighted by the transparency.
+             */
+            struct AlphaMatrix
+            {
+                int16_t background[3];
+                int16_t min[3];
+                int16_t max[3];
+                bool premultiplied;
+            };
+
+            // Best instruction set supported by the CPU.
+            static Instruction cpuInstruction();
+
+            // Instruction set used by the kernels.
+            static Instruction instruction();
+
+            // Number of pixels processed by iteration of the vector units.
+            static int blockSize();
+
+            static bool loadColorMatrix(const int64_t *colorMatrix,
+                                        const int64_t *minValues,
+                                        const int64_t *maxValues,
+                                        int64_t colorShift,
+                                        ColorMatrix *matrix);
+            static bool loadAlphaMatrix(const int64_t *alphaMatrix,
+                                        const int64_t *minValues,
+                                        const int64_t *maxValues,
+                                        int64_t alphaShift,
+                                        AlphaMatrix *matrix);
+            static Instruction instructionFromString(const std::string &instruction);
+            static std::string instructionToString(Instruction instruction);
+
+            // Planar 8 bits conversion kernels
+
+            static void matrix3to3(const ColorMatrix &matrix,
+                                   const uint8_t *a,
+                                   const uint8_t *b,
+                                   const uint8_t *c,
+                                   uint8_t *x,
+                                   uint8_t *y,
+                                   uint8_t *z,
+                                   int width);
+            static void matrix3to1(const ColorMatrix &matrix,
+                                   const uint8_t *a,
+                                   const uint8_t *b,
+                                   const uint8_t *c,
+                                   uint8_t *x,
+                                   int width);
+            static void point1to3(const ColorMatrix &matrix,
+                                  const uint8_t *p,
+                                  uint8_t *x,
+                                  uint8_t *y,
+                                  uint8_t *z,
+                                  int width);
+
+            // Composites the components over the background in place. The
+            // fully opaque and fully transparent blocks are only clamped or
+            // filled.
+
+            static void alphaBlend3(const AlphaMatrix &matrix,
+                                    const uint8_t *a,
+                                    uint8_t *x,
+                                    uint8_t *y,
+                                    uint8_t *z,
+                                    int width);
+            static void alphaBlend1(const AlphaMatrix &matrix,
+                                    const uint8_t *a,
+                                    uint8_t *x,
+                                    int width);
+
+            // ARGB kernels
+
+            static void grayScale(uint32_t *line, int width);
+            static void swapRgb(uint32_t *line, int width);
+            static void mirror(uint32_t *line, int width);
+
+            // Repeats the first pixelSize bytes of data until filling size
+            // bytes.
+            static void fill(uint8_t *data, size_t size, size_t pixelSize);
+    };
+}
+
+std::ostream &operator <<(std::ostream &os, AkVCam::Simd::Instruction instruction);
+
+#endif // AKVCAMUTILS_SIMD_H
@@ -24,6 +24,7 @@
 
 #include "videoadjusts.h"
 #include "color.h"
+#include "simd.h"
 #include "videoconverter.h"
 #include "videoframe.h"
 
@@ -264,16 +265,9 @@ void AkVCam::VideoAdjustsPrivate::adjustMirror(VideoFrame &frame)
     int height = frame.format().height();
 
     if (this->m_horizontalMirror) {
-        int width2 = frame.format().width() / 2;
-
         for (int y = 0; y < height; ++y) {
             auto srcLine = reinterpret_cast<uint32_t *>(frame.line(0, size_t(y)));
-
-            for (int x = 0; x < width2; ++x) {
-                auto pixel = srcLine[x];
-                srcLine[x] = srcLine[width - x - 1];
-                srcLine[width - x - 1] = pixel;
-            }
+            Simd::mirror(srcLine, width);
         }
     }
 
@@ -301,13 +295,7 @@ void AkVCam::VideoAdjustsPrivate::adjustSwapRGB(VideoFrame &frame)
 
     for (int y = 0; y < height; ++y) {
         auto srcLine = reinterpret_cast<uint32_t *>(frame.line(0, size_t(y)));
-
-        for (int x = 0; x < width; ++x) {
-            srcLine[x] = Color::rgb(Color::blue(srcLine[x]),
-                                    Color::green(srcLine[x]),
-                                    Color::red(srcLine[x]),
-                                    Color::alpha(srcLine[x]));
-        }
+        Simd::swapRgb(srcLine, width);
     }
 }
 
@@ -401,9 +389,7 @@ void AkVCam::VideoAdjustsPrivate::adjustGrayScale(VideoFrame &frame)
 
     for (int y = 0; y < height; ++y) {
         auto srcLine = reinterpret_cast<uint32_t *>(frame.line(0, size_t(y)));
-
-        for (int x = 0; x < width; ++x)
-            srcLine[x] = Color::gray(srcLine[x]);
+        Simd::grayScale(srcLine, width);
     }
 }
 
@@ -17,9 +17,17 @@
  * Web-Site: http://webcamoid.github.io/
  */
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
+#include <list>
+#include <memory>
 #include <sstream>
 #include <mutex>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "videoconverter.h"
 #include "color.h"
@@ -29,19 +37,39 @@
 #include "videoformat.h"
 #include "videoformatspec.h"
 #include "videoframe.h"
+#include "simd.h"
+#include "workerpool.h"
 
-#define SCALE_EMULT 8
+// Precision of the linear upscaling coefficients, in bits.
+#define SCALE_EMULT 15
+#define SCALE_ROUND (int64_t(1) << (2 * SCALE_EMULT - 1))
+
+// Number of pixels gathered for each call to the vector kernels.
+#define SIMD_TILE_SIZE 256
+
+// Minimum number of lines processed by each thread.
+#define MIN_STRIPE_HEIGHT 16
+
+// Number of input lines converted to all the outputs before moving to the
+// next lines, in the multiple outputs conversion.
+#define BAND_HEIGHT 32
+
+// Maximum memory used by the conversion plans shared between converters.
+#define PLAN_CACHE_MAX_SIZE (32 * 1024 * 1024)
 
 /*
- * NOTE: Using integer numbers is much faster but can overflow with high
- * resolution and depth frames.
+ * Type of the sums used by the linear downscaling. Integer numbers are much
+ * faster, so the smallest one that can't overflow with the input frame is
+ * selected, and floating point numbers are used only when the sums doesn't
+ * fits in 64 bits.
  */
 
-#if 0
-using DlSumType = uint64_t;
-#else
-using DlSumType = double;
-#endif
+enum DlSumType
+{
+    DlSumType_32,
+    DlSumType_64,
+    DlSumType_Double,
+};
 
 enum ConvertType
 {
@@ -82,6 +110,14 @@ enum ResizeMode
 
 namespace AkVCam
 {
+    class FrameConvertParameters;
+
+    using DirectConvertFunc = void (*)(const FrameConvertParameters &fc,
+                                       const VideoFrame &src,
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax);
+
     class FrameConvertParameters
     {
         public:
@@ -90,10 +126,11 @@ namespace AkVCam
             VideoFormat inputFormat;
             VideoFormat outputFormat;
             VideoFormat outputConvertFormat;
-            VideoFrame outputFrame;
             Rect inputRect;
             AkVCam::ColorConvert::YuvColorSpace yuvColorSpace {AkVCam::ColorConvert::YuvColorSpace_ITUR_BT601};
             AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType {AkVCam::ColorConvert::YuvColorSpaceType_StudioSwing};
+            AkVCam::ColorConvert::AlphaMode inputAlphaMode {AkVCam::ColorConvert::AlphaMode_Straight};
+            uint32_t backgroundColor {0xff000000};
             AkVCam::VideoConverter::ScalingMode scalingMode {AkVCam::VideoConverter::ScalingMode_Fast};
             AkVCam::VideoConverter::AspectRatioMode aspectRatioMode {AkVCam::VideoConverter::AspectRatioMode_Ignore};
             ConvertType convertType {ConvertType_Vector};
@@ -101,6 +138,14 @@ namespace AkVCam
             ConvertAlphaMode alphaMode {ConvertAlphaMode_AI_AO};
             ResizeMode resizeMode {ResizeMode_Keep};
             bool fastConvertion {false};
+            bool simdConvertion {false};
+
+            // The output words have bits that belong to no component.
+            bool outputPadding {false};
+            Simd::ColorMatrix simdColorMatrix {};
+            bool simdAlphaBlending {false};
+            Simd::AlphaMatrix simdAlphaMatrix {};
+            DirectConvertFunc directConvert {nullptr};
 
             int fromEndian {ENDIANNESS_BO};
             int toEndian {ENDIANNESS_BO};
@@ -138,17 +183,10 @@ namespace AkVCam
             int *dstWidthOffsetZ {nullptr};
             int *dstWidthOffsetA {nullptr};
 
-            size_t *srcHeightDlOffset {nullptr};
-            size_t *srcHeightDlOffset_1 {nullptr};
-
-            DlSumType *integralImageDataX {nullptr};
-            DlSumType *integralImageDataY {nullptr};
-            DlSumType *integralImageDataZ {nullptr};
-            DlSumType *integralImageDataA {nullptr};
-
-            int64_t *kx {nullptr};
-            int64_t *ky {nullptr};
-            DlSumType *kdl {nullptr};
+            uint16_t *kx {nullptr};
+            uint16_t *ky {nullptr};
+            uint64_t *kdlX {nullptr};
+            uint64_t *kdlY {nullptr};
 
             int planeXi {0};
             int planeYi {0};
@@ -202,6 +240,11 @@ namespace AkVCam
 
             uint64_t alphaMask {0};
 
+            DlSumType dlSumType {DlSumType_64};
+            bool dlFixedPoint {false};
+            int dlShiftX {0};
+            int dlShiftY {0};
+
             FrameConvertParameters();
             FrameConvertParameters(const FrameConvertParameters &other);
             ~FrameConvertParameters();
@@ -215,100 +258,601 @@ namespace AkVCam
                            const VideoFormat &oformat,
                            ColorConvert &colorConvert,
                            AkVCam::ColorConvert::YuvColorSpace yuvColorSpace,
-                           AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType);
+                           AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                           AkVCam::ColorConvert::AlphaMode inputAlphaMode,
+                           uint32_t backgroundColor);
             void configureScaling(const VideoFormat &iformat,
                                   const VideoFormat &oformat,
                                   const Rect &inputRect,
                                   AkVCam::VideoConverter::AspectRatioMode aspectRatioMode);
+
+            // Recalculates only the tables that depends on the input size and
+            // the input rectangle. Returns false if the output size changes,
+            // in which case the plan must be configured again.
+            bool updateScaling(const VideoFormat &iformat,
+                               const Rect &inputRect);
+            inline void configureGeometry(const VideoFormat &iformat,
+                                          const VideoFormat &oformat,
+                                          const Rect &inputRect,
+                                          AkVCam::VideoConverter::AspectRatioMode aspectRatioMode,
+                                          Rect &irect,
+                                          int &owidth,
+                                          int &oheight);
+            inline void configureSourceTables(const VideoFormat &iformat,
+                                              const Rect &irect,
+                                              int owidth,
+                                              int oheight);
+            bool isSameConversion(const VideoFormat &iformat,
+                                  const VideoFormat &oformat,
+                                  AkVCam::ColorConvert::YuvColorSpace yuvColorSpace,
+                                  AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                                  AkVCam::ColorConvert::AlphaMode inputAlphaMode,
+                                  uint32_t backgroundColor,
+                                  AkVCam::VideoConverter::ScalingMode scalingMode,
+                                  AkVCam::VideoConverter::AspectRatioMode aspectRatioMode) const;
+            bool isSame(const VideoFormat &iformat,
+                        const VideoFormat &oformat,
+                        AkVCam::ColorConvert::YuvColorSpace yuvColorSpace,
+                        AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                        AkVCam::ColorConvert::AlphaMode inputAlphaMode,
+                        uint32_t backgroundColor,
+                        AkVCam::VideoConverter::ScalingMode scalingMode,
+                        AkVCam::VideoConverter::AspectRatioMode aspectRatioMode,
+                        const Rect &inputRect) const;
+            size_t memorySize() const;
             void reset();
     };
 
+    using FrameConvertParametersPtr = std::shared_ptr<const FrameConvertParameters>;
+
+    /* Conversion plans shared by all the converters of the process.
+     *
+     * A plan is never modified once configured, so all the converters doing
+     * the same conversion use the same tables. When the plans exceed
+     * PLAN_CACHE_MAX_SIZE the least recently used ones are dropped, the
+     * converters still using them keep their own reference.
+     */
+    class FrameConvertCache
+    {
+        public:
+            static FrameConvertCache &instance();
+            FrameConvertParametersPtr parameters(const VideoFormat &iformat,
+                                                 const VideoFormat &oformat,
+                                                 AkVCam::ColorConvert::YuvColorSpace yuvColorSpace,
+                                                 AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                                                 AkVCam::ColorConvert::AlphaMode inputAlphaMode,
+                                                 uint32_t backgroundColor,
+                                                 AkVCam::VideoConverter::ScalingMode scalingMode,
+                                                 AkVCam::VideoConverter::AspectRatioMode aspectRatioMode,
+                                                 const Rect &inputRect);
+
+        private:
+            std::mutex m_mutex;
+            std::list<FrameConvertParametersPtr> m_plans;
+            size_t m_size {0};
+    };
+
+    // A cached plan and the frame where the converter writes its output.
+    struct FrameConvertSlot
+    {
+        FrameConvertParametersPtr fc;
+        VideoFrame outputFrame;
+
+        // Plan owned only by this slot. The shared plans can't be modified,
+        // so the plan is copied here the first time the input rectangle
+        // moves, and then updated in place.
+        std::shared_ptr<FrameConvertParameters> ownFc;
+    };
+
+    // One of the outputs of a multiple outputs conversion.
+    struct FrameConvertTarget
+    {
+        const FrameConvertParameters *fc;
+        VideoFrame *dst;
+    };
+
+    // Keeps the last two interpolated input lines of the linear upscaling.
+    class LineCache
+    {
+        public:
+            int64_t *line {nullptr};
+            int64_t *line_1 {nullptr};
+
+            LineCache(size_t lineSize):
+                m_data(2 * lineSize)
+            {
+                this->line = this->m_data.data();
+                this->line_1 = this->line + lineSize;
+            }
+
+            /* Makes line and line_1 hold the input lines ys and ys_1,
+             * interpolating only the lines that were not used by the
+             * previous output line.
+             */
+            template <typename InterpolateFunction>
+            inline void update(int ys, int ys_1, InterpolateFunction interpolate)
+            {
+                if (this->m_ys_1 == ys && this->m_ys != ys) {
+                    std::swap(this->line, this->line_1);
+                    std::swap(this->m_ys, this->m_ys_1);
+                }
+
+                if (this->m_ys != ys) {
+                    interpolate(ys, this->line);
+                    this->m_ys = ys;
+                }
+
+                if (this->m_ys_1 != ys_1) {
+                    interpolate(ys_1, this->line_1);
+                    this->m_ys_1 = ys_1;
+                }
+            }
+
+        private:
+            std::vector<int64_t> m_data;
+            int m_ys {-1};
+            int m_ys_1 {-1};
+    };
+
     class VideoConverterPrivate
     {
         public:
             std::mutex m_mutex;
             VideoFormat m_outputFormat;
-            FrameConvertParameters *m_fc {nullptr};
-            size_t m_fcSize {0};
+            std::vector<FrameConvertSlot> m_slots;
             int m_cacheIndex {0};
             AkVCam::ColorConvert::YuvColorSpace m_yuvColorSpace {AkVCam::ColorConvert::YuvColorSpace_ITUR_BT601};
             AkVCam::ColorConvert::YuvColorSpaceType m_yuvColorSpaceType {AkVCam::ColorConvert::YuvColorSpaceType_StudioSwing};
+            AkVCam::ColorConvert::AlphaMode m_alphaMode {AkVCam::ColorConvert::AlphaMode_Straight};
+            uint32_t m_backgroundColor {0xff000000};
             AkVCam::VideoConverter::ScalingMode m_scalingMode {AkVCam::VideoConverter::ScalingMode_Fast};
             AkVCam::VideoConverter::AspectRatioMode m_aspectRatioMode {AkVCam::VideoConverter::AspectRatioMode_Ignore};
             Rect m_inputRect;
+            int m_threadCount {1};
+            WorkerPool m_workerPool;
 
-            /* Color blendig functions
+            /* Linear interpolation functions
+             *
+             * The upscaling is done in two passes. Each input line is
+             * interpolated horizontally once into a line cache, with the
+             * components scaled by 2^SCALE_EMULT, and the output lines are
+             * interpolated vertically from two cached lines.
              *
-             * kx and ky must be in the range of [0, 2^N]
+             * k must be in the range of [0, 2^N)
              */
 
             template <int N>
-            inline void blend(int64_t a,
-                              int64_t bx, int64_t by,
-                              int64_t kx, int64_t ky,
-                              int64_t *c) const
+            inline void lerp(int64_t a, int64_t b, int64_t k, int64_t *c) const
             {
-                *c = (kx * (bx - a) + ky * (by - a) + (a << (N + 1))) >> (N + 1);
+                *c = (a << N) + k * (b - a);
             }
 
-            template <int N>
-            inline void blend2(const int64_t *ax,
-                               const int64_t *bx, const int64_t *by,
-                               int64_t kx, int64_t ky,
-                               int64_t *c) const
+            template <typename InputType>
+            inline void interpolateUL1(const FrameConvertParameters &fc,
+                                       const VideoFrame &src,
+                                       int ys,
+                                       int64_t *line) const
             {
-                this->blend<N>(ax[0],
-                               bx[0], by[0],
-                               kx, ky,
-                               c);
-                this->blend<N>(ax[1],
-                               bx[1], by[1],
-                               kx, ky,
-                               c + 1);
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto pixel = line + 1 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto xi_1 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        xi_1 = Algorithm::swapBytes(InputType(xi_1));
+                    }
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(int64_t((xi >> fc.xiShift) & fc.maxXi),
+                                            int64_t((xi_1 >> fc.xiShift) & fc.maxXi),
+                                            kx,
+                                            pixel);
+                    pixel += 1;
+                }
             }
 
-            template <int N>
-            inline void blend3(const int64_t *ax,
-                               const int64_t *bx, const int64_t *by,
-                               int64_t kx, int64_t ky,
-                               int64_t *c) const
-            {
-                this->blend<N>(ax[0],
-                               bx[0], by[0],
-                               kx, ky,
-                               c);
-                this->blend<N>(ax[1],
-                               bx[1], by[1],
-                               kx, ky,
-                               c + 1);
-                this->blend<N>(ax[2],
-                               bx[2], by[2],
-                               kx, ky,
-                               c + 2);
+            inline void interpolateF8UL1(const FrameConvertParameters &fc,
+                                         const VideoFrame &src,
+                                         int ys,
+                                         int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto pixel = line + 1 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(src_line_x[xs_x],
+                                            src_line_x[xs_x_1],
+                                            kx,
+                                            pixel);
+                    pixel += 1;
+                }
             }
 
-            template <int N>
-            inline void blend4(const int64_t *ax,
-                               const int64_t *bx, const int64_t *by,
-                               int64_t kx, int64_t ky,
-                               int64_t *c) const
-            {
-                this->blend<N>(ax[0],
-                               bx[0], by[0],
-                               kx, ky,
-                               c);
-                this->blend<N>(ax[1],
-                               bx[1], by[1],
-                               kx, ky,
-                               c + 1);
-                this->blend<N>(ax[2],
-                               bx[2], by[2],
-                               kx, ky,
-                               c + 2);
-                this->blend<N>(ax[3],
-                               bx[3], by[3],
-                               kx, ky,
-                               c + 3);
+            template <typename InputType>
+            inline void interpolateUL1A(const FrameConvertParameters &fc,
+                                        const VideoFrame &src,
+                                        int ys,
+                                        int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                auto pixel = line + 2 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+                    int &xs_a = fc.srcWidthOffsetA[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+                    int &xs_a_1 = fc.srcWidthOffsetA_1[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto ai = *reinterpret_cast<const InputType *>(src_line_a + xs_a);
+                    auto xi_1 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
+                    auto ai_1 = *reinterpret_cast<const InputType *>(src_line_a + xs_a_1);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        ai = Algorithm::swapBytes(InputType(ai));
+                        xi_1 = Algorithm::swapBytes(InputType(xi_1));
+                        ai_1 = Algorithm::swapBytes(InputType(ai_1));
+                    }
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(int64_t((xi >> fc.xiShift) & fc.maxXi),
+                                            int64_t((xi_1 >> fc.xiShift) & fc.maxXi),
+                                            kx,
+                                            pixel);
+                    this->lerp<SCALE_EMULT>(int64_t((ai >> fc.aiShift) & fc.maxAi),
+                                            int64_t((ai_1 >> fc.aiShift) & fc.maxAi),
+                                            kx,
+                                            pixel + 1);
+                    pixel += 2;
+                }
+            }
+
+            inline void interpolateF8UL1A(const FrameConvertParameters &fc,
+                                          const VideoFrame &src,
+                                          int ys,
+                                          int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                auto pixel = line + 2 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+                    int &xs_a = fc.srcWidthOffsetA[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+                    int &xs_a_1 = fc.srcWidthOffsetA_1[x];
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(src_line_x[xs_x],
+                                            src_line_x[xs_x_1],
+                                            kx,
+                                            pixel);
+                    this->lerp<SCALE_EMULT>(src_line_a[xs_a],
+                                            src_line_a[xs_a_1],
+                                            kx,
+                                            pixel + 1);
+                    pixel += 2;
+                }
+            }
+
+            template <typename InputType>
+            inline void interpolateUL3(const FrameConvertParameters &fc,
+                                       const VideoFrame &src,
+                                       int ys,
+                                       int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
+                auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                auto pixel = line + 3 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+                    int &xs_y = fc.srcWidthOffsetY[x];
+                    int &xs_z = fc.srcWidthOffsetZ[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+                    int &xs_y_1 = fc.srcWidthOffsetY_1[x];
+                    int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto yi = *reinterpret_cast<const InputType *>(src_line_y + xs_y);
+                    auto zi = *reinterpret_cast<const InputType *>(src_line_z + xs_z);
+                    auto xi_1 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
+                    auto yi_1 = *reinterpret_cast<const InputType *>(src_line_y + xs_y_1);
+                    auto zi_1 = *reinterpret_cast<const InputType *>(src_line_z + xs_z_1);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        yi = Algorithm::swapBytes(InputType(yi));
+                        zi = Algorithm::swapBytes(InputType(zi));
+                        xi_1 = Algorithm::swapBytes(InputType(xi_1));
+                        yi_1 = Algorithm::swapBytes(InputType(yi_1));
+                        zi_1 = Algorithm::swapBytes(InputType(zi_1));
+                    }
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(int64_t((xi >> fc.xiShift) & fc.maxXi),
+                                            int64_t((xi_1 >> fc.xiShift) & fc.maxXi),
+                                            kx,
+                                            pixel);
+                    this->lerp<SCALE_EMULT>(int64_t((yi >> fc.yiShift) & fc.maxYi),
+                                            int64_t((yi_1 >> fc.yiShift) & fc.maxYi),
+                                            kx,
+                                            pixel + 1);
+                    this->lerp<SCALE_EMULT>(int64_t((zi >> fc.ziShift) & fc.maxZi),
+                                            int64_t((zi_1 >> fc.ziShift) & fc.maxZi),
+                                            kx,
+                                            pixel + 2);
+                    pixel += 3;
+                }
+            }
+
+            inline void interpolateF8UL3(const FrameConvertParameters &fc,
+                                         const VideoFrame &src,
+                                         int ys,
+                                         int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
+                auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                auto pixel = line + 3 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+                    int &xs_y = fc.srcWidthOffsetY[x];
+                    int &xs_z = fc.srcWidthOffsetZ[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+                    int &xs_y_1 = fc.srcWidthOffsetY_1[x];
+                    int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(src_line_x[xs_x],
+                                            src_line_x[xs_x_1],
+                                            kx,
+                                            pixel);
+                    this->lerp<SCALE_EMULT>(src_line_y[xs_y],
+                                            src_line_y[xs_y_1],
+                                            kx,
+                                            pixel + 1);
+                    this->lerp<SCALE_EMULT>(src_line_z[xs_z],
+                                            src_line_z[xs_z_1],
+                                            kx,
+                                            pixel + 2);
+                    pixel += 3;
+                }
+            }
+
+            template <typename InputType>
+            inline void interpolateUL3A(const FrameConvertParameters &fc,
+                                        const VideoFrame &src,
+                                        int ys,
+                                        int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
+                auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                auto pixel = line + 4 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+                    int &xs_y = fc.srcWidthOffsetY[x];
+                    int &xs_z = fc.srcWidthOffsetZ[x];
+                    int &xs_a = fc.srcWidthOffsetA[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+                    int &xs_y_1 = fc.srcWidthOffsetY_1[x];
+                    int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
+                    int &xs_a_1 = fc.srcWidthOffsetA_1[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto yi = *reinterpret_cast<const InputType *>(src_line_y + xs_y);
+                    auto zi = *reinterpret_cast<const InputType *>(src_line_z + xs_z);
+                    auto ai = *reinterpret_cast<const InputType *>(src_line_a + xs_a);
+                    auto xi_1 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
+                    auto yi_1 = *reinterpret_cast<const InputType *>(src_line_y + xs_y_1);
+                    auto zi_1 = *reinterpret_cast<const InputType *>(src_line_z + xs_z_1);
+                    auto ai_1 = *reinterpret_cast<const InputType *>(src_line_a + xs_a_1);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        yi = Algorithm::swapBytes(InputType(yi));
+                        zi = Algorithm::swapBytes(InputType(zi));
+                        ai = Algorithm::swapBytes(InputType(ai));
+                        xi_1 = Algorithm::swapBytes(InputType(xi_1));
+                        yi_1 = Algorithm::swapBytes(InputType(yi_1));
+                        zi_1 = Algorithm::swapBytes(InputType(zi_1));
+                        ai_1 = Algorithm::swapBytes(InputType(ai_1));
+                    }
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(int64_t((xi >> fc.xiShift) & fc.maxXi),
+                                            int64_t((xi_1 >> fc.xiShift) & fc.maxXi),
+                                            kx,
+                                            pixel);
+                    this->lerp<SCALE_EMULT>(int64_t((yi >> fc.yiShift) & fc.maxYi),
+                                            int64_t((yi_1 >> fc.yiShift) & fc.maxYi),
+                                            kx,
+                                            pixel + 1);
+                    this->lerp<SCALE_EMULT>(int64_t((zi >> fc.ziShift) & fc.maxZi),
+                                            int64_t((zi_1 >> fc.ziShift) & fc.maxZi),
+                                            kx,
+                                            pixel + 2);
+                    this->lerp<SCALE_EMULT>(int64_t((ai >> fc.aiShift) & fc.maxAi),
+                                            int64_t((ai_1 >> fc.aiShift) & fc.maxAi),
+                                            kx,
+                                            pixel + 3);
+                    pixel += 4;
+                }
+            }
+
+            inline void interpolateF8UL3A(const FrameConvertParameters &fc,
+                                          const VideoFrame &src,
+                                          int ys,
+                                          int64_t *line) const
+            {
+                auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
+                auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
+                auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                auto pixel = line + 4 * size_t(fc.xmin);
+
+                for (int x = fc.xmin; x < fc.xmax; ++x) {
+                    int &xs_x = fc.srcWidthOffsetX[x];
+                    int &xs_y = fc.srcWidthOffsetY[x];
+                    int &xs_z = fc.srcWidthOffsetZ[x];
+                    int &xs_a = fc.srcWidthOffsetA[x];
+
+                    int &xs_x_1 = fc.srcWidthOffsetX_1[x];
+                    int &xs_y_1 = fc.srcWidthOffsetY_1[x];
+                    int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
+                    int &xs_a_1 = fc.srcWidthOffsetA_1[x];
+
+                    int64_t kx = fc.kx[x];
+
+                    this->lerp<SCALE_EMULT>(src_line_x[xs_x],
+                                            src_line_x[xs_x_1],
+                                            kx,
+                                            pixel);
+                    this->lerp<SCALE_EMULT>(src_line_y[xs_y],
+                                            src_line_y[xs_y_1],
+                                            kx,
+                                            pixel + 1);
+                    this->lerp<SCALE_EMULT>(src_line_z[xs_z],
+                                            src_line_z[xs_z_1],
+                                            kx,
+                                            pixel + 2);
+                    this->lerp<SCALE_EMULT>(src_line_a[xs_a],
+                                            src_line_a[xs_a_1],
+                                            kx,
+                                            pixel + 3);
+                    pixel += 4;
+                }
+            }
+
+            template <typename InputType>
+            inline void updateUL1(const FrameConvertParameters &fc,
+                                  const VideoFrame &src,
+                                  int y,
+                                  LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateUL1<InputType>(fc, src, ys, line);
+                });
+            }
+
+            inline void updateF8UL1(const FrameConvertParameters &fc,
+                                    const VideoFrame &src,
+                                    int y,
+                                    LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateF8UL1(fc, src, ys, line);
+                });
+            }
+
+            template <typename InputType>
+            inline void updateUL1A(const FrameConvertParameters &fc,
+                                   const VideoFrame &src,
+                                   int y,
+                                   LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateUL1A<InputType>(fc, src, ys, line);
+                });
+            }
+
+            inline void updateF8UL1A(const FrameConvertParameters &fc,
+                                     const VideoFrame &src,
+                                     int y,
+                                     LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateF8UL1A(fc, src, ys, line);
+                });
+            }
+
+            template <typename InputType>
+            inline void updateUL3(const FrameConvertParameters &fc,
+                                  const VideoFrame &src,
+                                  int y,
+                                  LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateUL3<InputType>(fc, src, ys, line);
+                });
+            }
+
+            inline void updateF8UL3(const FrameConvertParameters &fc,
+                                    const VideoFrame &src,
+                                    int y,
+                                    LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateF8UL3(fc, src, ys, line);
+                });
+            }
+
+            template <typename InputType>
+            inline void updateUL3A(const FrameConvertParameters &fc,
+                                   const VideoFrame &src,
+                                   int y,
+                                   LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateUL3A<InputType>(fc, src, ys, line);
+                });
+            }
+
+            inline void updateF8UL3A(const FrameConvertParameters &fc,
+                                     const VideoFrame &src,
+                                     int y,
+                                     LineCache &cache) const
+            {
+                cache.update(fc.srcHeight[y],
+                             fc.srcHeight_1[y],
+                             [this, &fc, &src] (int ys, int64_t *line) {
+                    this->interpolateF8UL3A(fc, src, ys, line);
+                });
             }
 
             /* Component reading functions */
@@ -351,186 +895,93 @@ namespace AkVCam
                 *ai = (ait >> fc.aiShift) & fc.maxAi;
             }
 
-            template <typename InputType>
+            /* Average of a box of the downscaled image.
+             *
+             * When it's safe, the sum is divided by the width and then by the
+             * height of the box, multiplying by their fixed point reciprocals.
+             * Both divisions are exact, so the result is the same as dividing
+             * by the area.
+             */
+            template <typename SumType>
+            inline SumType averageDL(const FrameConvertParameters &fc,
+                                     SumType sum,
+                                     int x,
+                                     int y) const
+            {
+                if constexpr (std::is_integral_v<SumType>) {
+                    if (fc.dlFixedPoint) {
+                        auto avg = (uint64_t(sum) * fc.kdlX[x]) >> fc.dlShiftX;
+
+                        return SumType((avg * fc.kdlY[y]) >> fc.dlShiftY);
+                    }
+                }
+
+                SumType area = SumType(fc.srcWidth_1[x] - fc.srcWidth[x])
+                             * SumType(fc.srcHeight_1[y] - fc.srcHeight[y]);
+
+                return sum / area;
+            }
+
+            template <typename InputType, typename SumType>
             inline void readDL1(const FrameConvertParameters &fc,
-                                const DlSumType *src_line_x,
-                                const DlSumType *src_line_x_1,
+                                const SumType *src_line_x,
                                 int x,
-                                const DlSumType *kdl,
+                                int y,
                                 InputType *xi) const
             {
                 auto &xs = fc.srcWidth[x];
                 auto &xs_1 = fc.srcWidth_1[x];
-                auto &k = kdl[x];
 
-                *xi = (src_line_x[xs] + src_line_x_1[xs_1] - src_line_x[xs_1] - src_line_x_1[xs]) / k;
+                *xi = InputType(this->averageDL(fc, SumType(src_line_x[xs_1] - src_line_x[xs]), x, y));
             }
 
-            template <typename InputType>
+            template <typename InputType, typename SumType>
             inline void readDL1A(const FrameConvertParameters &fc,
-                                 const DlSumType *src_line_x,
-                                 const DlSumType *src_line_a,
-                                 const DlSumType *src_line_x_1,
-                                 const DlSumType *src_line_a_1,
+                                 const SumType *src_line_x,
+                                 const SumType *src_line_a,
                                  int x,
-                                 const DlSumType *kdl,
+                                 int y,
                                  InputType *xi,
                                  InputType *ai) const
             {
                 auto &xs = fc.srcWidth[x];
                 auto &xs_1 = fc.srcWidth_1[x];
-                auto &k = kdl[x];
 
-                *xi = (src_line_x[xs] + src_line_x_1[xs_1] - src_line_x[xs_1] - src_line_x_1[xs]) / k;
-                *ai = (src_line_a[xs] + src_line_a_1[xs_1] - src_line_a[xs_1] - src_line_a_1[xs]) / k;
+                *xi = InputType(this->averageDL(fc, SumType(src_line_x[xs_1] - src_line_x[xs]), x, y));
+                *ai = InputType(this->averageDL(fc, SumType(src_line_a[xs_1] - src_line_a[xs]), x, y));
             }
 
             template <typename InputType>
-            inline void readUL1(const FrameConvertParameters &fc,
-                                const uint8_t *src_line_x,
-                                const uint8_t *src_line_x_1,
+            inline void readUL1(const int64_t *line,
+                                const int64_t *line_1,
                                 int x,
                                 int64_t ky,
                                 InputType *xi) const
             {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-
-                auto xi_ = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
-                auto xi_x = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
-                auto xi_y = *reinterpret_cast<const InputType *>(src_line_x_1 + xs_x);
-
-                if (fc.fromEndian != ENDIANNESS_BO) {
-                    xi_ = Algorithm::swapBytes(InputType(xi_));
-                    xi_x = Algorithm::swapBytes(InputType(xi_x));
-                    xi_y = Algorithm::swapBytes(InputType(xi_y));
-                }
-
-                xi_ = (xi_ >> fc.xiShift) & fc.maxXi;
-                xi_x = (xi_x >> fc.xiShift) & fc.maxXi;
-                xi_y = (xi_y >> fc.xiShift) & fc.maxXi;
-
-                int64_t xib = 0;
-                this->blend<SCALE_EMULT>(xi_,
-                                         xi_x, xi_y,
-                                         fc.kx[x], ky,
-                                         &xib);
-                *xi = xib;
-            }
-
-            inline void readF8UL1(const FrameConvertParameters &fc,
-                                  const uint8_t *src_line_x,
-                                  const uint8_t *src_line_x_1,
-                                  int x,
-                                  int64_t ky,
-                                  uint8_t *xi) const
-            {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-
-                auto xi_ = src_line_x[xs_x];
-                auto xi_x = src_line_x[xs_x_1];
-                auto xi_y = src_line_x_1[xs_x];
+                auto pixel = line + 1 * size_t(x);
+                auto pixel_1 = line_1 + 1 * size_t(x);
+                int64_t c;
 
-                int64_t xib = 0;
-                this->blend<SCALE_EMULT>(xi_,
-                                         xi_x, xi_y,
-                                         fc.kx[x], ky,
-                                         &xib);
-                *xi = uint8_t(xib);
+                this->lerp<SCALE_EMULT>(pixel[0], pixel_1[0], ky, &c);
+                *xi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
             }
 
             template <typename InputType>
-            inline void readUL1A(const FrameConvertParameters &fc,
-                                 const uint8_t *src_line_x,
-                                 const uint8_t *src_line_a,
-                                 const uint8_t *src_line_x_1,
-                                 const uint8_t *src_line_a_1,
+            inline void readUL1A(const int64_t *line,
+                                 const int64_t *line_1,
                                  int x,
                                  int64_t ky,
                                  InputType *xi,
                                  InputType *ai) const
             {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_a = fc.srcWidthOffsetA[x];
-
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-                int &xs_a_1 = fc.srcWidthOffsetA_1[x];
-
-                int64_t xai[2];
-                int64_t xai_x[2];
-                int64_t xai_y[2];
-
-                auto xai0 = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
-                auto xai1 = *reinterpret_cast<const InputType *>(src_line_a + xs_a);
-                auto xai_x0 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
-                auto xai_x1 = *reinterpret_cast<const InputType *>(src_line_a + xs_a_1);
-                auto xai_y0 = *reinterpret_cast<const InputType *>(src_line_x_1 + xs_x);
-                auto xai_y1 = *reinterpret_cast<const InputType *>(src_line_a_1 + xs_a);
-
-                if (fc.fromEndian != ENDIANNESS_BO) {
-                    xai0 = Algorithm::swapBytes(InputType(xai0));
-                    xai1 = Algorithm::swapBytes(InputType(xai1));
-                    xai_x0 = Algorithm::swapBytes(InputType(xai_x0));
-                    xai_x1 = Algorithm::swapBytes(InputType(xai_x1));
-                    xai_y0 = Algorithm::swapBytes(InputType(xai_y0));
-                    xai_y1 = Algorithm::swapBytes(InputType(xai_y1));
-                }
-
-                xai[0] = (xai0 >> fc.xiShift) & fc.maxXi;
-                xai[1] = (xai1 >> fc.aiShift) & fc.maxAi;
-                xai_x[0] = (xai_x0 >> fc.xiShift) & fc.maxXi;
-                xai_x[1] = (xai_x1 >> fc.aiShift) & fc.maxAi;
-                xai_y[0] = (xai_y0 >> fc.xiShift) & fc.maxXi;
-                xai_y[1] = (xai_y1 >> fc.aiShift) & fc.maxAi;
-
-                int64_t xaib[2];
-                this->blend2<SCALE_EMULT>(xai,
-                                          xai_x, xai_y,
-                                          fc.kx[x], ky,
-                                          xaib);
-
-                *xi = xaib[0];
-                *ai = xaib[1];
-            }
-
-            inline void readF8UL1A(const FrameConvertParameters &fc,
-                                   const uint8_t *src_line_x,
-                                   const uint8_t *src_line_a,
-                                   const uint8_t *src_line_x_1,
-                                   const uint8_t *src_line_a_1,
-                                   int x,
-                                   int64_t ky,
-                                   uint8_t *xi,
-                                   uint8_t *ai) const
-            {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_a = fc.srcWidthOffsetA[x];
+                auto pixel = line + 2 * size_t(x);
+                auto pixel_1 = line_1 + 2 * size_t(x);
+                int64_t c;
 
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-                int &xs_a_1 = fc.srcWidthOffsetA_1[x];
-
-                int64_t xai[] = {
-                    src_line_x[xs_x],
-                    src_line_a[xs_a]
-                };
-                int64_t xai_x[] = {
-                    src_line_x[xs_x_1],
-                    src_line_a[xs_a_1]
-                };
-                int64_t xai_y[] = {
-                    src_line_x_1[xs_x],
-                    src_line_a_1[xs_a]
-                };
-
-                int64_t xaib[2];
-                this->blend2<SCALE_EMULT>(xai,
-                                          xai_x, xai_y,
-                                          fc.kx[x], ky,
-                                          xaib);
-
-                *xi = uint8_t(xaib[0]);
-                *ai = uint8_t(xaib[1]);
+                this->lerp<SCALE_EMULT>(pixel[0], pixel_1[0], ky, &c);
+                *xi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+                this->lerp<SCALE_EMULT>(pixel[1], pixel_1[1], ky, &c);
+                *ai = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
             }
 
             template <typename InputType>
@@ -597,41 +1048,33 @@ namespace AkVCam
                 *ai = (ait >> fc.aiShift) & fc.maxAi;
             }
 
-            template <typename InputType>
+            template <typename InputType, typename SumType>
             inline void readDL3(const FrameConvertParameters &fc,
-                                const DlSumType *src_line_x,
-                                const DlSumType *src_line_y,
-                                const DlSumType *src_line_z,
-                                const DlSumType *src_line_x_1,
-                                const DlSumType *src_line_y_1,
-                                const DlSumType *src_line_z_1,
+                                const SumType *src_line_x,
+                                const SumType *src_line_y,
+                                const SumType *src_line_z,
                                 int x,
-                                const DlSumType *kdl,
+                                int y,
                                 InputType *xi,
                                 InputType *yi,
                                 InputType *zi) const
             {
                 auto &xs = fc.srcWidth[x];
                 auto &xs_1 = fc.srcWidth_1[x];
-                auto &k = kdl[x];
 
-                *xi = (src_line_x[xs] + src_line_x_1[xs_1] - src_line_x[xs_1] - src_line_x_1[xs]) / k;
-                *yi = (src_line_y[xs] + src_line_y_1[xs_1] - src_line_y[xs_1] - src_line_y_1[xs]) / k;
-                *zi = (src_line_z[xs] + src_line_z_1[xs_1] - src_line_z[xs_1] - src_line_z_1[xs]) / k;
+                *xi = InputType(this->averageDL(fc, SumType(src_line_x[xs_1] - src_line_x[xs]), x, y));
+                *yi = InputType(this->averageDL(fc, SumType(src_line_y[xs_1] - src_line_y[xs]), x, y));
+                *zi = InputType(this->averageDL(fc, SumType(src_line_z[xs_1] - src_line_z[xs]), x, y));
             }
 
-            template <typename InputType>
+            template <typename InputType, typename SumType>
             inline void readDL3A(const FrameConvertParameters &fc,
-                                 const DlSumType *src_line_x,
-                                 const DlSumType *src_line_y,
-                                 const DlSumType *src_line_z,
-                                 const DlSumType *src_line_a,
-                                 const DlSumType *src_line_x_1,
-                                 const DlSumType *src_line_y_1,
-                                 const DlSumType *src_line_z_1,
-                                 const DlSumType *src_line_a_1,
+                                 const SumType *src_line_x,
+                                 const SumType *src_line_y,
+                                 const SumType *src_line_z,
+                                 const SumType *src_line_a,
                                  int x,
-                                 const DlSumType *kdl,
+                                 int y,
                                  InputType *xi,
                                  InputType *yi,
                                  InputType *zi,
@@ -639,141 +1082,37 @@ namespace AkVCam
             {
                 auto &xs = fc.srcWidth[x];
                 auto &xs_1 = fc.srcWidth_1[x];
-                auto &k = kdl[x];
 
-                *xi = (src_line_x[xs] + src_line_x_1[xs_1] - src_line_x[xs_1] - src_line_x_1[xs]) / k;
-                *yi = (src_line_y[xs] + src_line_y_1[xs_1] - src_line_y[xs_1] - src_line_y_1[xs]) / k;
-                *zi = (src_line_z[xs] + src_line_z_1[xs_1] - src_line_z[xs_1] - src_line_z_1[xs]) / k;
-                *ai = (src_line_a[xs] + src_line_a_1[xs_1] - src_line_a[xs_1] - src_line_a_1[xs]) / k;
+                *xi = InputType(this->averageDL(fc, SumType(src_line_x[xs_1] - src_line_x[xs]), x, y));
+                *yi = InputType(this->averageDL(fc, SumType(src_line_y[xs_1] - src_line_y[xs]), x, y));
+                *zi = InputType(this->averageDL(fc, SumType(src_line_z[xs_1] - src_line_z[xs]), x, y));
+                *ai = InputType(this->averageDL(fc, SumType(src_line_a[xs_1] - src_line_a[xs]), x, y));
             }
 
             template <typename InputType>
-            inline void readUL3(const FrameConvertParameters &fc,
-                                const uint8_t *src_line_x,
-                                const uint8_t *src_line_y,
-                                const uint8_t *src_line_z,
-                                const uint8_t *src_line_x_1,
-                                const uint8_t *src_line_y_1,
-                                const uint8_t *src_line_z_1,
+            inline void readUL3(const int64_t *line,
+                                const int64_t *line_1,
                                 int x,
                                 int64_t ky,
                                 InputType *xi,
                                 InputType *yi,
                                 InputType *zi) const
             {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_y = fc.srcWidthOffsetY[x];
-                int &xs_z = fc.srcWidthOffsetZ[x];
-
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-                int &xs_y_1 = fc.srcWidthOffsetY_1[x];
-                int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
-
-                int64_t xyzi[3];
-                int64_t xyzi_x[3];
-                int64_t xyzi_y[3];
-
-                auto xyzi0 = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
-                auto xyzi1 = *reinterpret_cast<const InputType *>(src_line_y + xs_y);
-                auto xyzi2 = *reinterpret_cast<const InputType *>(src_line_z + xs_z);
-                auto xyzi_x0 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
-                auto xyzi_x1 = *reinterpret_cast<const InputType *>(src_line_y + xs_y_1);
-                auto xyzi_x2 = *reinterpret_cast<const InputType *>(src_line_z + xs_z_1);
-                auto xyzi_y0 = *reinterpret_cast<const InputType *>(src_line_x_1 + xs_x);
-                auto xyzi_y1 = *reinterpret_cast<const InputType *>(src_line_y_1 + xs_y);
-                auto xyzi_y2 = *reinterpret_cast<const InputType *>(src_line_z_1 + xs_z);
-
-                if (fc.fromEndian != ENDIANNESS_BO) {
-                    xyzi0 = Algorithm::swapBytes(InputType(xyzi0));
-                    xyzi1 = Algorithm::swapBytes(InputType(xyzi1));
-                    xyzi2 = Algorithm::swapBytes(InputType(xyzi2));
-                    xyzi_x0 = Algorithm::swapBytes(InputType(xyzi_x0));
-                    xyzi_x1 = Algorithm::swapBytes(InputType(xyzi_x1));
-                    xyzi_x2 = Algorithm::swapBytes(InputType(xyzi_x2));
-                    xyzi_y0 = Algorithm::swapBytes(InputType(xyzi_y0));
-                    xyzi_y1 = Algorithm::swapBytes(InputType(xyzi_y1));
-                    xyzi_y2 = Algorithm::swapBytes(InputType(xyzi_y2));
-                }
-
-                xyzi[0] = (xyzi0 >> fc.xiShift) & fc.maxXi;
-                xyzi[1] = (xyzi1 >> fc.yiShift) & fc.maxYi;
-                xyzi[2] = (xyzi2 >> fc.ziShift) & fc.maxZi;
-                xyzi_x[0] = (xyzi_x0 >> fc.xiShift) & fc.maxXi;
-                xyzi_x[1] = (xyzi_x1 >> fc.yiShift) & fc.maxYi;
-                xyzi_x[2] = (xyzi_x2 >> fc.ziShift) & fc.maxZi;
-                xyzi_y[0] = (xyzi_y0 >> fc.xiShift) & fc.maxXi;
-                xyzi_y[1] = (xyzi_y1 >> fc.yiShift) & fc.maxYi;
-                xyzi_y[2] = (xyzi_y2 >> fc.ziShift) & fc.maxZi;
-
-                int64_t xyzib[3];
-                this->blend3<SCALE_EMULT>(xyzi,
-                                          xyzi_x, xyzi_y,
-                                          fc.kx[x], ky,
-                                          xyzib);
-
-                *xi = xyzib[0];
-                *yi = xyzib[1];
-                *zi = xyzib[2];
-            }
-
-            inline void readF8UL3(const FrameConvertParameters &fc,
-                                  const uint8_t *src_line_x,
-                                  const uint8_t *src_line_y,
-                                  const uint8_t *src_line_z,
-                                  const uint8_t *src_line_x_1,
-                                  const uint8_t *src_line_y_1,
-                                  const uint8_t *src_line_z_1,
-                                  int x,
-                                  int64_t ky,
-                                  uint8_t *xi,
-                                  uint8_t *yi,
-                                  uint8_t *zi) const
-            {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_y = fc.srcWidthOffsetY[x];
-                int &xs_z = fc.srcWidthOffsetZ[x];
-
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-                int &xs_y_1 = fc.srcWidthOffsetY_1[x];
-                int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
-
-                int64_t xyzi[] = {
-                    src_line_x[xs_x],
-                    src_line_y[xs_y],
-                    src_line_z[xs_z]
-                };
-                int64_t xyzi_x[] = {
-                    src_line_x[xs_x_1],
-                    src_line_y[xs_y_1],
-                    src_line_z[xs_z_1]
-                };
-                int64_t xyzi_y[] = {
-                    src_line_x_1[xs_x],
-                    src_line_y_1[xs_y],
-                    src_line_z_1[xs_z]
-                };
+                auto pixel = line + 3 * size_t(x);
+                auto pixel_1 = line_1 + 3 * size_t(x);
+                int64_t c;
 
-                int64_t xyzib[3];
-                this->blend3<SCALE_EMULT>(xyzi,
-                                          xyzi_x, xyzi_y,
-                                          fc.kx[x], ky,
-                                          xyzib);
-
-                *xi = uint8_t(xyzib[0]);
-                *yi = uint8_t(xyzib[1]);
-                *zi = uint8_t(xyzib[2]);
+                this->lerp<SCALE_EMULT>(pixel[0], pixel_1[0], ky, &c);
+                *xi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+                this->lerp<SCALE_EMULT>(pixel[1], pixel_1[1], ky, &c);
+                *yi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+                this->lerp<SCALE_EMULT>(pixel[2], pixel_1[2], ky, &c);
+                *zi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
             }
 
             template <typename InputType>
-            inline void readUL3A(const FrameConvertParameters &fc,
-                                 const uint8_t *src_line_x,
-                                 const uint8_t *src_line_y,
-                                 const uint8_t *src_line_z,
-                                 const uint8_t *src_line_a,
-                                 const uint8_t *src_line_x_1,
-                                 const uint8_t *src_line_y_1,
-                                 const uint8_t *src_line_z_1,
-                                 const uint8_t *src_line_a_1,
+            inline void readUL3A(const int64_t *line,
+                                 const int64_t *line_1,
                                  int x,
                                  int64_t ky,
                                  InputType *xi,
@@ -781,132 +1120,41 @@ namespace AkVCam
                                  InputType *zi,
                                  InputType *ai) const
             {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_y = fc.srcWidthOffsetY[x];
-                int &xs_z = fc.srcWidthOffsetZ[x];
-                int &xs_a = fc.srcWidthOffsetA[x];
-
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-                int &xs_y_1 = fc.srcWidthOffsetY_1[x];
-                int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
-                int &xs_a_1 = fc.srcWidthOffsetA_1[x];
-
-                int64_t xyzai[4];
-                int64_t xyzai_x[4];
-                int64_t xyzai_y[4];
-
-                auto xyzai0 = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
-                auto xyzai1 = *reinterpret_cast<const InputType *>(src_line_y + xs_y);
-                auto xyzai2 = *reinterpret_cast<const InputType *>(src_line_z + xs_z);
-                auto xyzai3 = *reinterpret_cast<const InputType *>(src_line_a + xs_a);
-                auto xyzai_x0 = *reinterpret_cast<const InputType *>(src_line_x + xs_x_1);
-                auto xyzai_x1 = *reinterpret_cast<const InputType *>(src_line_y + xs_y_1);
-                auto xyzai_x2 = *reinterpret_cast<const InputType *>(src_line_z + xs_z_1);
-                auto xyzai_x3 = *reinterpret_cast<const InputType *>(src_line_a + xs_a_1);
-                auto xyzai_y0 = *reinterpret_cast<const InputType *>(src_line_x_1 + xs_x);
-                auto xyzai_y1 = *reinterpret_cast<const InputType *>(src_line_y_1 + xs_y);
-                auto xyzai_y2 = *reinterpret_cast<const InputType *>(src_line_z_1 + xs_z);
-                auto xyzai_y3 = *reinterpret_cast<const InputType *>(src_line_a_1 + xs_a);
-
-                if (fc.fromEndian != ENDIANNESS_BO) {
-                    xyzai0 = Algorithm::swapBytes(InputType(xyzai0));
-                    xyzai1 = Algorithm::swapBytes(InputType(xyzai1));
-                    xyzai2 = Algorithm::swapBytes(InputType(xyzai2));
-                    xyzai3 = Algorithm::swapBytes(InputType(xyzai3));
-                    xyzai_x0 = Algorithm::swapBytes(InputType(xyzai_x0));
-                    xyzai_x1 = Algorithm::swapBytes(InputType(xyzai_x1));
-                    xyzai_x2 = Algorithm::swapBytes(InputType(xyzai_x2));
-                    xyzai_x3 = Algorithm::swapBytes(InputType(xyzai_x3));
-                    xyzai_y0 = Algorithm::swapBytes(InputType(xyzai_y0));
-                    xyzai_y1 = Algorithm::swapBytes(InputType(xyzai_y1));
-                    xyzai_y2 = Algorithm::swapBytes(InputType(xyzai_y2));
-                    xyzai_y3 = Algorithm::swapBytes(InputType(xyzai_y3));
-                }
-
-                xyzai[0] = (xyzai0 >> fc.xiShift) & fc.maxXi;
-                xyzai[1] = (xyzai1 >> fc.yiShift) & fc.maxYi;
-                xyzai[2] = (xyzai2 >> fc.ziShift) & fc.maxZi;
-                xyzai[3] = (xyzai3 >> fc.aiShift) & fc.maxAi;
-                xyzai_x[0] = (xyzai_x0 >> fc.xiShift) & fc.maxXi;
-                xyzai_x[1] = (xyzai_x1 >> fc.yiShift) & fc.maxYi;
-                xyzai_x[2] = (xyzai_x2 >> fc.ziShift) & fc.maxZi;
-                xyzai_x[3] = (xyzai_x3 >> fc.aiShift) & fc.maxAi;
-                xyzai_y[0] = (xyzai_y0 >> fc.xiShift) & fc.maxXi;
-                xyzai_y[1] = (xyzai_y1 >> fc.yiShift) & fc.maxYi;
-                xyzai_y[2] = (xyzai_y2 >> fc.ziShift) & fc.maxZi;
-                xyzai_y[3] = (xyzai_y3 >> fc.aiShift) & fc.maxAi;
-
-                int64_t xyzaib[4];
-                this->blend4<SCALE_EMULT>(xyzai,
-                                          xyzai_x, xyzai_y,
-                                          fc.kx[x], ky,
-                                          xyzaib);
-
-                *xi = xyzaib[0];
-                *yi = xyzaib[1];
-                *zi = xyzaib[2];
-                *ai = xyzaib[3];
-            }
-
-            inline void readF8UL3A(const FrameConvertParameters &fc,
-                                   const uint8_t *src_line_x,
-                                   const uint8_t *src_line_y,
-                                   const uint8_t *src_line_z,
-                                   const uint8_t *src_line_a,
-                                   const uint8_t *src_line_x_1,
-                                   const uint8_t *src_line_y_1,
-                                   const uint8_t *src_line_z_1,
-                                   const uint8_t *src_line_a_1,
-                                   int x,
-                                   int64_t ky,
-                                   uint8_t *xi,
-                                   uint8_t *yi,
-                                   uint8_t *zi,
-                                   uint8_t *ai) const
-            {
-                int &xs_x = fc.srcWidthOffsetX[x];
-                int &xs_y = fc.srcWidthOffsetY[x];
-                int &xs_z = fc.srcWidthOffsetZ[x];
-                int &xs_a = fc.srcWidthOffsetA[x];
+                auto pixel = line + 4 * size_t(x);
+                auto pixel_1 = line_1 + 4 * size_t(x);
+                int64_t c;
 
-                int &xs_x_1 = fc.srcWidthOffsetX_1[x];
-                int &xs_y_1 = fc.srcWidthOffsetY_1[x];
-                int &xs_z_1 = fc.srcWidthOffsetZ_1[x];
-                int &xs_a_1 = fc.srcWidthOffsetA_1[x];
+                this->lerp<SCALE_EMULT>(pixel[0], pixel_1[0], ky, &c);
+                *xi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+                this->lerp<SCALE_EMULT>(pixel[1], pixel_1[1], ky, &c);
+                *yi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+                this->lerp<SCALE_EMULT>(pixel[2], pixel_1[2], ky, &c);
+                *zi = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+                this->lerp<SCALE_EMULT>(pixel[3], pixel_1[3], ky, &c);
+                *ai = InputType((c + SCALE_ROUND) >> (2 * SCALE_EMULT));
+            }
 
-                int64_t xyzai[] = {
-                    src_line_x[xs_x],
-                    src_line_y[xs_y],
-                    src_line_z[xs_z],
-                    src_line_a[xs_a]
-                };
-                int64_t xyzai_x[] = {
-                    src_line_x[xs_x_1],
-                    src_line_y[xs_y_1],
-                    src_line_z[xs_z_1],
-                    src_line_a[xs_a_1]
-                };
-                int64_t xyzai_y[] = {
-                    src_line_x_1[xs_x],
-                    src_line_y_1[xs_y],
-                    src_line_z_1[xs_z],
-                    src_line_a_1[xs_a]
-                };
+            /* Component writing functions
+             *
+             * The output words are stored in the output endianness, so the
+             * mask and the shifted component are swapped instead of the whole
+             * word, and no extra pass over the frame is needed.
+             */
 
-                int64_t xyzaib[4];
-                this->blend4<SCALE_EMULT>(xyzai,
-                                          xyzai_x, xyzai_y,
-                                          fc.kx[x], ky,
-                                          xyzaib);
+            template <typename OutputType>
+            inline void writeComponent(const FrameConvertParameters &fc,
+                                       OutputType *dst,
+                                       OutputType mask,
+                                       OutputType value) const
+            {
+                if (fc.toEndian != ENDIANNESS_BO) {
+                    mask = Algorithm::swapBytes(mask);
+                    value = Algorithm::swapBytes(value);
+                }
 
-                *xi = uint8_t(xyzaib[0]);
-                *yi = uint8_t(xyzaib[1]);
-                *zi = uint8_t(xyzaib[2]);
-                *ai = uint8_t(xyzaib[3]);
+                *dst = (*dst & mask) | value;
             }
 
-            /* Component writing functions */
-
             template <typename OutputType>
             inline void write1(const FrameConvertParameters &fc,
                                uint8_t *dst_line_x,
@@ -915,7 +1163,7 @@ namespace AkVCam
             {
                 int &xd_x = fc.dstWidthOffsetX[x];
                 auto xo_ = reinterpret_cast<OutputType *>(dst_line_x + xd_x);
-                *xo_ = (*xo_ & OutputType(fc.maskXo)) | (OutputType(xo) << fc.xoShift);
+                this->writeComponent(fc, xo_, OutputType(fc.maskXo), OutputType(xo << fc.xoShift));
             }
 
             template <typename OutputType>
@@ -932,8 +1180,8 @@ namespace AkVCam
                 auto xo_ = reinterpret_cast<OutputType *>(dst_line_x + xd_x);
                 auto ao_ = reinterpret_cast<OutputType *>(dst_line_a + xd_a);
 
-                *xo_ = (*xo_ & OutputType(fc.maskXo)) | (OutputType(xo) << fc.xoShift);
-                *ao_ = (*ao_ & OutputType(fc.maskAo)) | (OutputType(ao) << fc.aoShift);
+                this->writeComponent(fc, xo_, OutputType(fc.maskXo), OutputType(xo << fc.xoShift));
+                this->writeComponent(fc, ao_, OutputType(fc.maskAo), OutputType(ao << fc.aoShift));
             }
 
             template <typename OutputType>
@@ -949,8 +1197,8 @@ namespace AkVCam
                 auto xo_ = reinterpret_cast<OutputType *>(dst_line_x + xd_x);
                 auto ao_ = reinterpret_cast<OutputType *>(dst_line_a + xd_a);
 
-                *xo_ = (*xo_ & OutputType(fc.maskXo)) | (OutputType(xo) << fc.xoShift);
-                *ao_ = *ao_ | OutputType(fc.alphaMask);
+                this->writeComponent(fc, xo_, OutputType(fc.maskXo), OutputType(xo << fc.xoShift));
+                this->writeComponent(fc, ao_, OutputType(~OutputType(0)), OutputType(fc.alphaMask));
             }
 
             template <typename OutputType>
@@ -971,9 +1219,9 @@ namespace AkVCam
                 auto yo_ = reinterpret_cast<OutputType *>(dst_line_y + xd_y);
                 auto zo_ = reinterpret_cast<OutputType *>(dst_line_z + xd_z);
 
-                *xo_ = (*xo_ & OutputType(fc.maskXo)) | (OutputType(xo) << fc.xoShift);
-                *yo_ = (*yo_ & OutputType(fc.maskYo)) | (OutputType(yo) << fc.yoShift);
-                *zo_ = (*zo_ & OutputType(fc.maskZo)) | (OutputType(zo) << fc.zoShift);
+                this->writeComponent(fc, xo_, OutputType(fc.maskXo), OutputType(xo << fc.xoShift));
+                this->writeComponent(fc, yo_, OutputType(fc.maskYo), OutputType(yo << fc.yoShift));
+                this->writeComponent(fc, zo_, OutputType(fc.maskZo), OutputType(zo << fc.zoShift));
             }
 
             template <typename OutputType>
@@ -998,10 +1246,10 @@ namespace AkVCam
                 auto zo_ = reinterpret_cast<OutputType *>(dst_line_z + xd_z);
                 auto ao_ = reinterpret_cast<OutputType *>(dst_line_a + xd_a);
 
-                *xo_ = (*xo_ & OutputType(fc.maskXo)) | (OutputType(xo) << fc.xoShift);
-                *yo_ = (*yo_ & OutputType(fc.maskYo)) | (OutputType(yo) << fc.yoShift);
-                *zo_ = (*zo_ & OutputType(fc.maskZo)) | (OutputType(zo) << fc.zoShift);
-                *ao_ = (*ao_ & OutputType(fc.maskAo)) | (OutputType(ao) << fc.aoShift);
+                this->writeComponent(fc, xo_, OutputType(fc.maskXo), OutputType(xo << fc.xoShift));
+                this->writeComponent(fc, yo_, OutputType(fc.maskYo), OutputType(yo << fc.yoShift));
+                this->writeComponent(fc, zo_, OutputType(fc.maskZo), OutputType(zo << fc.zoShift));
+                this->writeComponent(fc, ao_, OutputType(fc.maskAo), OutputType(ao << fc.aoShift));
             }
 
             template <typename OutputType>
@@ -1025,27 +1273,35 @@ namespace AkVCam
                 auto zo_ = reinterpret_cast<OutputType *>(dst_line_z + xd_z);
                 auto ao_ = reinterpret_cast<OutputType *>(dst_line_a + xd_a);
 
-                *xo_ = (*xo_ & OutputType(fc.maskXo)) | (OutputType(xo) << fc.xoShift);
-                *yo_ = (*yo_ & OutputType(fc.maskYo)) | (OutputType(yo) << fc.yoShift);
-                *zo_ = (*zo_ & OutputType(fc.maskZo)) | (OutputType(zo) << fc.zoShift);
-                *ao_ = *ao_ | OutputType(fc.alphaMask);
+                this->writeComponent(fc, xo_, OutputType(fc.maskXo), OutputType(xo << fc.xoShift));
+                this->writeComponent(fc, yo_, OutputType(fc.maskYo), OutputType(yo << fc.yoShift));
+                this->writeComponent(fc, zo_, OutputType(fc.maskZo), OutputType(zo << fc.zoShift));
+                this->writeComponent(fc, ao_, OutputType(~OutputType(0)), OutputType(fc.alphaMask));
             }
 
-            /* Integral image functions */
+            /* Integral line functions
+             *
+             * Sum the columns of the input lines covered by the output line
+             * y, and integrate them horizontally, so the sum of any box of the
+             * output line can be read with a single subtraction. Only one
+             * line per component is kept in memory.
+             */
 
-            template <typename InputType>
-            inline void integralImage1(const FrameConvertParameters &fc,
-                                       const VideoFrame &src) const
+            template <typename InputType, typename SumType>
+            inline void integralLine1(const FrameConvertParameters &fc,
+                                      const VideoFrame &src,
+                                      int y,
+                                      SumType *dst_line_x) const
             {
-                auto dst_line_x = fc.integralImageDataX;
-                auto dst_line_x_1 = dst_line_x + fc.inputWidth_1;
+                auto &ys = fc.srcHeight[y];
+                int ys_1 = fc.srcHeight_1[y] - 1;
 
-                for (int y = 0; y < fc.inputHeight; ++y) {
-                    auto src_line_x = src.constLine(fc.planeXi, y) + fc.xiOffset;
+                std::fill_n(dst_line_x, fc.inputWidth_1, SumType(0));
 
-                    // Reset current line summation.
+                // Accumulate the columns of all lines but the last one.
 
-                    DlSumType sumX = 0;
+                for (int line = ys; line < ys_1; ++line) {
+                    auto src_line_x = src.constLine(fc.planeXi, line) + fc.xiOffset;
 
                     for (int x = 0; x < fc.inputWidth; ++x) {
                         int &xs_x = fc.dlSrcWidthOffsetX[x];
@@ -1054,38 +1310,48 @@ namespace AkVCam
                         if (fc.fromEndian != ENDIANNESS_BO)
                             xi = Algorithm::swapBytes(InputType(xi));
 
-                        // Accumulate pixels in current line.
+                        int x_1 = x + 1;
+                        dst_line_x[x_1] += (xi >> fc.xiShift) & fc.maxXi;
+                    }
+                }
+
+                // Add the last line and integrate the columns.
 
-                        sumX += (xi >> fc.xiShift) & fc.maxXi;
+                auto src_line_x = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
 
-                        // Accumulate current line and previous line.
+                SumType sumX = 0;
 
-                        int x_1 = x + 1;
-                        dst_line_x_1[x_1] = sumX + dst_line_x[x_1];
-                    }
+                for (int x = 0; x < fc.inputWidth; ++x) {
+                    int &xs_x = fc.dlSrcWidthOffsetX[x];
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+
+                    if (fc.fromEndian != ENDIANNESS_BO)
+                        xi = Algorithm::swapBytes(InputType(xi));
 
-                    dst_line_x += fc.inputWidth_1;
-                    dst_line_x_1 += fc.inputWidth_1;
+                    int x_1 = x + 1;
+                    sumX += dst_line_x[x_1] + ((xi >> fc.xiShift) & fc.maxXi);
+                    dst_line_x[x_1] = sumX;
                 }
             }
 
-            template <typename InputType>
-            inline void integralImage1A(const FrameConvertParameters &fc,
-                                        const VideoFrame &src) const
+            template <typename InputType, typename SumType>
+            inline void integralLine1A(const FrameConvertParameters &fc,
+                                       const VideoFrame &src,
+                                       int y,
+                                       SumType *dst_line_x,
+                                       SumType *dst_line_a) const
             {
-                auto dst_line_x = fc.integralImageDataX;
-                auto dst_line_a = fc.integralImageDataA;
-                auto dst_line_x_1 = dst_line_x + fc.inputWidth_1;
-                auto dst_line_a_1 = dst_line_a + fc.inputWidth_1;
+                auto &ys = fc.srcHeight[y];
+                int ys_1 = fc.srcHeight_1[y] - 1;
 
-                for (int y = 0; y < fc.inputHeight; ++y) {
-                    auto src_line_x = src.constLine(fc.planeXi, y) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, y) + fc.aiOffset;
+                std::fill_n(dst_line_x, fc.inputWidth_1, SumType(0));
+                std::fill_n(dst_line_a, fc.inputWidth_1, SumType(0));
 
-                    // Reset current line summation.
+                // Accumulate the columns of all lines but the last one.
 
-                    DlSumType sumX = 0;
-                    DlSumType sumA = 0;
+                for (int line = ys; line < ys_1; ++line) {
+                    auto src_line_x = src.constLine(fc.planeXi, line) + fc.xiOffset;
+                    auto src_line_a = src.constLine(fc.planeAi, line) + fc.aiOffset;
 
                     for (int x = 0; x < fc.inputWidth; ++x) {
                         int &xs_x = fc.dlSrcWidthOffsetX[x];
@@ -1099,46 +1365,61 @@ namespace AkVCam
                             ai = Algorithm::swapBytes(InputType(ai));
                         }
 
-                        // Accumulate pixels in current line.
+                        int x_1 = x + 1;
+                        dst_line_x[x_1] += (xi >> fc.xiShift) & fc.maxXi;
+                        dst_line_a[x_1] += (ai >> fc.aiShift) & fc.maxAi;
+                    }
+                }
+
+                // Add the last line and integrate the columns.
 
-                        sumX += (xi >> fc.xiShift) & fc.maxXi;
-                        sumA += (ai >> fc.aiShift) & fc.maxAi;
+                auto src_line_x = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                auto src_line_a = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
 
-                        // Accumulate current line and previous line.
+                SumType sumX = 0;
+                SumType sumA = 0;
 
-                        int x_1 = x + 1;
-                        dst_line_x_1[x_1] = sumX + dst_line_x[x_1];
-                        dst_line_a_1[x_1] = sumA + dst_line_a[x_1];
+                for (int x = 0; x < fc.inputWidth; ++x) {
+                    int &xs_x = fc.dlSrcWidthOffsetX[x];
+                    int &xs_a = fc.dlSrcWidthOffsetA[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto ai = *reinterpret_cast<const InputType *>(src_line_a + xs_a);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        ai = Algorithm::swapBytes(InputType(ai));
                     }
 
-                    dst_line_x += fc.inputWidth_1;
-                    dst_line_a += fc.inputWidth_1;
-                    dst_line_x_1 += fc.inputWidth_1;
-                    dst_line_a_1 += fc.inputWidth_1;
+                    int x_1 = x + 1;
+                    sumX += dst_line_x[x_1] + ((xi >> fc.xiShift) & fc.maxXi);
+                    sumA += dst_line_a[x_1] + ((ai >> fc.aiShift) & fc.maxAi);
+                    dst_line_x[x_1] = sumX;
+                    dst_line_a[x_1] = sumA;
                 }
             }
 
-            template <typename InputType>
-            inline void integralImage3(const FrameConvertParameters &fc,
-                                       const VideoFrame &src) const
+            template <typename InputType, typename SumType>
+            inline void integralLine3(const FrameConvertParameters &fc,
+                                      const VideoFrame &src,
+                                      int y,
+                                      SumType *dst_line_x,
+                                      SumType *dst_line_y,
+                                      SumType *dst_line_z) const
             {
-                auto dst_line_x = fc.integralImageDataX;
-                auto dst_line_y = fc.integralImageDataY;
-                auto dst_line_z = fc.integralImageDataZ;
-                auto dst_line_x_1 = dst_line_x + fc.inputWidth_1;
-                auto dst_line_y_1 = dst_line_y + fc.inputWidth_1;
-                auto dst_line_z_1 = dst_line_z + fc.inputWidth_1;
+                auto &ys = fc.srcHeight[y];
+                int ys_1 = fc.srcHeight_1[y] - 1;
 
-                for (int y = 0; y < fc.inputHeight; ++y) {
-                    auto src_line_x = src.constLine(fc.planeXi, y) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, y) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, y) + fc.ziOffset;
+                std::fill_n(dst_line_x, fc.inputWidth_1, SumType(0));
+                std::fill_n(dst_line_y, fc.inputWidth_1, SumType(0));
+                std::fill_n(dst_line_z, fc.inputWidth_1, SumType(0));
 
-                    // Reset current line summation.
+                // Accumulate the columns of all lines but the last one.
 
-                    DlSumType sumX = 0;
-                    DlSumType sumY = 0;
-                    DlSumType sumZ = 0;
+                for (int line = ys; line < ys_1; ++line) {
+                    auto src_line_x = src.constLine(fc.planeXi, line) + fc.xiOffset;
+                    auto src_line_y = src.constLine(fc.planeYi, line) + fc.yiOffset;
+                    auto src_line_z = src.constLine(fc.planeZi, line) + fc.ziOffset;
 
                     for (int x = 0; x < fc.inputWidth; ++x) {
                         int &xs_x = fc.dlSrcWidthOffsetX[x];
@@ -1155,54 +1436,72 @@ namespace AkVCam
                             zi = Algorithm::swapBytes(InputType(zi));
                         }
 
-                        // Accumulate pixels in current line.
+                        int x_1 = x + 1;
+                        dst_line_x[x_1] += (xi >> fc.xiShift) & fc.maxXi;
+                        dst_line_y[x_1] += (yi >> fc.yiShift) & fc.maxYi;
+                        dst_line_z[x_1] += (zi >> fc.ziShift) & fc.maxZi;
+                    }
+                }
+
+                // Add the last line and integrate the columns.
 
-                        sumX += (xi >> fc.xiShift) & fc.maxXi;
-                        sumY += (yi >> fc.yiShift) & fc.maxYi;
-                        sumZ += (zi >> fc.ziShift) & fc.maxZi;
+                auto src_line_x = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                auto src_line_y = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
+                auto src_line_z = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
 
-                        // Accumulate current line and previous line.
+                SumType sumX = 0;
+                SumType sumY = 0;
+                SumType sumZ = 0;
 
-                        int x_1 = x + 1;
-                        dst_line_x_1[x_1] = sumX + dst_line_x[x_1];
-                        dst_line_y_1[x_1] = sumY + dst_line_y[x_1];
-                        dst_line_z_1[x_1] = sumZ + dst_line_z[x_1];
+                for (int x = 0; x < fc.inputWidth; ++x) {
+                    int &xs_x = fc.dlSrcWidthOffsetX[x];
+                    int &xs_y = fc.dlSrcWidthOffsetY[x];
+                    int &xs_z = fc.dlSrcWidthOffsetZ[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto yi = *reinterpret_cast<const InputType *>(src_line_y + xs_y);
+                    auto zi = *reinterpret_cast<const InputType *>(src_line_z + xs_z);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        yi = Algorithm::swapBytes(InputType(yi));
+                        zi = Algorithm::swapBytes(InputType(zi));
                     }
 
-                    dst_line_x += fc.inputWidth_1;
-                    dst_line_y += fc.inputWidth_1;
-                    dst_line_z += fc.inputWidth_1;
-                    dst_line_x_1 += fc.inputWidth_1;
-                    dst_line_y_1 += fc.inputWidth_1;
-                    dst_line_z_1 += fc.inputWidth_1;
+                    int x_1 = x + 1;
+                    sumX += dst_line_x[x_1] + ((xi >> fc.xiShift) & fc.maxXi);
+                    sumY += dst_line_y[x_1] + ((yi >> fc.yiShift) & fc.maxYi);
+                    sumZ += dst_line_z[x_1] + ((zi >> fc.ziShift) & fc.maxZi);
+                    dst_line_x[x_1] = sumX;
+                    dst_line_y[x_1] = sumY;
+                    dst_line_z[x_1] = sumZ;
                 }
             }
 
-            template <typename InputType>
-            inline void integralImage3A(const FrameConvertParameters &fc,
-                                        const VideoFrame &src) const
-            {
-                auto dst_line_x = fc.integralImageDataX;
-                auto dst_line_y = fc.integralImageDataY;
-                auto dst_line_z = fc.integralImageDataZ;
-                auto dst_line_a = fc.integralImageDataA;
-                auto dst_line_x_1 = dst_line_x + fc.inputWidth_1;
-                auto dst_line_y_1 = dst_line_y + fc.inputWidth_1;
-                auto dst_line_z_1 = dst_line_z + fc.inputWidth_1;
-                auto dst_line_a_1 = dst_line_a + fc.inputWidth_1;
-
-                for (int y = 0; y < fc.inputHeight; ++y) {
-                    auto src_line_x = src.constLine(fc.planeXi, y) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, y) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, y) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, y) + fc.aiOffset;
-
-                    // Reset current line summation.
-
-                    DlSumType sumX = 0;
-                    DlSumType sumY = 0;
-                    DlSumType sumZ = 0;
-                    DlSumType sumA = 0;
+            template <typename InputType, typename SumType>
+            inline void integralLine3A(const FrameConvertParameters &fc,
+                                       const VideoFrame &src,
+                                       int y,
+                                       SumType *dst_line_x,
+                                       SumType *dst_line_y,
+                                       SumType *dst_line_z,
+                                       SumType *dst_line_a) const
+            {
+                auto &ys = fc.srcHeight[y];
+                int ys_1 = fc.srcHeight_1[y] - 1;
+
+                std::fill_n(dst_line_x, fc.inputWidth_1, SumType(0));
+                std::fill_n(dst_line_y, fc.inputWidth_1, SumType(0));
+                std::fill_n(dst_line_z, fc.inputWidth_1, SumType(0));
+                std::fill_n(dst_line_a, fc.inputWidth_1, SumType(0));
+
+                // Accumulate the columns of all lines but the last one.
+
+                for (int line = ys; line < ys_1; ++line) {
+                    auto src_line_x = src.constLine(fc.planeXi, line) + fc.xiOffset;
+                    auto src_line_y = src.constLine(fc.planeYi, line) + fc.yiOffset;
+                    auto src_line_z = src.constLine(fc.planeZi, line) + fc.ziOffset;
+                    auto src_line_a = src.constLine(fc.planeAi, line) + fc.aiOffset;
 
                     for (int x = 0; x < fc.inputWidth; ++x) {
                         int &xs_x = fc.dlSrcWidthOffsetX[x];
@@ -1222,31 +1521,531 @@ namespace AkVCam
                             ai = Algorithm::swapBytes(InputType(ai));
                         }
 
-                        // Accumulate pixels in current line.
-
-                        sumX += (xi >> fc.xiShift) & fc.maxXi;
-                        sumY += (yi >> fc.yiShift) & fc.maxYi;
-                        sumZ += (zi >> fc.ziShift) & fc.maxZi;
-                        sumA += (ai >> fc.aiShift) & fc.maxAi;
-
-                        // Accumulate current line and previous line.
-
                         int x_1 = x + 1;
-                        dst_line_x_1[x_1] = sumX + dst_line_x[x_1];
-                        dst_line_y_1[x_1] = sumY + dst_line_y[x_1];
-                        dst_line_z_1[x_1] = sumZ + dst_line_z[x_1];
-                        dst_line_a_1[x_1] = sumA + dst_line_a[x_1];
+                        dst_line_x[x_1] += (xi >> fc.xiShift) & fc.maxXi;
+                        dst_line_y[x_1] += (yi >> fc.yiShift) & fc.maxYi;
+                        dst_line_z[x_1] += (zi >> fc.ziShift) & fc.maxZi;
+                        dst_line_a[x_1] += (ai >> fc.aiShift) & fc.maxAi;
                     }
-
-                    dst_line_x += fc.inputWidth_1;
-                    dst_line_y += fc.inputWidth_1;
-                    dst_line_z += fc.inputWidth_1;
-                    dst_line_a += fc.inputWidth_1;
-                    dst_line_x_1 += fc.inputWidth_1;
-                    dst_line_y_1 += fc.inputWidth_1;
-                    dst_line_z_1 += fc.inputWidth_1;
-                    dst_line_a_1 += fc.inputWidth_1;
                 }
+
+                // Add the last line and integrate the columns.
+
+                auto src_line_x = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                auto src_line_y = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
+                auto src_line_z = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                auto src_line_a = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+
+                SumType sumX = 0;
+                SumType sumY = 0;
+                SumType sumZ = 0;
+                SumType sumA = 0;
+
+                for (int x = 0; x < fc.inputWidth; ++x) {
+                    int &xs_x = fc.dlSrcWidthOffsetX[x];
+                    int &xs_y = fc.dlSrcWidthOffsetY[x];
+                    int &xs_z = fc.dlSrcWidthOffsetZ[x];
+                    int &xs_a = fc.dlSrcWidthOffsetA[x];
+
+                    auto xi = *reinterpret_cast<const InputType *>(src_line_x + xs_x);
+                    auto yi = *reinterpret_cast<const InputType *>(src_line_y + xs_y);
+                    auto zi = *reinterpret_cast<const InputType *>(src_line_z + xs_z);
+                    auto ai = *reinterpret_cast<const InputType *>(src_line_a + xs_a);
+
+                    if (fc.fromEndian != ENDIANNESS_BO) {
+                        xi = Algorithm::swapBytes(InputType(xi));
+                        yi = Algorithm::swapBytes(InputType(yi));
+                        zi = Algorithm::swapBytes(InputType(zi));
+                        ai = Algorithm::swapBytes(InputType(ai));
+                    }
+
+                    int x_1 = x + 1;
+                    sumX += dst_line_x[x_1] + ((xi >> fc.xiShift) & fc.maxXi);
+                    sumY += dst_line_y[x_1] + ((yi >> fc.yiShift) & fc.maxYi);
+                    sumZ += dst_line_z[x_1] + ((zi >> fc.ziShift) & fc.maxZi);
+                    sumA += dst_line_a[x_1] + ((ai >> fc.aiShift) & fc.maxAi);
+                    dst_line_x[x_1] = sumX;
+                    dst_line_y[x_1] = sumY;
+                    dst_line_z[x_1] = sumZ;
+                    dst_line_a[x_1] = sumA;
+                }
+            }
+
+            /* Vectorized conversion functions
+             *
+             * The components of a line are gathered in tiles of planar
+             * buffers, converted by the vector units, and then scattered back
+             * to the destination line. These functions returns the first
+             * pixel that was not converted.
+             */
+
+            inline void convertFast8bitsSimdAlpha(const FrameConvertParameters &fc,
+                                                  const uint8_t *src_line_a,
+                                                  uint8_t *dst_line_a,
+                                                  int xmin,
+                                                  int xmax) const
+            {
+                if (!dst_line_a)
+                    return;
+
+                if (src_line_a) {
+                    for (int x = xmin; x < xmax; ++x)
+                        dst_line_a[fc.dstWidthOffsetA[x]] =
+                                src_line_a[fc.srcWidthOffsetA[x]];
+                } else {
+                    for (int x = xmin; x < xmax; ++x)
+                        dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
+                }
+            }
+
+            inline int convertFast8bitsSimd3to3(const FrameConvertParameters &fc,
+                                                const uint8_t *src_line_x,
+                                                const uint8_t *src_line_y,
+                                                const uint8_t *src_line_z,
+                                                const uint8_t *src_line_a,
+                                                uint8_t *dst_line_x,
+                                                uint8_t *dst_line_y,
+                                                uint8_t *dst_line_z,
+                                                uint8_t *dst_line_a) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t yi[SIMD_TILE_SIZE];
+                uint8_t zi[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+                uint8_t yo[SIMD_TILE_SIZE];
+                uint8_t zo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto srcWidthOffsetY = fc.srcWidthOffsetY + x;
+                    auto srcWidthOffsetZ = fc.srcWidthOffsetZ + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+                    auto dstWidthOffsetY = fc.dstWidthOffsetY + x;
+                    auto dstWidthOffsetZ = fc.dstWidthOffsetZ + x;
+
+                    for (int i = 0; i < width; ++i) {
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+                        yi[i] = src_line_y[srcWidthOffsetY[i]];
+                        zi[i] = src_line_z[srcWidthOffsetZ[i]];
+                    }
+
+                    Simd::matrix3to3(fc.simdColorMatrix,
+                                     xi, yi, zi,
+                                     xo, yo, zo,
+                                     width);
+
+                    for (int i = 0; i < width; ++i) {
+                        dst_line_x[dstWidthOffsetX[i]] = xo[i];
+                        dst_line_y[dstWidthOffsetY[i]] = yo[i];
+                        dst_line_z[dstWidthOffsetZ[i]] = zo[i];
+                    }
+                }
+
+                this->convertFast8bitsSimdAlpha(fc,
+                                                src_line_a,
+                                                dst_line_a,
+                                                fc.xmin,
+                                                fc.xmax);
+
+                return fc.xmax;
+            }
+
+            inline int convertFast8bitsSimd3to1(const FrameConvertParameters &fc,
+                                                const uint8_t *src_line_x,
+                                                const uint8_t *src_line_y,
+                                                const uint8_t *src_line_z,
+                                                const uint8_t *src_line_a,
+                                                uint8_t *dst_line_x,
+                                                uint8_t *dst_line_a) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t yi[SIMD_TILE_SIZE];
+                uint8_t zi[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto srcWidthOffsetY = fc.srcWidthOffsetY + x;
+                    auto srcWidthOffsetZ = fc.srcWidthOffsetZ + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+
+                    for (int i = 0; i < width; ++i) {
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+                        yi[i] = src_line_y[srcWidthOffsetY[i]];
+                        zi[i] = src_line_z[srcWidthOffsetZ[i]];
+                    }
+
+                    Simd::matrix3to1(fc.simdColorMatrix,
+                                     xi, yi, zi,
+                                     xo,
+                                     width);
+
+                    for (int i = 0; i < width; ++i)
+                        dst_line_x[dstWidthOffsetX[i]] = xo[i];
+                }
+
+                this->convertFast8bitsSimdAlpha(fc,
+                                                src_line_a,
+                                                dst_line_a,
+                                                fc.xmin,
+                                                fc.xmax);
+
+                return fc.xmax;
+            }
+
+            /* Converts the same lines of the input frame to several outputs
+             * with the same geometry.
+             *
+             * The input components are gathered in the tiles only once, and
+             * then each output applies its own color matrix to the tiles,
+             * or copies them if it has the same type of the input. All the
+             * outputs must use the 3 to 3 or 3 to 1 vectorized conversion,
+             * or the vector copy.
+             */
+            inline void convertFast8bitsSimdShared(const std::vector<const FrameConvertTarget *> &targets,
+                                                   const VideoFrame &src,
+                                                   int ymin,
+                                                   int ymax) const
+            {
+                auto &fci = *targets.front()->fc;
+                bool hasAlpha = fci.alphaMode == ConvertAlphaMode_AI_AO;
+
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t yi[SIMD_TILE_SIZE];
+                uint8_t zi[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+                uint8_t yo[SIMD_TILE_SIZE];
+                uint8_t zo[SIMD_TILE_SIZE];
+
+                struct DstLines
+                {
+                    uint8_t *x;
+                    uint8_t *y;
+                    uint8_t *z;
+                    uint8_t *a;
+                };
+
+                std::vector<DstLines> dstLines(targets.size());
+
+                for (int y = ymin; y < ymax; ++y) {
+                    auto &ys = fci.srcHeight[y];
+                    auto src_line_x = src.constLine(fci.planeXi, ys) + fci.xiOffset;
+                    auto src_line_y = src.constLine(fci.planeYi, ys) + fci.yiOffset;
+                    auto src_line_z = src.constLine(fci.planeZi, ys) + fci.ziOffset;
+                    auto src_line_a =
+                            hasAlpha?
+                                src.constLine(fci.planeAi, ys) + fci.aiOffset:
+                                nullptr;
+
+                    for (size_t t = 0; t < targets.size(); ++t) {
+                        auto &fc = *targets[t]->fc;
+                        auto &dst = *targets[t]->dst;
+                        auto &lines = dstLines[t];
+                        lines.x = dst.line(fc.planeXo, y) + fc.xoOffset;
+                        lines.y = nullptr;
+                        lines.z = nullptr;
+                        lines.a = nullptr;
+
+                        if (fc.convertType != ConvertType_3to1) {
+                            lines.y = dst.line(fc.planeYo, y) + fc.yoOffset;
+                            lines.z = dst.line(fc.planeZo, y) + fc.zoOffset;
+                        }
+
+                        if (fc.alphaMode == ConvertAlphaMode_AI_AO
+                            || fc.alphaMode == ConvertAlphaMode_I_AO)
+                            lines.a = dst.line(fc.planeAo, y) + fc.aoOffset;
+                    }
+
+                    for (int x = fci.xmin; x < fci.xmax; x += SIMD_TILE_SIZE) {
+                        int width = std::min(fci.xmax - x, SIMD_TILE_SIZE);
+                        auto srcWidthOffsetX = fci.srcWidthOffsetX + x;
+                        auto srcWidthOffsetY = fci.srcWidthOffsetY + x;
+                        auto srcWidthOffsetZ = fci.srcWidthOffsetZ + x;
+
+                        for (int i = 0; i < width; ++i) {
+                            xi[i] = src_line_x[srcWidthOffsetX[i]];
+                            yi[i] = src_line_y[srcWidthOffsetY[i]];
+                            zi[i] = src_line_z[srcWidthOffsetZ[i]];
+                        }
+
+                        for (size_t t = 0; t < targets.size(); ++t) {
+                            auto &fc = *targets[t]->fc;
+                            auto &lines = dstLines[t];
+                            auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+
+                            if (fc.convertType == ConvertType_Vector) {
+                                auto dstWidthOffsetY = fc.dstWidthOffsetY + x;
+                                auto dstWidthOffsetZ = fc.dstWidthOffsetZ + x;
+
+                                for (int i = 0; i < width; ++i) {
+                                    lines.x[dstWidthOffsetX[i]] = xi[i];
+                                    lines.y[dstWidthOffsetY[i]] = yi[i];
+                                    lines.z[dstWidthOffsetZ[i]] = zi[i];
+                                }
+                            } else if (fc.convertType == ConvertType_3to3) {
+                                auto dstWidthOffsetY = fc.dstWidthOffsetY + x;
+                                auto dstWidthOffsetZ = fc.dstWidthOffsetZ + x;
+
+                                Simd::matrix3to3(fc.simdColorMatrix,
+                                                 xi, yi, zi,
+                                                 xo, yo, zo,
+                                                 width);
+
+                                for (int i = 0; i < width; ++i) {
+                                    lines.x[dstWidthOffsetX[i]] = xo[i];
+                                    lines.y[dstWidthOffsetY[i]] = yo[i];
+                                    lines.z[dstWidthOffsetZ[i]] = zo[i];
+                                }
+                            } else {
+                                Simd::matrix3to1(fc.simdColorMatrix,
+                                                 xi, yi, zi,
+                                                 xo,
+                                                 width);
+
+                                for (int i = 0; i < width; ++i)
+                                    lines.x[dstWidthOffsetX[i]] = xo[i];
+                            }
+                        }
+                    }
+
+                    for (size_t t = 0; t < targets.size(); ++t)
+                        this->convertFast8bitsSimdAlpha(*targets[t]->fc,
+                                                        src_line_a,
+                                                        dstLines[t].a,
+                                                        fci.xmin,
+                                                        fci.xmax);
+                }
+            }
+
+            inline int convertFast8bitsSimd1to3(const FrameConvertParameters &fc,
+                                                const uint8_t *src_line_x,
+                                                const uint8_t *src_line_a,
+                                                uint8_t *dst_line_x,
+                                                uint8_t *dst_line_y,
+                                                uint8_t *dst_line_z,
+                                                uint8_t *dst_line_a) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+                uint8_t yo[SIMD_TILE_SIZE];
+                uint8_t zo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+                    auto dstWidthOffsetY = fc.dstWidthOffsetY + x;
+                    auto dstWidthOffsetZ = fc.dstWidthOffsetZ + x;
+
+                    for (int i = 0; i < width; ++i)
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+
+                    Simd::point1to3(fc.simdColorMatrix,
+                                    xi,
+                                    xo, yo, zo,
+                                    width);
+
+                    for (int i = 0; i < width; ++i) {
+                        dst_line_x[dstWidthOffsetX[i]] = xo[i];
+                        dst_line_y[dstWidthOffsetY[i]] = yo[i];
+                        dst_line_z[dstWidthOffsetZ[i]] = zo[i];
+                    }
+                }
+
+                this->convertFast8bitsSimdAlpha(fc,
+                                                src_line_a,
+                                                dst_line_a,
+                                                fc.xmin,
+                                                fc.xmax);
+
+                return fc.xmax;
+            }
+
+            /* Vectorized conversion functions for inputs with alpha and
+             * outputs without alpha, the converted components are composited
+             * over the background in the tiles.
+             */
+
+            inline int convertFast8bitsSimd3Ato3(const FrameConvertParameters &fc,
+                                                 const uint8_t *src_line_x,
+                                                 const uint8_t *src_line_y,
+                                                 const uint8_t *src_line_z,
+                                                 const uint8_t *src_line_a,
+                                                 uint8_t *dst_line_x,
+                                                 uint8_t *dst_line_y,
+                                                 uint8_t *dst_line_z) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t yi[SIMD_TILE_SIZE];
+                uint8_t zi[SIMD_TILE_SIZE];
+                uint8_t ai[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+                uint8_t yo[SIMD_TILE_SIZE];
+                uint8_t zo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto srcWidthOffsetY = fc.srcWidthOffsetY + x;
+                    auto srcWidthOffsetZ = fc.srcWidthOffsetZ + x;
+                    auto srcWidthOffsetA = fc.srcWidthOffsetA + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+                    auto dstWidthOffsetY = fc.dstWidthOffsetY + x;
+                    auto dstWidthOffsetZ = fc.dstWidthOffsetZ + x;
+
+                    for (int i = 0; i < width; ++i) {
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+                        yi[i] = src_line_y[srcWidthOffsetY[i]];
+                        zi[i] = src_line_z[srcWidthOffsetZ[i]];
+                        ai[i] = src_line_a[srcWidthOffsetA[i]];
+                    }
+
+                    if (fc.convertType == ConvertType_Vector) {
+                        Simd::alphaBlend3(fc.simdAlphaMatrix,
+                                          ai,
+                                          xi, yi, zi,
+                                          width);
+
+                        for (int i = 0; i < width; ++i) {
+                            dst_line_x[dstWidthOffsetX[i]] = xi[i];
+                            dst_line_y[dstWidthOffsetY[i]] = yi[i];
+                            dst_line_z[dstWidthOffsetZ[i]] = zi[i];
+                        }
+                    } else {
+                        Simd::matrix3to3(fc.simdColorMatrix,
+                                         xi, yi, zi,
+                                         xo, yo, zo,
+                                         width);
+                        Simd::alphaBlend3(fc.simdAlphaMatrix,
+                                          ai,
+                                          xo, yo, zo,
+                                          width);
+
+                        for (int i = 0; i < width; ++i) {
+                            dst_line_x[dstWidthOffsetX[i]] = xo[i];
+                            dst_line_y[dstWidthOffsetY[i]] = yo[i];
+                            dst_line_z[dstWidthOffsetZ[i]] = zo[i];
+                        }
+                    }
+                }
+
+                return fc.xmax;
+            }
+
+            inline int convertFast8bitsSimd3Ato1(const FrameConvertParameters &fc,
+                                                 const uint8_t *src_line_x,
+                                                 const uint8_t *src_line_y,
+                                                 const uint8_t *src_line_z,
+                                                 const uint8_t *src_line_a,
+                                                 uint8_t *dst_line_x) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t yi[SIMD_TILE_SIZE];
+                uint8_t zi[SIMD_TILE_SIZE];
+                uint8_t ai[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto srcWidthOffsetY = fc.srcWidthOffsetY + x;
+                    auto srcWidthOffsetZ = fc.srcWidthOffsetZ + x;
+                    auto srcWidthOffsetA = fc.srcWidthOffsetA + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+
+                    for (int i = 0; i < width; ++i) {
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+                        yi[i] = src_line_y[srcWidthOffsetY[i]];
+                        zi[i] = src_line_z[srcWidthOffsetZ[i]];
+                        ai[i] = src_line_a[srcWidthOffsetA[i]];
+                    }
+
+                    Simd::matrix3to1(fc.simdColorMatrix,
+                                     xi, yi, zi,
+                                     xo,
+                                     width);
+                    Simd::alphaBlend1(fc.simdAlphaMatrix, ai, xo, width);
+
+                    for (int i = 0; i < width; ++i)
+                        dst_line_x[dstWidthOffsetX[i]] = xo[i];
+                }
+
+                return fc.xmax;
+            }
+
+            inline int convertFast8bitsSimd1Ato3(const FrameConvertParameters &fc,
+                                                 const uint8_t *src_line_x,
+                                                 const uint8_t *src_line_a,
+                                                 uint8_t *dst_line_x,
+                                                 uint8_t *dst_line_y,
+                                                 uint8_t *dst_line_z) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t ai[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+                uint8_t yo[SIMD_TILE_SIZE];
+                uint8_t zo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto srcWidthOffsetA = fc.srcWidthOffsetA + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+                    auto dstWidthOffsetY = fc.dstWidthOffsetY + x;
+                    auto dstWidthOffsetZ = fc.dstWidthOffsetZ + x;
+
+                    for (int i = 0; i < width; ++i) {
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+                        ai[i] = src_line_a[srcWidthOffsetA[i]];
+                    }
+
+                    Simd::point1to3(fc.simdColorMatrix,
+                                    xi,
+                                    xo, yo, zo,
+                                    width);
+                    Simd::alphaBlend3(fc.simdAlphaMatrix,
+                                      ai,
+                                      xo, yo, zo,
+                                      width);
+
+                    for (int i = 0; i < width; ++i) {
+                        dst_line_x[dstWidthOffsetX[i]] = xo[i];
+                        dst_line_y[dstWidthOffsetY[i]] = yo[i];
+                        dst_line_z[dstWidthOffsetZ[i]] = zo[i];
+                    }
+                }
+
+                return fc.xmax;
+            }
+
+            inline int convertFast8bitsSimd1Ato1(const FrameConvertParameters &fc,
+                                                 const uint8_t *src_line_x,
+                                                 const uint8_t *src_line_a,
+                                                 uint8_t *dst_line_x) const
+            {
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t ai[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int width = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+                    auto srcWidthOffsetX = fc.srcWidthOffsetX + x;
+                    auto srcWidthOffsetA = fc.srcWidthOffsetA + x;
+                    auto dstWidthOffsetX = fc.dstWidthOffsetX + x;
+
+                    for (int i = 0; i < width; ++i) {
+                        xi[i] = src_line_x[srcWidthOffsetX[i]];
+                        ai[i] = src_line_a[srcWidthOffsetA[i]];
+                    }
+
+                    Simd::alphaBlend1(fc.simdAlphaMatrix, ai, xi, width);
+
+                    for (int i = 0; i < width; ++i)
+                        dst_line_x[dstWidthOffsetX[i]] = xi[i];
+                }
+
+                return fc.xmax;
             }
 
             /* Fast conversion functions */
@@ -1256,9 +2055,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3to3(const FrameConvertParameters &fc,
                              const VideoFrame &src,
-                             VideoFrame &dst) const
+                             VideoFrame &dst,
+                             int ymin,
+                             int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1300,9 +2101,11 @@ namespace AkVCam
 
             void convertFast8bits3to3(const FrameConvertParameters &fc,
                                       const VideoFrame &src,
-                                      VideoFrame &dst) const
+                                      VideoFrame &dst,
+                                      int ymin,
+                                      int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1314,6 +2117,17 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd3to3(fc,
+                                                           src_line_x,
+                                                           src_line_y,
+                                                           src_line_z,
+                                                           nullptr,
+                                                           dst_line_x,
+                                                           dst_line_y,
+                                                           dst_line_z,
+                                                           nullptr);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -1322,7 +2136,7 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi, yi, zi, &xo, &yo, &zo);
+                        fc.colorConvert.applyMatrix8bits(xi, yi, zi, &xo, &yo, &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[i]] = uint8_t(yo);
@@ -1334,9 +2148,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3to3A(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1380,9 +2196,11 @@ namespace AkVCam
 
             void convertFast8bits3to3A(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1395,6 +2213,17 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd3to3(fc,
+                                                           src_line_x,
+                                                           src_line_y,
+                                                           src_line_z,
+                                                           nullptr,
+                                                           dst_line_x,
+                                                           dst_line_y,
+                                                           dst_line_z,
+                                                           dst_line_a);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -1403,7 +2232,7 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi, yi, zi, &xo, &yo, &zo);
+                        fc.colorConvert.applyMatrix8bits(xi, yi, zi, &xo, &yo, &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[i]] = uint8_t(yo);
@@ -1416,9 +2245,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3Ato3(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1465,9 +2296,11 @@ namespace AkVCam
 
             void convertFast8bits3Ato3(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1480,6 +2313,15 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion && fc.simdAlphaBlending)
+                        x = this->convertFast8bitsSimd3Ato3(fc,
+                                                            src_line_x,
+                                                            src_line_y,
+                                                            src_line_z,
+                                                            src_line_a,
+                                                            dst_line_x,
+                                                            dst_line_y,
+                                                            dst_line_z);
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -1489,7 +2331,7 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi, yi, zi, &xo, &yo, &zo);
+                        fc.colorConvert.applyMatrix8bits(xi, yi, zi, &xo, &yo, &zo);
                         fc.colorConvert.applyAlpha(ai, &xo, &yo, &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
@@ -1502,9 +2344,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3Ato3A(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1553,9 +2397,11 @@ namespace AkVCam
 
             void convertFast8bits3Ato3A(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1569,6 +2415,17 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd3to3(fc,
+                                                           src_line_x,
+                                                           src_line_y,
+                                                           src_line_z,
+                                                           src_line_a,
+                                                           dst_line_x,
+                                                           dst_line_y,
+                                                           dst_line_z,
+                                                           dst_line_a);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -1578,7 +2435,7 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi, yi, zi, &xo, &yo, &zo);
+                        fc.colorConvert.applyMatrix8bits(xi, yi, zi, &xo, &yo, &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[i]] = uint8_t(yo);
@@ -1594,9 +2451,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertV3to3(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1638,9 +2497,11 @@ namespace AkVCam
 
             void convertFast8bitsV3to3(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1661,9 +2522,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertV3to3A(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
 
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
@@ -1708,9 +2571,11 @@ namespace AkVCam
 
             void convertFast8bitsV3to3A(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1733,9 +2598,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertV3Ato3(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1782,9 +2649,11 @@ namespace AkVCam
 
             void convertFast8bitsV3Ato3(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1797,6 +2666,15 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdAlphaBlending)
+                        x = this->convertFast8bitsSimd3Ato3(fc,
+                                                            src_line_x,
+                                                            src_line_y,
+                                                            src_line_z,
+                                                            src_line_a,
+                                                            dst_line_x,
+                                                            dst_line_y,
+                                                            dst_line_z);
                     for (int i = x; i < fc.xmax; ++i) {
                         int64_t xi = src_line_x[fc.srcWidthOffsetX[i]];
                         int64_t yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -1815,9 +2693,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertV3Ato3A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1866,9 +2746,11 @@ namespace AkVCam
 
             void convertFast8bitsV3Ato3A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1894,9 +2776,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3to1(const FrameConvertParameters &fc,
                              const VideoFrame &src,
-                             VideoFrame &dst) const
+                             VideoFrame &dst,
+                             int ymin,
+                             int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1930,9 +2814,11 @@ namespace AkVCam
 
             void convertFast8bits3to1(const FrameConvertParameters &fc,
                                       const VideoFrame &src,
-                                      VideoFrame &dst) const
+                                      VideoFrame &dst,
+                                      int ymin,
+                                      int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1942,13 +2828,22 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd3to1(fc,
+                                                           src_line_x,
+                                                           src_line_y,
+                                                           src_line_z,
+                                                           nullptr,
+                                                           dst_line_x,
+                                                           nullptr);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
                         auto zi = src_line_z[fc.srcWidthOffsetZ[i]];
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
                     }
@@ -1958,9 +2853,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3to1A(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -1996,9 +2893,11 @@ namespace AkVCam
 
             void convertFast8bits3to1A(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -2009,13 +2908,22 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd3to1(fc,
+                                                           src_line_x,
+                                                           src_line_y,
+                                                           src_line_z,
+                                                           nullptr,
+                                                           dst_line_x,
+                                                           dst_line_a);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
                         auto zi = src_line_z[fc.srcWidthOffsetZ[i]];
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[i]] = 0xff;
@@ -2026,9 +2934,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3Ato1(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -2067,9 +2977,11 @@ namespace AkVCam
 
             void convertFast8bits3Ato1(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -2080,6 +2992,13 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion && fc.simdAlphaBlending)
+                        x = this->convertFast8bitsSimd3Ato1(fc,
+                                                            src_line_x,
+                                                            src_line_y,
+                                                            src_line_z,
+                                                            src_line_a,
+                                                            dst_line_x);
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -2087,7 +3006,7 @@ namespace AkVCam
                         auto ai = src_line_a[fc.srcWidthOffsetA[i]];
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
                         fc.colorConvert.applyAlpha(ai, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
@@ -2098,9 +3017,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert3Ato1A(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -2141,9 +3062,11 @@ namespace AkVCam
 
             void convertFast8bits3Ato1A(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
@@ -2155,6 +3078,15 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd3to1(fc,
+                                                           src_line_x,
+                                                           src_line_y,
+                                                           src_line_z,
+                                                           src_line_a,
+                                                           dst_line_x,
+                                                           dst_line_a);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto yi = src_line_y[fc.srcWidthOffsetY[i]];
@@ -2162,7 +3094,7 @@ namespace AkVCam
                         auto ai = src_line_a[fc.srcWidthOffsetA[i]];
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[i]] = ai;
@@ -2174,9 +3106,11 @@ namespace AkVCam
 
             template <typename InputType, typename OutputType>
             void convert1to3(const FrameConvertParameters &fc,
-                             const VideoFrame &src, VideoFrame &dst) const
+                             const VideoFrame &src, VideoFrame &dst,
+                             int ymin,
+                             int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
 
@@ -2210,9 +3144,11 @@ namespace AkVCam
 
             void convertFast8bits1to3(const FrameConvertParameters &fc,
                                       const VideoFrame &src,
-                                      VideoFrame &dst) const
+                                      VideoFrame &dst,
+                                      int ymin,
+                                      int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
 
@@ -2222,6 +3158,15 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd1to3(fc,
+                                                           src_line_x,
+                                                           nullptr,
+                                                           dst_line_x,
+                                                           dst_line_y,
+                                                           dst_line_z,
+                                                           nullptr);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
 
@@ -2240,9 +3185,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1to3A(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
 
@@ -2278,9 +3225,11 @@ namespace AkVCam
 
             void convertFast8bits1to3A(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
 
@@ -2291,6 +3240,15 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd1to3(fc,
+                                                           src_line_x,
+                                                           nullptr,
+                                                           dst_line_x,
+                                                           dst_line_y,
+                                                           dst_line_z,
+                                                           dst_line_a);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
 
@@ -2310,9 +3268,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1Ato3(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2351,9 +3311,11 @@ namespace AkVCam
 
             void convertFast8bits1Ato3(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2364,6 +3326,13 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion && fc.simdAlphaBlending)
+                        x = this->convertFast8bitsSimd1Ato3(fc,
+                                                            src_line_x,
+                                                            src_line_a,
+                                                            dst_line_x,
+                                                            dst_line_y,
+                                                            dst_line_z);
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto ai = src_line_a[fc.srcWidthOffsetA[i]];
@@ -2384,9 +3353,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1Ato3A(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2427,9 +3398,11 @@ namespace AkVCam
 
             void convertFast8bits1Ato3A(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2441,6 +3414,15 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdConvertion)
+                        x = this->convertFast8bitsSimd1to3(fc,
+                                                           src_line_x,
+                                                           src_line_a,
+                                                           dst_line_x,
+                                                           dst_line_y,
+                                                           dst_line_z,
+                                                           dst_line_a);
+
                     for (int i = x; i < fc.xmax; ++i) {
                         auto xi = src_line_x[fc.srcWidthOffsetX[i]];
                         auto ai = src_line_a[fc.srcWidthOffsetA[i]];
@@ -2463,9 +3445,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1to1(const FrameConvertParameters &fc,
                              const VideoFrame &src,
-                             VideoFrame &dst) const
+                             VideoFrame &dst,
+                             int ymin,
+                             int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
@@ -2490,9 +3474,11 @@ namespace AkVCam
 
             void convertFast8bits1to1(const FrameConvertParameters &fc,
                                       const VideoFrame &src,
-                                      VideoFrame &dst) const
+                                      VideoFrame &dst,
+                                      int ymin,
+                                      int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
@@ -2506,9 +3492,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1to1A(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
 
@@ -2536,9 +3524,11 @@ namespace AkVCam
 
             void convertFast8bits1to1A(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
 
@@ -2555,9 +3545,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1Ato1(const FrameConvertParameters &fc,
                               const VideoFrame &src,
-                              VideoFrame &dst) const
+                              VideoFrame &dst,
+                              int ymin,
+                              int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2588,9 +3580,11 @@ namespace AkVCam
 
             void convertFast8bits1Ato1(const FrameConvertParameters &fc,
                                        const VideoFrame &src,
-                                       VideoFrame &dst) const
+                                       VideoFrame &dst,
+                                       int ymin,
+                                       int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2599,11 +3593,17 @@ namespace AkVCam
 
                     int x = fc.xmin;
 
+                    if (fc.simdAlphaBlending)
+                        x = this->convertFast8bitsSimd1Ato1(fc,
+                                                            src_line_x,
+                                                            src_line_a,
+                                                            dst_line_x);
                     for (int i = x; i < fc.xmax; ++i) {
-                        dst_line_x[fc.dstWidthOffsetX[i]] =
-                                uint8_t(uint16_t(src_line_x[fc.srcWidthOffsetX[i]])
-                                       * uint16_t(src_line_a[fc.srcWidthOffsetA[i]])
-                                       / 255);
+                        int64_t xi = src_line_x[fc.srcWidthOffsetX[i]];
+                        auto ai = src_line_a[fc.srcWidthOffsetA[i]];
+                        fc.colorConvert.applyAlpha(ai, &xi);
+
+                        dst_line_x[fc.dstWidthOffsetX[i]] = uint8_t(xi);
                     }
                 }
             }
@@ -2611,9 +3611,11 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convert1Ato1A(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2646,9 +3648,11 @@ namespace AkVCam
 
             void convertFast8bits1Ato1A(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
+                for (int y = ymin; y < ymax; ++y) {
                     auto &ys = fc.srcHeight[y];
                     auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
                     auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
@@ -2667,25 +3671,25 @@ namespace AkVCam
 
             // Conversion functions for 3 components to 3 components formats
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3to3(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x,
+                                                   src_line_y,
+                                                   src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -2699,11 +3703,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -2727,29 +3728,28 @@ namespace AkVCam
                                      OutputType(yo),
                                      OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3to3(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x,
+                                                 src_line_y,
+                                                 src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -2763,11 +3763,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -2775,41 +3772,39 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3to3A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x,
+                                                   src_line_y,
+                                                   src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -2824,11 +3819,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -2853,29 +3845,28 @@ namespace AkVCam
                                       OutputType(yo),
                                       OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3to3A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x,
+                                                 src_line_y,
+                                                 src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -2890,11 +3881,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -2902,44 +3890,42 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3Ato3(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_y,
+                                                    src_line_z,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -2955,12 +3941,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -2989,31 +3971,30 @@ namespace AkVCam
                                      OutputType(yo),
                                      OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3Ato3(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_y,
+                                                  src_line_z,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3029,12 +4010,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3043,12 +4020,12 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
                         fc.colorConvert.applyAlpha(ai,
                                                    &xo,
                                                    &yo,
@@ -3058,32 +4035,30 @@ namespace AkVCam
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3Ato3A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_y,
+                                                    src_line_z,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3100,12 +4075,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3132,31 +4103,30 @@ namespace AkVCam
                                       OutputType(zo),
                                       OutputType(ai));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3Ato3A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_y,
+                                                  src_line_z,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3173,12 +4143,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3187,45 +4153,43 @@ namespace AkVCam
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = ai;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
             // Conversion functions for 3 components to 3 components formats
             // (same color space)
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDLV3to3(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x,
+                                                   src_line_y,
+                                                   src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3239,11 +4203,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -3267,29 +4228,28 @@ namespace AkVCam
                                      OutputType(yo),
                                      OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDLV3to3(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x,
+                                                 src_line_y,
+                                                 src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3303,11 +4263,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -3326,30 +4283,28 @@ namespace AkVCam
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDLV3to3A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x,
+                                                   src_line_y,
+                                                   src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3364,11 +4319,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -3393,29 +4345,28 @@ namespace AkVCam
                                       OutputType(yo),
                                       OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDLV3to3A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x,
+                                                 src_line_y,
+                                                 src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3430,11 +4381,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -3454,32 +4402,30 @@ namespace AkVCam
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDLV3Ato3(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_y,
+                                                    src_line_z,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3495,12 +4441,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3529,31 +4471,30 @@ namespace AkVCam
                                      OutputType(yo),
                                      OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDLV3Ato3(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_y,
+                                                  src_line_z,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3569,12 +4510,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3598,32 +4535,30 @@ namespace AkVCam
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDLV3Ato3A(const FrameConvertParameters &fc,
                                   const VideoFrame &src,
-                                  VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                  VideoFrame &dst,
+                                  int ymin,
+                                  int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_y,
+                                                    src_line_z,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3640,12 +4575,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3672,31 +4603,30 @@ namespace AkVCam
                                       OutputType(zo),
                                       OutputType(ai));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDLV3Ato3A(const FrameConvertParameters &fc,
                                            const VideoFrame &src,
-                                           VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                           VideoFrame &dst,
+                                           int ymin,
+                                           int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_y,
+                                                  src_line_z,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -3713,12 +4643,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -3739,32 +4665,30 @@ namespace AkVCam
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = ai;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
             // Conversion functions for 3 components to 1 components formats
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3to1(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x,
+                                                   src_line_y,
+                                                   src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y);
 
@@ -3776,11 +4700,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -3793,29 +4714,28 @@ namespace AkVCam
                                      x,
                                      OutputType(xo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3to1(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x,
+                                                 src_line_y,
+                                                 src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -3827,44 +4747,39 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3to1A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x,
+                                                   src_line_y,
+                                                   src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -3877,11 +4792,8 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
@@ -3895,29 +4807,28 @@ namespace AkVCam
                                       x,
                                       OutputType(xo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3to1A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
+            {
+                std::vector<SumType> integralLines(3 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x,
+                                                 src_line_y,
+                                                 src_line_z);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -3930,47 +4841,42 @@ namespace AkVCam
                                       src_line_x,
                                       src_line_y,
                                       src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi,
                                       &yi,
                                       &zi);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3Ato1(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_y,
+                                                    src_line_z,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y);
 
@@ -3984,12 +4890,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -4004,31 +4906,30 @@ namespace AkVCam
                                      x,
                                      OutputType(xo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3Ato1(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_y,
+                                                  src_line_z,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -4042,49 +4943,43 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
                                        &ai);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
                         fc.colorConvert.applyAlpha(ai, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL3Ato1A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_y,
+                                                    src_line_z,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -4099,12 +4994,8 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
@@ -4120,31 +5011,30 @@ namespace AkVCam
                                       OutputType(xo),
                                       OutputType(ai));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL3Ato1A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
-            {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_y = fc.integralImageDataY + yOffset;
-                    auto src_line_z = fc.integralImageDataZ + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_y_1 = fc.integralImageDataY + y1Offset;
-                    auto src_line_z_1 = fc.integralImageDataZ + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
+            {
+                std::vector<SumType> integralLines(4 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_y = src_line_x + fc.inputWidth_1;
+                auto src_line_z = src_line_y + fc.inputWidth_1;
+                auto src_line_a = src_line_z + fc.inputWidth_1;
+
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine3A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_y,
+                                                  src_line_z,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -4159,44 +5049,39 @@ namespace AkVCam
                                        src_line_y,
                                        src_line_z,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &yi,
                                        &zi,
                                        &ai);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi, yi, zi, &xo);
+                        fc.colorConvert.applyPoint8bits(xi, yi, zi, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = ai;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
             // Conversion functions for 1 components to 3 components formats
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1to3(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4206,9 +5091,8 @@ namespace AkVCam
                         InputType xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4225,24 +5109,24 @@ namespace AkVCam
                                      OutputType(yo),
                                      OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1to3(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4252,9 +5136,8 @@ namespace AkVCam
                         uint8_t xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4266,25 +5149,24 @@ namespace AkVCam
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1to3A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4295,9 +5177,8 @@ namespace AkVCam
                         InputType xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4315,24 +5196,24 @@ namespace AkVCam
                                       OutputType(yo),
                                       OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1to3A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4343,9 +5224,8 @@ namespace AkVCam
                         uint8_t xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4358,28 +5238,26 @@ namespace AkVCam
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1Ato3(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4391,10 +5269,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4413,27 +5289,26 @@ namespace AkVCam
                                      OutputType(yo),
                                      OutputType(zo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1Ato3(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4445,10 +5320,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4462,28 +5335,26 @@ namespace AkVCam
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1Ato3A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4496,10 +5367,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4519,27 +5388,26 @@ namespace AkVCam
                                       OutputType(zo),
                                       OutputType(ai));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1Ato3A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4552,10 +5420,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4569,27 +5435,26 @@ namespace AkVCam
                         dst_line_z[fc.dstWidthOffsetZ[x]] = uint8_t(zo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = ai;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
             // Conversion functions for 1 components to 1 components formats
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1to1(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -4597,9 +5462,8 @@ namespace AkVCam
                         InputType xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4610,24 +5474,24 @@ namespace AkVCam
                                      x,
                                      OutputType(xo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1to1(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -4635,9 +5499,8 @@ namespace AkVCam
                         uint8_t xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4645,25 +5508,24 @@ namespace AkVCam
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1to1A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<InputType>(fc,
+                                                   src,
+                                                   y,
+                                                   src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -4672,9 +5534,8 @@ namespace AkVCam
                         InputType xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4686,24 +5547,24 @@ namespace AkVCam
                                       x,
                                       OutputType(xo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1to1A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(1 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1<uint8_t>(fc,
+                                                 src,
+                                                 y,
+                                                 src_line_x);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -4712,9 +5573,8 @@ namespace AkVCam
                         uint8_t xi;
                         this->readDL1(fc,
                                       src_line_x,
-                                      src_line_x_1,
                                       x,
-                                      kdl,
+                                      y,
                                       &xi);
 
                         int64_t xo = 0;
@@ -4723,28 +5583,26 @@ namespace AkVCam
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1Ato1(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -4754,10 +5612,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4770,27 +5626,26 @@ namespace AkVCam
                                      x,
                                      OutputType(xo));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1Ato1(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -4800,10 +5655,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4813,28 +5666,26 @@ namespace AkVCam
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
-            template <typename InputType, typename OutputType>
+            template <typename InputType, typename OutputType, typename SumType>
             void convertDL1Ato1A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
-
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<InputType>(fc,
+                                                    src,
+                                                    y,
+                                                    src_line_x,
+                                                    src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -4845,10 +5696,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4862,27 +5711,26 @@ namespace AkVCam
                                       OutputType(xo),
                                       OutputType(ai));
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
+            template <typename SumType>
             void convertFast8bitsDL1Ato1A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                UNUSED(src);
-                auto kdl = fc.kdl;
+                std::vector<SumType> integralLines(2 * size_t(fc.inputWidth_1));
+                auto src_line_x = integralLines.data();
+                auto src_line_a = src_line_x + fc.inputWidth_1;
 
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &yOffset = fc.srcHeightDlOffset[y];
-                    auto &y1Offset = fc.srcHeightDlOffset_1[y];
-
-                    auto src_line_x = fc.integralImageDataX + yOffset;
-                    auto src_line_a = fc.integralImageDataA + yOffset;
-
-                    auto src_line_x_1 = fc.integralImageDataX + y1Offset;
-                    auto src_line_a_1 = fc.integralImageDataA + y1Offset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->integralLine1A<uint8_t>(fc,
+                                                  src,
+                                                  y,
+                                                  src_line_x,
+                                                  src_line_a);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -4893,10 +5741,8 @@ namespace AkVCam
                         this->readDL1A(fc,
                                        src_line_x,
                                        src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
                                        x,
-                                       kdl,
+                                       y,
                                        &xi,
                                        &ai);
 
@@ -4906,8 +5752,6 @@ namespace AkVCam
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = ai;
                     }
-
-                    kdl += fc.inputWidth;
                 }
             }
 
@@ -4918,19 +5762,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3to3(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -4942,13 +5781,8 @@ namespace AkVCam
                         InputType xi;
                         InputType yi;
                         InputType zi;
-                        this->readUL3(fc,
-                                      src_line_x,
-                                      src_line_y,
-                                      src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
+                        this->readUL3(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi,
@@ -4979,19 +5813,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3to3(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5003,28 +5832,23 @@ namespace AkVCam
                         uint8_t xi;
                         uint8_t yi;
                         uint8_t zi;
-                        this->readF8UL3(fc,
-                                        src_line_x,
-                                        src_line_y,
-                                        src_line_z,
-                                        src_line_x_1,
-                                        src_line_y_1,
-                                        src_line_z_1,
-                                        x,
-                                        ky,
-                                        &xi,
-                                        &yi,
-                                        &zi);
+                        this->readUL3(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi,
+                                      &yi,
+                                      &zi);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
@@ -5036,19 +5860,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3to3A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5061,13 +5880,8 @@ namespace AkVCam
                         InputType xi;
                         InputType yi;
                         InputType zi;
-                        this->readUL3(fc,
-                                      src_line_x,
-                                      src_line_y,
-                                      src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
+                        this->readUL3(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi,
@@ -5099,19 +5913,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3to3A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5124,28 +5933,23 @@ namespace AkVCam
                         uint8_t xi;
                         uint8_t yi;
                         uint8_t zi;
-                        this->readF8UL3(fc,
-                                        src_line_x,
-                                        src_line_y,
-                                        src_line_z,
-                                        src_line_x_1,
-                                        src_line_y_1,
-                                        src_line_z_1,
-                                        x,
-                                        ky,
-                                        &xi,
-                                        &yi,
-                                        &zi);
+                        this->readUL3(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi,
+                                      &yi,
+                                      &zi);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
@@ -5158,21 +5962,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3Ato3(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5185,15 +5982,8 @@ namespace AkVCam
                         InputType yi;
                         InputType zi;
                         InputType ai;
-                        this->readUL3A(fc,
-                                       src_line_x,
-                                       src_line_y,
-                                       src_line_z,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -5229,21 +6019,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3Ato3(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5256,31 +6039,24 @@ namespace AkVCam
                         uint8_t yi;
                         uint8_t zi;
                         uint8_t ai;
-                        this->readF8UL3A(fc,
-                                         src_line_x,
-                                         src_line_y,
-                                         src_line_z,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_y_1,
-                                         src_line_z_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &yi,
-                                         &zi,
-                                         &ai);
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &yi,
+                                       &zi,
+                                       &ai);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
                         fc.colorConvert.applyAlpha(ai,
                                                    &xo,
                                                    &yo,
@@ -5296,21 +6072,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3Ato3A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5324,15 +6093,8 @@ namespace AkVCam
                         InputType yi;
                         InputType zi;
                         InputType ai;
-                        this->readUL3A(fc,
-                                       src_line_x,
-                                       src_line_y,
-                                       src_line_z,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -5366,21 +6128,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3Ato3A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5394,31 +6149,24 @@ namespace AkVCam
                         uint8_t yi;
                         uint8_t zi;
                         uint8_t ai;
-                        this->readF8UL3A(fc,
-                                         src_line_x,
-                                         src_line_y,
-                                         src_line_z,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_y_1,
-                                         src_line_z_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &yi,
-                                         &zi,
-                                         &ai);
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &yi,
+                                       &zi,
+                                       &ai);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
-                        fc.colorConvert.applyMatrix(xi,
-                                                    yi,
-                                                    zi,
-                                                    &xo,
-                                                    &yo,
-                                                    &zo);
+                        fc.colorConvert.applyMatrix8bits(xi,
+                                                         yi,
+                                                         zi,
+                                                         &xo,
+                                                         &yo,
+                                                         &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
@@ -5434,19 +6182,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertULV3to3(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5458,13 +6201,8 @@ namespace AkVCam
                         InputType xi;
                         InputType yi;
                         InputType zi;
-                        this->readUL3(fc,
-                                      src_line_x,
-                                      src_line_y,
-                                      src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
+                        this->readUL3(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi,
@@ -5495,19 +6233,14 @@ namespace AkVCam
 
             void convertFast8bitsULV3to3(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5519,18 +6252,13 @@ namespace AkVCam
                         uint8_t xi;
                         uint8_t yi;
                         uint8_t zi;
-                        this->readF8UL3(fc,
-                                        src_line_x,
-                                        src_line_y,
-                                        src_line_z,
-                                        src_line_x_1,
-                                        src_line_y_1,
-                                        src_line_z_1,
-                                        x,
-                                        ky,
-                                        &xi,
-                                        &yi,
-                                        &zi);
+                        this->readUL3(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi,
+                                      &yi,
+                                      &zi);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -5552,19 +6280,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertULV3to3A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5577,13 +6300,8 @@ namespace AkVCam
                         InputType xi;
                         InputType yi;
                         InputType zi;
-                        this->readUL3(fc,
-                                      src_line_x,
-                                      src_line_y,
-                                      src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
+                        this->readUL3(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi,
@@ -5615,19 +6333,14 @@ namespace AkVCam
 
             void convertFast8bitsULV3to3A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5640,18 +6353,13 @@ namespace AkVCam
                         uint8_t xi;
                         uint8_t yi;
                         uint8_t zi;
-                        this->readF8UL3(fc,
-                                        src_line_x,
-                                        src_line_y,
-                                        src_line_z,
-                                        src_line_x_1,
-                                        src_line_y_1,
-                                        src_line_z_1,
-                                        x,
-                                        ky,
-                                        &xi,
-                                        &yi,
-                                        &zi);
+                        this->readUL3(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi,
+                                      &yi,
+                                      &zi);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -5674,21 +6382,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertULV3Ato3(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5701,15 +6402,8 @@ namespace AkVCam
                         InputType yi;
                         InputType zi;
                         InputType ai;
-                        this->readUL3A(fc,
-                                       src_line_x,
-                                       src_line_y,
-                                       src_line_z,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -5745,21 +6439,14 @@ namespace AkVCam
 
             void convertFast8bitsULV3Ato3(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5772,21 +6459,14 @@ namespace AkVCam
                         uint8_t yi;
                         uint8_t zi;
                         uint8_t ai;
-                        this->readF8UL3A(fc,
-                                         src_line_x,
-                                         src_line_y,
-                                         src_line_z,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_y_1,
-                                         src_line_z_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &yi,
-                                         &zi,
-                                         &ai);
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &yi,
+                                       &zi,
+                                       &ai);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -5812,21 +6492,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertULV3Ato3A(const FrameConvertParameters &fc,
                                   const VideoFrame &src,
-                                  VideoFrame &dst) const
+                                  VideoFrame &dst,
+                                  int ymin,
+                                  int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5840,15 +6513,8 @@ namespace AkVCam
                         InputType yi;
                         InputType zi;
                         InputType ai;
-                        this->readUL3A(fc,
-                                       src_line_x,
-                                       src_line_y,
-                                       src_line_z,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -5882,21 +6548,14 @@ namespace AkVCam
 
             void convertFast8bitsULV3Ato3A(const FrameConvertParameters &fc,
                                            const VideoFrame &src,
-                                           VideoFrame &dst) const
+                                           VideoFrame &dst,
+                                           int ymin,
+                                           int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -5910,21 +6569,14 @@ namespace AkVCam
                         uint8_t yi;
                         uint8_t zi;
                         uint8_t ai;
-                        this->readF8UL3A(fc,
-                                         src_line_x,
-                                         src_line_y,
-                                         src_line_z,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_y_1,
-                                         src_line_z_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &yi,
-                                         &zi,
-                                         &ai);
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &yi,
+                                       &zi,
+                                       &ai);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -5949,19 +6601,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3to1(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y);
 
@@ -5971,13 +6618,8 @@ namespace AkVCam
                         InputType xi;
                         InputType yi;
                         InputType zi;
-                        this->readUL3(fc,
-                                      src_line_x,
-                                      src_line_y,
-                                      src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
+                        this->readUL3(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi,
@@ -6000,19 +6642,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3to1(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -6022,24 +6659,19 @@ namespace AkVCam
                         uint8_t xi;
                         uint8_t yi;
                         uint8_t zi;
-                        this->readF8UL3(fc,
-                                        src_line_x,
-                                        src_line_y,
-                                        src_line_z,
-                                        src_line_x_1,
-                                        src_line_y_1,
-                                        src_line_z_1,
-                                        x,
-                                        ky,
-                                        &xi,
-                                        &yi,
-                                        &zi);
+                        this->readUL3(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi,
+                                      &yi,
+                                      &zi);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi,
-                                                   yi,
-                                                   zi,
-                                                   &xo);
+                        fc.colorConvert.applyPoint8bits(xi,
+                                                        yi,
+                                                        zi,
+                                                        &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                     }
@@ -6049,19 +6681,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3to1A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6072,13 +6699,8 @@ namespace AkVCam
                         InputType xi;
                         InputType yi;
                         InputType zi;
-                        this->readUL3(fc,
-                                      src_line_x,
-                                      src_line_y,
-                                      src_line_z,
-                                      src_line_x_1,
-                                      src_line_y_1,
-                                      src_line_z_1,
+                        this->readUL3(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi,
@@ -6102,19 +6724,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3to1A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
+                LineCache cache(3 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6125,24 +6742,19 @@ namespace AkVCam
                         uint8_t xi;
                         uint8_t yi;
                         uint8_t zi;
-                        this->readF8UL3(fc,
-                                        src_line_x,
-                                        src_line_y,
-                                        src_line_z,
-                                        src_line_x_1,
-                                        src_line_y_1,
-                                        src_line_z_1,
-                                        x,
-                                        ky,
-                                        &xi,
-                                        &yi,
-                                        &zi);
+                        this->readUL3(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi,
+                                      &yi,
+                                      &zi);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi,
-                                                   yi,
-                                                   zi,
-                                                   &xo);
+                        fc.colorConvert.applyPoint8bits(xi,
+                                                        yi,
+                                                        zi,
+                                                        &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = 0xff;
@@ -6153,21 +6765,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3Ato1(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y);
 
@@ -6178,15 +6783,8 @@ namespace AkVCam
                         InputType yi;
                         InputType zi;
                         InputType ai;
-                        this->readUL3A(fc,
-                                       src_line_x,
-                                       src_line_y,
-                                       src_line_z,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -6211,21 +6809,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3Ato1(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -6236,27 +6827,20 @@ namespace AkVCam
                         uint8_t yi;
                         uint8_t zi;
                         uint8_t ai;
-                        this->readF8UL3A(fc,
-                                         src_line_x,
-                                         src_line_y,
-                                         src_line_z,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_y_1,
-                                         src_line_z_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &yi,
-                                         &zi,
-                                         &ai);
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &yi,
+                                       &zi,
+                                       &ai);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi,
-                                                   yi,
-                                                   zi,
-                                                   &xo);
+                        fc.colorConvert.applyPoint8bits(xi,
+                                                        yi,
+                                                        zi,
+                                                        &xo);
                         fc.colorConvert.applyAlpha(ai, &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
@@ -6267,21 +6851,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL3Ato1A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL3A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6293,15 +6870,8 @@ namespace AkVCam
                         InputType yi;
                         InputType zi;
                         InputType ai;
-                        this->readUL3A(fc,
-                                       src_line_x,
-                                       src_line_y,
-                                       src_line_z,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_y_1,
-                                       src_line_z_1,
-                                       src_line_a_1,
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -6327,21 +6897,14 @@ namespace AkVCam
 
             void convertFast8bitsUL3Ato1A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
-
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_y = src.constLine(fc.planeYi, ys) + fc.yiOffset;
-                    auto src_line_z = src.constLine(fc.planeZi, ys) + fc.ziOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
+                LineCache cache(4 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_y_1 = src.constLine(fc.planeYi, ys_1) + fc.yiOffset;
-                    auto src_line_z_1 = src.constLine(fc.planeZi, ys_1) + fc.ziOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL3A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6353,27 +6916,20 @@ namespace AkVCam
                         uint8_t yi;
                         uint8_t zi;
                         uint8_t ai;
-                        this->readF8UL3A(fc,
-                                         src_line_x,
-                                         src_line_y,
-                                         src_line_z,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_y_1,
-                                         src_line_z_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &yi,
-                                         &zi,
-                                         &ai);
+                        this->readUL3A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &yi,
+                                       &zi,
+                                       &ai);
 
                         int64_t xo = 0;
-                        fc.colorConvert.applyPoint(xi,
-                                                   yi,
-                                                   zi,
-                                                   &xo);
+                        fc.colorConvert.applyPoint8bits(xi,
+                                                        yi,
+                                                        zi,
+                                                        &xo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_a[fc.dstWidthOffsetA[x]] = ai;
@@ -6386,14 +6942,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1to3(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6403,9 +6959,8 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
-                        this->readUL1(fc,
-                                      src_line_x,
-                                      src_line_x_1,
+                        this->readUL1(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi);
@@ -6429,14 +6984,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1to3(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6446,12 +7001,11 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
-                        this->readF8UL1(fc,
-                                        src_line_x,
-                                        src_line_x_1,
-                                        x,
-                                        ky,
-                                        &xi);
+                        this->readUL1(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -6468,14 +7022,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1to3A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6486,9 +7040,8 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
-                        this->readUL1(fc,
-                                      src_line_x,
-                                      src_line_x_1,
+                        this->readUL1(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi);
@@ -6513,14 +7066,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1to3A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6531,12 +7084,11 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
-                        this->readF8UL1(fc,
-                                        src_line_x,
-                                        src_line_x_1,
-                                        x,
-                                        ky,
-                                        &xi);
+                        this->readUL1(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -6554,16 +7106,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1Ato3(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6574,11 +7124,8 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
                         InputType ai;
-                        this->readUL1A(fc,
-                                       src_line_x,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -6588,7 +7135,7 @@ namespace AkVCam
                         int64_t yo = 0;
                         int64_t zo = 0;
                         fc.colorConvert.applyPoint(xi, &xo, &yo, &zo);
-                        fc.colorConvert.applyAlpha(xi, &xo, &yo, &zo);
+                        fc.colorConvert.applyAlpha(ai, &xo, &yo, &zo);
 
                         this->write3(fc,
                                      dst_line_x,
@@ -6604,16 +7151,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1Ato3(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6624,21 +7169,18 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
                         uint8_t ai;
-                        this->readF8UL1A(fc,
-                                         src_line_x,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &ai);
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &ai);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
                         int64_t zo = 0;
                         fc.colorConvert.applyPoint(xi, &xo, &yo, &zo);
-                        fc.colorConvert.applyAlpha(xi, &xo, &yo, &zo);
+                        fc.colorConvert.applyAlpha(ai, &xo, &yo, &zo);
 
                         dst_line_x[fc.dstWidthOffsetX[x]] = uint8_t(xo);
                         dst_line_y[fc.dstWidthOffsetY[x]] = uint8_t(yo);
@@ -6650,16 +7192,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1Ato3A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6671,11 +7211,8 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
                         InputType ai;
-                        this->readUL1A(fc,
-                                       src_line_x,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -6702,16 +7239,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1Ato3A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_y = dst.line(fc.planeYo, y) + fc.yoOffset;
@@ -6723,15 +7258,12 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
                         uint8_t ai;
-                        this->readF8UL1A(fc,
-                                         src_line_x,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &ai);
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &ai);
 
                         int64_t xo = 0;
                         int64_t yo = 0;
@@ -6751,14 +7283,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1to1(const FrameConvertParameters &fc,
                                const VideoFrame &src,
-                               VideoFrame &dst) const
+                               VideoFrame &dst,
+                               int ymin,
+                               int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -6766,9 +7298,8 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
-                        this->readUL1(fc,
-                                      src_line_x,
-                                      src_line_x_1,
+                        this->readUL1(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi);
@@ -6786,14 +7317,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1to1(const FrameConvertParameters &fc,
                                         const VideoFrame &src,
-                                        VideoFrame &dst) const
+                                        VideoFrame &dst,
+                                        int ymin,
+                                        int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -6801,12 +7332,11 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
-                        this->readF8UL1(fc,
-                                        src_line_x,
-                                        src_line_x_1,
-                                        x,
-                                        ky,
-                                        &xi);
+                        this->readUL1(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi);
 
                         int64_t xo = 0;
                         fc.colorConvert.applyPoint(xi, &xo);
@@ -6819,14 +7349,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1to1A(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6835,9 +7365,8 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
-                        this->readUL1(fc,
-                                      src_line_x,
-                                      src_line_x_1,
+                        this->readUL1(cache.line,
+                                      cache.line_1,
                                       x,
                                       ky,
                                       &xi);
@@ -6856,14 +7385,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1to1A(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(1 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6872,12 +7401,11 @@ namespace AkVCam
 
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
-                        this->readF8UL1(fc,
-                                        src_line_x,
-                                        src_line_x_1,
-                                        x,
-                                        ky,
-                                        &xi);
+                        this->readUL1(cache.line,
+                                      cache.line_1,
+                                      x,
+                                      ky,
+                                      &xi);
 
                         int64_t xo = 0;
                         fc.colorConvert.applyPoint(xi, &xo);
@@ -6891,16 +7419,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1Ato1(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst) const
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -6909,11 +7435,8 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
                         InputType ai;
-                        this->readUL1A(fc,
-                                       src_line_x,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -6933,16 +7456,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1Ato1(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst) const
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
 
@@ -6951,15 +7472,12 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
                         uint8_t ai;
-                        this->readF8UL1A(fc,
-                                         src_line_x,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &ai);
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &ai);
 
                         int64_t xo = 0;
                         fc.colorConvert.applyPoint(xi, &xo);
@@ -6973,16 +7491,14 @@ namespace AkVCam
             template <typename InputType, typename OutputType>
             void convertUL1Ato1A(const FrameConvertParameters &fc,
                                  const VideoFrame &src,
-                                 VideoFrame &dst) const
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateUL1A<InputType>(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -6992,11 +7508,8 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         InputType xi;
                         InputType ai;
-                        this->readUL1A(fc,
-                                       src_line_x,
-                                       src_line_a,
-                                       src_line_x_1,
-                                       src_line_a_1,
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
                                        x,
                                        ky,
                                        &xi,
@@ -7017,16 +7530,14 @@ namespace AkVCam
 
             void convertFast8bitsUL1Ato1A(const FrameConvertParameters &fc,
                                           const VideoFrame &src,
-                                          VideoFrame &dst) const
+                                          VideoFrame &dst,
+                                          int ymin,
+                                          int ymax) const
             {
-                for (int y = fc.ymin; y < fc.ymax; ++y) {
-                    auto &ys = fc.srcHeight[y];
-                    auto &ys_1 = fc.srcHeight_1[y];
+                LineCache cache(2 * size_t(fc.outputConvertFormat.width()));
 
-                    auto src_line_x = src.constLine(fc.planeXi, ys) + fc.xiOffset;
-                    auto src_line_a = src.constLine(fc.planeAi, ys) + fc.aiOffset;
-                    auto src_line_x_1 = src.constLine(fc.planeXi, ys_1) + fc.xiOffset;
-                    auto src_line_a_1 = src.constLine(fc.planeAi, ys_1) + fc.aiOffset;
+                for (int y = ymin; y < ymax; ++y) {
+                    this->updateF8UL1A(fc, src, y, cache);
 
                     auto dst_line_x = dst.line(fc.planeXo, y) + fc.xoOffset;
                     auto dst_line_a = dst.line(fc.planeAo, y) + fc.aoOffset;
@@ -7036,15 +7547,12 @@ namespace AkVCam
                     for (int x = fc.xmin; x < fc.xmax; ++x) {
                         uint8_t xi;
                         uint8_t ai;
-                        this->readF8UL1A(fc,
-                                         src_line_x,
-                                         src_line_a,
-                                         src_line_x_1,
-                                         src_line_a_1,
-                                         x,
-                                         ky,
-                                         &xi,
-                                         &ai);
+                        this->readUL1A(cache.line,
+                                       cache.line_1,
+                                       x,
+                                       ky,
+                                       &xi,
+                                       &ai);
 
                         int64_t xo = 0;
                         fc.colorConvert.applyPoint(xi, &xo);
@@ -7059,20 +7567,22 @@ namespace AkVCam
             template <typename InputType, typename OutputType> \
             inline void convertFormat##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                     const VideoFrame &src, \
-                                                                    VideoFrame &dst) const \
+                                                                    VideoFrame &dst, \
+                                                                    int ymin, \
+                                                                    int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convert##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convert##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convert##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convert##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convert##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convert##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convert##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convert##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7080,20 +7590,22 @@ namespace AkVCam
     #define CONVERT_FAST_FUNC(icomponents, ocomponents) \
             inline void convertFormatFast8bits##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                              const VideoFrame &src, \
-                                                                             VideoFrame &dst) const \
+                                                                             VideoFrame &dst, \
+                                                                             int ymin, \
+                                                                             int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertFast8bits##icomponents##Ato##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bits##icomponents##Ato##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertFast8bits##icomponents##Ato##ocomponents(fc, src, dst); \
+                    this->convertFast8bits##icomponents##Ato##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertFast8bits##icomponents##to##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bits##icomponents##to##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertFast8bits##icomponents##to##ocomponents(fc, src, dst); \
+                    this->convertFast8bits##icomponents##to##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7102,20 +7614,22 @@ namespace AkVCam
             template <typename InputType, typename OutputType> \
             inline void convertVFormat##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                      const VideoFrame &src, \
-                                                                     VideoFrame &dst) const \
+                                                                     VideoFrame &dst, \
+                                                                     int ymin, \
+                                                                     int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertV##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertV##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertV##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertV##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertV##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertV##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertV##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertV##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7123,146 +7637,118 @@ namespace AkVCam
     #define CONVERT_FASTV_FUNC(icomponents, ocomponents) \
             inline void convertFormatFast8bitsV##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                               const VideoFrame &src, \
-                                                                              VideoFrame &dst) const \
+                                                                              VideoFrame &dst, \
+                                                                              int ymin, \
+                                                                              int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertFast8bitsV##icomponents##Ato##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsV##icomponents##Ato##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertFast8bitsV##icomponents##Ato##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsV##icomponents##Ato##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertFast8bitsV##icomponents##to##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsV##icomponents##to##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertFast8bitsV##icomponents##to##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsV##icomponents##to##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
 
     #define CONVERTDL_FUNC(icomponents, ocomponents) \
-            template <typename InputType, typename OutputType> \
+            template <typename InputType, typename OutputType, typename SumType> \
             inline void convertFormatDL##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                       const VideoFrame &src, \
-                                                                      VideoFrame &dst) const \
+                                                                      VideoFrame &dst, \
+                                                                      int ymin, \
+                                                                      int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                case ConvertAlphaMode_AI_O: \
-                    this->integralImage##icomponents##A<InputType>(fc, src); \
-                    break; \
-                default: \
-                    this->integralImage##icomponents<InputType>(fc, src); \
-                    break; \
-                } \
-                \
-                switch (fc.alphaMode) { \
-                case ConvertAlphaMode_AI_AO: \
-                    this->convertDL##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertDL##icomponents##Ato##ocomponents##A<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertDL##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertDL##icomponents##Ato##ocomponents<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertDL##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertDL##icomponents##to##ocomponents##A<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertDL##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertDL##icomponents##to##ocomponents<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
 
     #define CONVERT_FASTDL_FUNC(icomponents, ocomponents) \
+            template <typename SumType> \
             inline void convertFormatFast8bitsDL##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                                const VideoFrame &src, \
-                                                                               VideoFrame &dst) const \
+                                                                               VideoFrame &dst, \
+                                                                               int ymin, \
+                                                                               int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                case ConvertAlphaMode_AI_O: \
-                    this->integralImage##icomponents##A<uint8_t>(fc, src); \
-                    break; \
-                default: \
-                    this->integralImage##icomponents<uint8_t>(fc, src); \
-                    break; \
-                } \
-                \
-                switch (fc.alphaMode) { \
-                case ConvertAlphaMode_AI_AO: \
-                    this->convertFast8bitsDL##icomponents##Ato##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsDL##icomponents##Ato##ocomponents##A<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertFast8bitsDL##icomponents##Ato##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsDL##icomponents##Ato##ocomponents<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertFast8bitsDL##icomponents##to##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsDL##icomponents##to##ocomponents##A<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertFast8bitsDL##icomponents##to##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsDL##icomponents##to##ocomponents<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
 
     #define CONVERTDLV_FUNC(icomponents, ocomponents) \
-            template <typename InputType, typename OutputType> \
+            template <typename InputType, typename OutputType, typename SumType> \
             inline void convertFormatDLV##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                        const VideoFrame &src, \
-                                                                       VideoFrame &dst) const \
+                                                                       VideoFrame &dst, \
+                                                                       int ymin, \
+                                                                       int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                case ConvertAlphaMode_AI_O: \
-                    this->integralImage##icomponents##A<InputType>(fc, src); \
-                    break; \
-                default: \
-                    this->integralImage##icomponents<InputType>(fc, src); \
-                    break; \
-                } \
-                \
-                switch (fc.alphaMode) { \
-                case ConvertAlphaMode_AI_AO: \
-                    this->convertDLV##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertDLV##icomponents##Ato##ocomponents##A<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertDLV##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertDLV##icomponents##Ato##ocomponents<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertDLV##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertDLV##icomponents##to##ocomponents##A<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertDLV##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertDLV##icomponents##to##ocomponents<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
 
     #define CONVERT_FASTDLV_FUNC(icomponents, ocomponents) \
+            template <typename SumType> \
             inline void convertFormatFast8bitsDLV##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                                 const VideoFrame &src, \
-                                                                                VideoFrame &dst) const \
+                                                                                VideoFrame &dst, \
+                                                                                int ymin, \
+                                                                                int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                case ConvertAlphaMode_AI_O: \
-                    this->integralImage##icomponents##A<uint8_t>(fc, src); \
-                    break; \
-                default: \
-                    this->integralImage##icomponents<uint8_t>(fc, src); \
-                    break; \
-                } \
-                \
-                switch (fc.alphaMode) { \
-                case ConvertAlphaMode_AI_AO: \
-                    this->convertFast8bitsDLV##icomponents##Ato##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsDLV##icomponents##Ato##ocomponents##A<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertFast8bitsDLV##icomponents##Ato##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsDLV##icomponents##Ato##ocomponents<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertFast8bitsDLV##icomponents##to##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsDLV##icomponents##to##ocomponents##A<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertFast8bitsDLV##icomponents##to##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsDLV##icomponents##to##ocomponents<SumType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7271,20 +7757,22 @@ namespace AkVCam
             template <typename InputType, typename OutputType> \
             inline void convertFormatUL##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                       const VideoFrame &src, \
-                                                                      VideoFrame &dst) const \
+                                                                      VideoFrame &dst, \
+                                                                      int ymin, \
+                                                                      int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertUL##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertUL##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertUL##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertUL##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertUL##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertUL##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertUL##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertUL##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7292,20 +7780,22 @@ namespace AkVCam
     #define CONVERT_FASTUL_FUNC(icomponents, ocomponents) \
             inline void convertFormatFast8bitsUL##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                                const VideoFrame &src, \
-                                                                               VideoFrame &dst) const \
+                                                                               VideoFrame &dst, \
+                                                                               int ymin, \
+                                                                               int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertFast8bitsUL##icomponents##Ato##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsUL##icomponents##Ato##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertFast8bitsUL##icomponents##Ato##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsUL##icomponents##Ato##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertFast8bitsUL##icomponents##to##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsUL##icomponents##to##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertFast8bitsUL##icomponents##to##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsUL##icomponents##to##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7314,20 +7804,22 @@ namespace AkVCam
             template <typename InputType, typename OutputType> \
             inline void convertFormatULV##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                        const VideoFrame &src, \
-                                                                       VideoFrame &dst) const \
+                                                                       VideoFrame &dst, \
+                                                                       int ymin, \
+                                                                       int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertULV##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertULV##icomponents##Ato##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertULV##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertULV##icomponents##Ato##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertULV##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst); \
+                    this->convertULV##icomponents##to##ocomponents##A<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertULV##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst); \
+                    this->convertULV##icomponents##to##ocomponents<InputType, OutputType>(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7335,20 +7827,22 @@ namespace AkVCam
     #define CONVERT_FASTULV_FUNC(icomponents, ocomponents) \
             inline void convertFormatFast8bitsULV##icomponents##to##ocomponents(const FrameConvertParameters &fc, \
                                                                                 const VideoFrame &src, \
-                                                                                VideoFrame &dst) const \
+                                                                                VideoFrame &dst, \
+                                                                                int ymin, \
+                                                                                int ymax) const \
             { \
                 switch (fc.alphaMode) { \
                 case ConvertAlphaMode_AI_AO: \
-                    this->convertFast8bitsULV##icomponents##Ato##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsULV##icomponents##Ato##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_AI_O: \
-                    this->convertFast8bitsULV##icomponents##Ato##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsULV##icomponents##Ato##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_AO: \
-                    this->convertFast8bitsULV##icomponents##to##ocomponents##A(fc, src, dst); \
+                    this->convertFast8bitsULV##icomponents##to##ocomponents##A(fc, src, dst, ymin, ymax); \
                     break; \
                 case ConvertAlphaMode_I_O: \
-                    this->convertFast8bitsULV##icomponents##to##ocomponents(fc, src, dst); \
+                    this->convertFast8bitsULV##icomponents##to##ocomponents(fc, src, dst, ymin, ymax); \
                     break; \
                 }; \
             }
@@ -7385,167 +7879,1106 @@ namespace AkVCam
             CONVERT_FASTUL_FUNC(1, 1)
             CONVERT_FASTULV_FUNC(3, 3)
 
+            template <typename InputType, typename OutputType, typename SumType>
+            inline void convertDL(const FrameConvertParameters &fc,
+                                  const VideoFrame &src,
+                                  VideoFrame &dst,
+                                  int ymin,
+                                  int ymax)
+            {
+                switch (fc.convertType) {
+                case ConvertType_Vector:
+                    this->convertFormatDLV3to3<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_3to3:
+                    this->convertFormatDL3to3<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_3to1:
+                    this->convertFormatDL3to1<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_1to3:
+                    this->convertFormatDL1to3<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_1to1:
+                    this->convertFormatDL1to1<InputType, OutputType, SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                }
+            }
+
             template <typename InputType, typename OutputType>
             inline void convert(const FrameConvertParameters &fc,
                                 const VideoFrame &src,
-                                VideoFrame &dst)
+                                VideoFrame &dst,
+                                int ymin,
+                                int ymax)
             {
                 if (this->m_scalingMode == AkVCam::VideoConverter::ScalingMode_Linear
                     && fc.resizeMode == ResizeMode_Up) {
                     switch (fc.convertType) {
                     case ConvertType_Vector:
-                        this->convertFormatULV3to3<InputType, OutputType>(fc, src, dst);
+                        this->convertFormatULV3to3<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to3:
-                        this->convertFormatUL3to3<InputType, OutputType>(fc, src, dst);
+                        this->convertFormatUL3to3<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to1:
-                        this->convertFormatUL3to1<InputType, OutputType>(fc, src, dst);
+                        this->convertFormatUL3to1<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to3:
-                        this->convertFormatUL1to3<InputType, OutputType>(fc, src, dst);
+                        this->convertFormatUL1to3<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to1:
-                        this->convertFormatUL1to1<InputType, OutputType>(fc, src, dst);
+                        this->convertFormatUL1to1<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     }
                 } else if (this->m_scalingMode == AkVCam::VideoConverter::ScalingMode_Linear
                            && fc.resizeMode == ResizeMode_Down) {
-                    switch (fc.convertType) {
-                    case ConvertType_Vector:
-                        this->convertFormatDLV3to3<InputType, OutputType>(fc, src, dst);
-                        break;
-                    case ConvertType_3to3:
-                        this->convertFormatDL3to3<InputType, OutputType>(fc, src, dst);
-                        break;
-                    case ConvertType_3to1:
-                        this->convertFormatDL3to1<InputType, OutputType>(fc, src, dst);
+                    switch (fc.dlSumType) {
+                    case DlSumType_32:
+                        this->convertDL<InputType, OutputType, uint32_t>(fc, src, dst, ymin, ymax);
                         break;
-                    case ConvertType_1to3:
-                        this->convertFormatDL1to3<InputType, OutputType>(fc, src, dst);
+                    case DlSumType_64:
+                        this->convertDL<InputType, OutputType, uint64_t>(fc, src, dst, ymin, ymax);
                         break;
-                    case ConvertType_1to1:
-                        this->convertFormatDL1to1<InputType, OutputType>(fc, src, dst);
+                    case DlSumType_Double:
+                        this->convertDL<InputType, OutputType, double>(fc, src, dst, ymin, ymax);
                         break;
                     }
                 } else {
                     switch (fc.convertType) {
                     case ConvertType_Vector:
-                        this->convertVFormat3to3<InputType, OutputType>(fc, src, dst);
+                        this->convertVFormat3to3<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to3:
-                        this->convertFormat3to3<InputType, OutputType>(fc, src, dst);
+                        this->convertFormat3to3<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to1:
-                        this->convertFormat3to1<InputType, OutputType>(fc, src, dst);
+                        this->convertFormat3to1<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to3:
-                        this->convertFormat1to3<InputType, OutputType>(fc, src, dst);
+                        this->convertFormat1to3<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to1:
-                        this->convertFormat1to1<InputType, OutputType>(fc, src, dst);
+                        this->convertFormat1to1<InputType, OutputType>(fc, src, dst, ymin, ymax);
                         break;
                     }
                 }
             }
 
+            template <typename SumType>
+            inline void convertFast8bitsDL(const FrameConvertParameters &fc,
+                                           const VideoFrame &src,
+                                           VideoFrame &dst,
+                                           int ymin,
+                                           int ymax)
+            {
+                switch (fc.convertType) {
+                case ConvertType_Vector:
+                    this->convertFormatFast8bitsDLV3to3<SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_3to3:
+                    this->convertFormatFast8bitsDL3to3<SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_3to1:
+                    this->convertFormatFast8bitsDL3to1<SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_1to3:
+                    this->convertFormatFast8bitsDL1to3<SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                case ConvertType_1to1:
+                    this->convertFormatFast8bitsDL1to1<SumType>(fc, src, dst, ymin, ymax);
+                    break;
+                }
+            }
+
             inline void convertFast8bits(const FrameConvertParameters &fc,
                                          const VideoFrame &src,
-                                         VideoFrame &dst)
+                                         VideoFrame &dst,
+                                         int ymin,
+                                         int ymax)
             {
                 if (this->m_scalingMode == AkVCam::VideoConverter::ScalingMode_Linear
                     && fc.resizeMode == ResizeMode_Up) {
                     switch (fc.convertType) {
                     case ConvertType_Vector:
-                        this->convertFormatFast8bitsULV3to3(fc, src, dst);
+                        this->convertFormatFast8bitsULV3to3(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to3:
-                        this->convertFormatFast8bitsUL3to3(fc, src, dst);
+                        this->convertFormatFast8bitsUL3to3(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to1:
-                        this->convertFormatFast8bitsUL3to1(fc, src, dst);
+                        this->convertFormatFast8bitsUL3to1(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to3:
-                        this->convertFormatFast8bitsUL1to3(fc, src, dst);
+                        this->convertFormatFast8bitsUL1to3(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to1:
-                        this->convertFormatFast8bitsUL1to1(fc, src, dst);
+                        this->convertFormatFast8bitsUL1to1(fc, src, dst, ymin, ymax);
                         break;
                     }
                 } else if (this->m_scalingMode == AkVCam::VideoConverter::ScalingMode_Linear
                            && fc.resizeMode == ResizeMode_Down) {
-                    switch (fc.convertType) {
-                    case ConvertType_Vector:
-                        this->convertFormatFast8bitsDLV3to3(fc, src, dst);
-                        break;
-                    case ConvertType_3to3:
-                        this->convertFormatFast8bitsDL3to3(fc, src, dst);
-                        break;
-                    case ConvertType_3to1:
-                        this->convertFormatFast8bitsDL3to1(fc, src, dst);
+                    switch (fc.dlSumType) {
+                    case DlSumType_32:
+                        this->convertFast8bitsDL<uint32_t>(fc, src, dst, ymin, ymax);
                         break;
-                    case ConvertType_1to3:
-                        this->convertFormatFast8bitsDL1to3(fc, src, dst);
+                    case DlSumType_64:
+                        this->convertFast8bitsDL<uint64_t>(fc, src, dst, ymin, ymax);
                         break;
-                    case ConvertType_1to1:
-                        this->convertFormatFast8bitsDL1to1(fc, src, dst);
+                    case DlSumType_Double:
+                        this->convertFast8bitsDL<double>(fc, src, dst, ymin, ymax);
                         break;
                     }
                 } else {
                     switch (fc.convertType) {
                     case ConvertType_Vector:
-                        this->convertFormatFast8bitsV3to3(fc, src, dst);
+                        this->convertFormatFast8bitsV3to3(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to3:
-                        this->convertFormatFast8bits3to3(fc, src, dst);
+                        this->convertFormatFast8bits3to3(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_3to1:
-                        this->convertFormatFast8bits3to1(fc, src, dst);
+                        this->convertFormatFast8bits3to1(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to3:
-                        this->convertFormatFast8bits1to3(fc, src, dst);
+                        this->convertFormatFast8bits1to3(fc, src, dst, ymin, ymax);
                         break;
                     case ConvertType_1to1:
-                        this->convertFormatFast8bits1to1(fc, src, dst);
+                        this->convertFormatFast8bits1to1(fc, src, dst, ymin, ymax);
                         break;
                     }
                 }
             }
 
-            inline VideoFrame convert(const VideoFrame &frame,
-                                         const VideoFormat &oformat);
-    };
-}
+            /* Split the [ymin, ymax) range in stripes and convert them in
+             * the worker pool.
+             *
+             * The stripe boundaries are aligned to the vertical subsampling of
+             * the output, so two threads never write the same chroma line.
+             */
+            template <typename ConvertFunction>
+            inline void convertStripes(const FrameConvertParameters &fc,
+                                       const VideoFrame &dst,
+                                       ConvertFunction convertStripe)
+            {
+                int height = fc.ymax - fc.ymin;
+                int nStripes = std::min(this->m_workerPool.workers() + 1,
+                                        height / MIN_STRIPE_HEIGHT);
 
-AkVCam::VideoConverter::VideoConverter()
-{
-    this->d = new VideoConverterPrivate();
-}
+                if (nStripes < 2) {
+                    convertStripe(fc.ymin, fc.ymax);
 
-AkVCam::VideoConverter::VideoConverter(const VideoFormat &outputFormat)
-{
-    this->d = new VideoConverterPrivate();
-    this->d->m_outputFormat = outputFormat;
-}
+                    return;
+                }
 
-AkVCam::VideoConverter::VideoConverter(const VideoConverter &other)
-{
-    this->d = new VideoConverterPrivate();
-    this->d->m_outputFormat = other.d->m_outputFormat;
-    this->d->m_yuvColorSpace = other.d->m_yuvColorSpace;
+                size_t heightDiv = 0;
+
+                for (size_t plane = 0; plane < dst.planes(); ++plane)
+                    heightDiv = std::max(heightDiv, dst.heightDiv(plane));
+
+                int alignMask = ~((1 << heightDiv) - 1);
+                auto stripeLimit = [&fc, height, nStripes, alignMask] (int stripe) {
+                    if (stripe >= nStripes)
+                        return fc.ymax;
+
+                    int y = fc.ymin + int(int64_t(height) * stripe / nStripes);
+
+                    return std::max(y & alignMask, fc.ymin);
+                };
+
+                this->m_workerPool.run(nStripes, [&stripeLimit, &convertStripe] (int stripe) {
+                    int ymin = stripeLimit(stripe);
+                    int ymax = stripeLimit(stripe + 1);
+
+                    if (ymin < ymax)
+                        convertStripe(ymin, ymax);
+                });
+            }
+
+            // Returns true if the output can share the input tiles with
+            // other outputs of the same geometry.
+            inline bool canShareTiles(const FrameConvertParameters &fc) const
+            {
+                if (fc.directConvert || !fc.fastConvertion)
+                    return false;
+
+                if (this->m_scalingMode == AkVCam::VideoConverter::ScalingMode_Linear
+                    && fc.resizeMode != ResizeMode_Keep)
+                    return false;
+
+                switch (fc.convertType) {
+                case ConvertType_Vector:
+                    break;
+                case ConvertType_3to3:
+                case ConvertType_3to1:
+                    if (!fc.simdConvertion)
+                        return false;
+
+                    break;
+                default:
+                    return false;
+                }
+
+                return fc.alphaMode != ConvertAlphaMode_AI_O;
+            }
+
+            inline static bool isSameGeometry(const FrameConvertParameters &fc,
+                                               const FrameConvertParameters &other)
+            {
+                return fc.outputConvertFormat.width() == other.outputConvertFormat.width()
+                       && fc.outputConvertFormat.height() == other.outputConvertFormat.height()
+                       && fc.xmin == other.xmin
+                       && fc.xmax == other.xmax
+                       && fc.ymin == other.ymin
+                       && fc.ymax == other.ymax;
+            }
+
+            /* Convert the input frame to all the outputs band by band.
+             *
+             * Each band of input lines is converted to every output before
+             * moving to the next band, so the input lines are read from the
+             * memory once and then reused from the cache by the other
+             * outputs. The bands are mapped to the output lines in
+             * proportion to the output height, and aligned to the vertical
+             * subsampling of the outputs, so the bands can be converted in
+             * parallel.
+             *
+             * The outputs with the same geometry that are converted with
+             * the vector units are grouped, and share the scaling offsets
+             * and the tiles of input components.
+             */
+            inline void convertBands(const VideoFrame &frame,
+                                     const std::vector<FrameConvertTarget> &targets)
+            {
+                if (targets.empty())
+                    return;
+
+                if (targets.size() == 1) {
+                    this->convert(*targets[0].fc, frame, *targets[0].dst);
+
+                    return;
+                }
+
+                for (auto &target: targets) {
+                    target.dst->detach();
+                    target.dst->copyTiming(frame);
+                }
+
+                std::vector<std::vector<const FrameConvertTarget *>> groups;
+
+                for (auto &target: targets) {
+                    bool grouped = false;
+
+                    if (this->canShareTiles(*target.fc))
+                        for (auto &group: groups) {
+                            auto &fc = *group.front()->fc;
+
+                            if (this->canShareTiles(fc)
+                                && isSameGeometry(fc, *target.fc)) {
+                                group.push_back(&target);
+                                grouped = true;
+
+                                break;
+                            }
+                        }
+
+                    if (!grouped)
+                        groups.push_back({&target});
+                }
+
+                std::vector<int> alignMasks;
+
+                for (auto &group: groups) {
+                    size_t heightDiv = 0;
+
+                    for (auto target: group)
+                        for (size_t plane = 0; plane < target->dst->planes(); ++plane)
+                            heightDiv = std::max(heightDiv, target->dst->heightDiv(plane));
+
+                    alignMasks.push_back(~((1 << heightDiv) - 1));
+                }
+
+                int nBands = std::max(frame.format().height() / BAND_HEIGHT, 1);
+
+                auto bandLimit = [nBands] (const FrameConvertParameters &fc,
+                                           int alignMask,
+                                           int band) {
+                    if (band >= nBands)
+                        return fc.ymax;
+
+                    int height = fc.ymax - fc.ymin;
+                    int y = fc.ymin + int(int64_t(height) * band / nBands);
+
+                    return std::max(y & alignMask, fc.ymin);
+                };
+
+                auto convertBandRange = [this,
+                                         &frame,
+                                         &groups,
+                                         &alignMasks,
+                                         &bandLimit] (int firstBand,
+                                                      int lastBand) {
+                    for (int band = firstBand; band < lastBand; ++band)
+                        for (size_t i = 0; i < groups.size(); ++i) {
+                            auto &group = groups[i];
+                            auto &fc = *group.front()->fc;
+                            int ymin = bandLimit(fc, alignMasks[i], band);
+                            int ymax = bandLimit(fc, alignMasks[i], band + 1);
+
+                            if (ymin >= ymax)
+                                continue;
+
+                            if (group.size() > 1)
+                                this->convertFast8bitsSimdShared(group,
+                                                                 frame,
+                                                                 ymin,
+                                                                 ymax);
+                            else
+                                this->convertLines(fc,
+                                                   frame,
+                                                   *group.front()->dst,
+                                                   ymin,
+                                                   ymax);
+                        }
+                };
+
+                int nTasks = std::min(this->m_workerPool.workers() + 1, nBands);
+
+                if (nTasks < 2) {
+                    convertBandRange(0, nBands);
+
+                    return;
+                }
+
+                this->m_workerPool.run(nTasks, [nBands, nTasks, &convertBandRange] (int task) {
+                    convertBandRange(int(int64_t(nBands) * task / nTasks),
+                                     int(int64_t(nBands) * (task + 1) / nTasks));
+                });
+            }
+
+            inline bool isPassThrough(const VideoFormat &iformat,
+                                      const VideoFormat &oformat) const;
+            inline FrameConvertSlot *slot(const VideoFrame &frame,
+                                          const VideoFormat &oformat);
+            inline bool updateSlot(FrameConvertSlot &slot,
+                                   const VideoFrame &frame,
+                                   const VideoFormat &oformat);
+            inline void convertLines(const FrameConvertParameters &fc,
+                                     const VideoFrame &frame,
+                                     VideoFrame &dst,
+                                     int ymin,
+                                     int ymax);
+            inline void convert(const FrameConvertParameters &fc,
+                                const VideoFrame &frame,
+                                VideoFrame &dst);
+            inline VideoFrame convert(const VideoFrame &frame,
+                                      const VideoFormat &oformat);
+            inline bool convert(const VideoFrame &frame,
+                                const VideoFormat &oformat,
+                                uint8_t *const planes[],
+                                const size_t lineSizes[]);
+            inline std::vector<VideoFrame> convert(const VideoFrame &frame,
+                                                   const std::vector<VideoFormat> &oformats);
+            inline bool convert(const VideoFrame &frame,
+                                const std::vector<VideoFormat> &oformats,
+                                uint8_t *const *const planes[],
+                                const size_t *const lineSizes[]);
+            inline static void copyFrame(const VideoFrame &src,
+                                         uint8_t *const planes[],
+                                         const size_t lineSizes[]);
+            inline static void clearPadding(const FrameConvertSlot &slot,
+                                            VideoFrame &dst);
+            inline static void copyBorders(const FrameConvertSlot &slot,
+                                           VideoFrame &dst);
+    };
+
+    /* Direct conversion kernels
+     *
+     * Specialized kernels for the most common format pairs when the frame is
+     * not scaled. The layout of the components is given as template
+     * parameters, so all the offsets and strides are known at compile time.
+     */
+
+    template <int Plane,
+              size_t Offset,
+              size_t Step,
+              int WidthDiv=0,
+              int HeightDiv=0>
+    struct DirectComponent
+    {
+        static constexpr int plane = Plane;
+        static constexpr size_t offset = Offset;
+        static constexpr size_t step = Step;
+        static constexpr int widthDiv = WidthDiv;
+        static constexpr int heightDiv = HeightDiv;
+
+        static inline size_t position(int x)
+        {
+            return size_t(x >> WidthDiv) * Step;
+        }
+    };
+
+    template <VideoFormatSpec::VideoFormatType Type,
+              typename ComponentX,
+              typename ComponentY,
+              typename ComponentZ,
+              typename ComponentA=void>
+    struct DirectFormat
+    {
+        using X = ComponentX;
+        using Y = ComponentY;
+        using Z = ComponentZ;
+        using A = ComponentA;
+
+        static constexpr VideoFormatSpec::VideoFormatType type = Type;
+        static constexpr bool hasAlpha = !std::is_void_v<ComponentA>;
+    };
+
+    using DirectFormatRGB24 = DirectFormat<VideoFormatSpec::VFT_RGB,
+                                           DirectComponent<0, 0, 3>,
+                                           DirectComponent<0, 1, 3>,
+                                           DirectComponent<0, 2, 3>>;
+    using DirectFormatARGB = DirectFormat<VideoFormatSpec::VFT_RGB,
+                                          DirectComponent<0, 1, 4>,
+                                          DirectComponent<0, 2, 4>,
+                                          DirectComponent<0, 3, 4>,
+                                          DirectComponent<0, 0, 4>>;
+    using DirectFormatYUYV = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 2>,
+                                          DirectComponent<0, 1, 4, 1>,
+                                          DirectComponent<0, 3, 4, 1>>;
+    using DirectFormatUYVY = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 1, 2>,
+                                          DirectComponent<0, 0, 4, 1>,
+                                          DirectComponent<0, 2, 4, 1>>;
+    using DirectFormatXRGB = DirectFormat<VideoFormatSpec::VFT_RGB,
+                                          DirectComponent<0, 1, 4>,
+                                          DirectComponent<0, 2, 4>,
+                                          DirectComponent<0, 3, 4>>;
+    using DirectFormatBGR24 = DirectFormat<VideoFormatSpec::VFT_RGB,
+                                           DirectComponent<0, 2, 3>,
+                                           DirectComponent<0, 1, 3>,
+                                           DirectComponent<0, 0, 3>>;
+    using DirectFormatBGRX = DirectFormat<VideoFormatSpec::VFT_RGB,
+                                          DirectComponent<0, 2, 4>,
+                                          DirectComponent<0, 1, 4>,
+                                          DirectComponent<0, 0, 4>>;
+    using DirectFormatBGRA = DirectFormat<VideoFormatSpec::VFT_RGB,
+                                          DirectComponent<0, 2, 4>,
+                                          DirectComponent<0, 1, 4>,
+                                          DirectComponent<0, 0, 4>,
+                                          DirectComponent<0, 3, 4>>;
+    using DirectFormatNV12 = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 1>,
+                                          DirectComponent<1, 0, 2, 1, 1>,
+                                          DirectComponent<1, 1, 2, 1, 1>>;
+    using DirectFormatNV21 = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 1>,
+                                          DirectComponent<1, 1, 2, 1, 1>,
+                                          DirectComponent<1, 0, 2, 1, 1>>;
+    using DirectFormatNV16 = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 1>,
+                                          DirectComponent<1, 0, 2, 1>,
+                                          DirectComponent<1, 1, 2, 1>>;
+    using DirectFormatNV61 = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 1>,
+                                          DirectComponent<1, 1, 2, 1>,
+                                          DirectComponent<1, 0, 2, 1>>;
+    using DirectFormatI420 = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 1>,
+                                          DirectComponent<1, 0, 1, 1, 1>,
+                                          DirectComponent<2, 0, 1, 1, 1>>;
+    using DirectFormatYV12 = DirectFormat<VideoFormatSpec::VFT_YUV,
+                                          DirectComponent<0, 0, 1>,
+                                          DirectComponent<2, 0, 1, 1, 1>,
+                                          DirectComponent<1, 0, 1, 1, 1>>;
+
+    template <typename InputFormat, typename OutputFormat>
+    void convertDirect(const FrameConvertParameters &fc,
+                       const VideoFrame &src,
+                       VideoFrame &dst,
+                       int ymin,
+                       int ymax)
+    {
+        using Xi = typename InputFormat::X;
+        using Yi = typename InputFormat::Y;
+        using Zi = typename InputFormat::Z;
+        using Xo = typename OutputFormat::X;
+        using Yo = typename OutputFormat::Y;
+        using Zo = typename OutputFormat::Z;
+
+        // Components in the same color space are just copied.
+        constexpr bool vector = InputFormat::type == OutputFormat::type;
+        constexpr bool alphaIn = InputFormat::hasAlpha;
+        constexpr bool alphaOut = OutputFormat::hasAlpha;
+
+        static_assert(!(alphaIn && alphaOut),
+                      "Formats with alpha in both sides are not supported");
+
+        for (int y = ymin; y < ymax; ++y) {
+            auto src_line_x = src.constLine(Xi::plane, y) + Xi::offset;
+            auto src_line_y = src.constLine(Yi::plane, y) + Yi::offset;
+            auto src_line_z = src.constLine(Zi::plane, y) + Zi::offset;
+            const uint8_t *src_line_a = nullptr;
+
+            if constexpr (alphaIn) {
+                using Ai = typename InputFormat::A;
+                src_line_a = src.constLine(Ai::plane, y) + Ai::offset;
+            }
+
+            auto dst_line_x = dst.line(Xo::plane, y) + Xo::offset;
+            auto dst_line_y = dst.line(Yo::plane, y) + Yo::offset;
+            auto dst_line_z = dst.line(Zo::plane, y) + Zo::offset;
+            uint8_t *dst_line_a = nullptr;
+
+            if constexpr (alphaOut) {
+                using Ao = typename OutputFormat::A;
+                dst_line_a = dst.line(Ao::plane, y) + Ao::offset;
+            }
+
+            // The copied components only need the vector kernels for
+            // blending the alpha.
+            bool simd = vector?
+                            alphaIn && fc.simdAlphaBlending:
+                            fc.simdConvertion;
+
+            if (simd) {
+                // Gather the components, convert them with the vector
+                // kernels, and scatter them back.
+
+                uint8_t xi[SIMD_TILE_SIZE];
+                uint8_t yi[SIMD_TILE_SIZE];
+                uint8_t zi[SIMD_TILE_SIZE];
+                uint8_t ai[SIMD_TILE_SIZE];
+                uint8_t xo[SIMD_TILE_SIZE];
+                uint8_t yo[SIMD_TILE_SIZE];
+                uint8_t zo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int tileSize = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+
+                    for (int i = 0; i < tileSize; ++i) {
+                        xi[i] = src_line_x[Xi::position(x + i)];
+                        yi[i] = src_line_y[Yi::position(x + i)];
+                        zi[i] = src_line_z[Zi::position(x + i)];
+
+                        if constexpr (alphaIn) {
+                            using Ai = typename InputFormat::A;
+                            ai[i] = src_line_a[Ai::position(x + i)];
+                        }
+                    }
+
+                    uint8_t *xt = xi;
+                    uint8_t *yt = yi;
+                    uint8_t *zt = zi;
+
+                    if constexpr (!vector) {
+                        Simd::matrix3to3(fc.simdColorMatrix,
+                                         xi, yi, zi,
+                                         xo, yo, zo,
+                                         tileSize);
+                        xt = xo;
+                        yt = yo;
+                        zt = zo;
+                    }
+
+                    if constexpr (alphaIn) {
+                        if (fc.simdAlphaBlending) {
+                            Simd::alphaBlend3(fc.simdAlphaMatrix,
+                                              ai,
+                                              xt, yt, zt,
+                                              tileSize);
+                        } else {
+                            for (int i = 0; i < tileSize; ++i) {
+                                int64_t xp = xt[i];
+                                int64_t yp = yt[i];
+                                int64_t zp = zt[i];
+                                fc.colorConvert.applyAlpha(ai[i], &xp, &yp, &zp);
+                                xt[i] = uint8_t(xp);
+                                yt[i] = uint8_t(yp);
+                                zt[i] = uint8_t(zp);
+                            }
+                        }
+                    }
+
+                    for (int i = 0; i < tileSize; ++i) {
+                        dst_line_x[Xo::position(x + i)] = xt[i];
+                        dst_line_y[Yo::position(x + i)] = yt[i];
+                        dst_line_z[Zo::position(x + i)] = zt[i];
+
+                        if constexpr (alphaOut) {
+                            using Ao = typename OutputFormat::A;
+                            dst_line_a[Ao::position(x + i)] = 0xff;
+                        }
+                    }
+                }
+
+                continue;
+            }
+
+            for (int x = fc.xmin; x < fc.xmax; ++x) {
+                int64_t xp = src_line_x[Xi::position(x)];
+                int64_t yp = src_line_y[Yi::position(x)];
+                int64_t zp = src_line_z[Zi::position(x)];
+
+                if constexpr (!vector)
+                    fc.colorConvert.applyMatrix(xp, yp, zp, &xp, &yp, &zp);
+
+                if constexpr (alphaIn) {
+                    using Ai = typename InputFormat::A;
+                    auto ai = src_line_a[Ai::position(x)];
+                    fc.colorConvert.applyAlpha(ai, &xp, &yp, &zp);
+                }
+
+                dst_line_x[Xo::position(x)] = uint8_t(xp);
+                dst_line_y[Yo::position(x)] = uint8_t(yp);
+                dst_line_z[Zo::position(x)] = uint8_t(zp);
+
+                if constexpr (alphaOut) {
+                    using Ao = typename OutputFormat::A;
+                    dst_line_a[Ao::position(x)] = 0xff;
+                }
+            }
+        }
+    }
+
+    /* RGB to subsampled YUV kernels
+     *
+     * The luma is calculated for every pixel, but the chroma is calculated
+     * only once for every block of pixels sharing the same chroma sample
+     * (2x1 for 4:2:2, 2x2 for 4:2:0), from the average of the RGB components
+     * of the block. The alpha of the block is averaged the same way.
+     */
+    template <typename InputFormat, typename OutputFormat>
+    void convertDirectSubsampled(const FrameConvertParameters &fc,
+                                 const VideoFrame &src,
+                                 VideoFrame &dst,
+                                 int ymin,
+                                 int ymax)
+    {
+        using Xi = typename InputFormat::X;
+        using Yi = typename InputFormat::Y;
+        using Zi = typename InputFormat::Z;
+        using Xo = typename OutputFormat::X;
+        using Yo = typename OutputFormat::Y;
+        using Zo = typename OutputFormat::Z;
+
+        constexpr bool alphaIn = InputFormat::hasAlpha;
+        constexpr int widthDiv = Yo::widthDiv;
+        constexpr int heightDiv = Yo::heightDiv;
+        constexpr int blockWidth = 1 << widthDiv;
+        constexpr int blockHeight = 1 << heightDiv;
+
+        static_assert(InputFormat::type == VideoFormatSpec::VFT_RGB
+                      && OutputFormat::type == VideoFormatSpec::VFT_YUV
+                      && !OutputFormat::hasAlpha,
+                      "Only RGB to YUV without alpha is supported");
+        static_assert(Xo::widthDiv == 0
+                      && Xo::heightDiv == 0
+                      && Zo::widthDiv == widthDiv
+                      && Zo::heightDiv == heightDiv,
+                      "Only the chroma can be subsampled");
+        static_assert(SIMD_TILE_SIZE % blockWidth == 0,
+                      "The tiles must contain whole blocks");
+
+        const uint8_t *src_line_x[blockHeight];
+        const uint8_t *src_line_y[blockHeight];
+        const uint8_t *src_line_z[blockHeight];
+        const uint8_t *src_line_a[blockHeight];
+        uint8_t *dst_line_x[blockHeight];
+
+        // Writes the chroma of the block from the sums of its components.
+        auto writeChroma = [&fc] (uint8_t *dst_line_y,
+                                  uint8_t *dst_line_z,
+                                  int x,
+                                  int n,
+                                  int sumX,
+                                  int sumY,
+                                  int sumZ,
+                                  int sumA) {
+            int64_t xp = (sumX + n / 2) / n;
+            int64_t yp = (sumY + n / 2) / n;
+            int64_t zp = (sumZ + n / 2) / n;
+            fc.colorConvert.applyMatrix(xp, yp, zp, &xp, &yp, &zp);
+
+            if constexpr (alphaIn)
+                fc.colorConvert.applyAlpha((sumA + n / 2) / n, &xp, &yp, &zp);
+
+            dst_line_y[Yo::position(x)] = uint8_t(yp);
+            dst_line_z[Zo::position(x)] = uint8_t(zp);
+        };
+
+        // The stripes are aligned to the blocks, so only the last row of
+        // blocks of the frame can be incomplete.
+        for (int y = ymin; y < ymax; y += blockHeight) {
+            int rows = std::min(blockHeight, ymax - y);
+
+            for (int row = 0; row < rows; ++row) {
+                src_line_x[row] = src.constLine(Xi::plane, y + row) + Xi::offset;
+                src_line_y[row] = src.constLine(Yi::plane, y + row) + Yi::offset;
+                src_line_z[row] = src.constLine(Zi::plane, y + row) + Zi::offset;
+
+                if constexpr (alphaIn) {
+                    using Ai = typename InputFormat::A;
+                    src_line_a[row] = src.constLine(Ai::plane, y + row) + Ai::offset;
+                }
+
+                dst_line_x[row] = dst.line(Xo::plane, y + row) + Xo::offset;
+            }
+
+            auto dst_line_y = dst.line(Yo::plane, y) + Yo::offset;
+            auto dst_line_z = dst.line(Zo::plane, y) + Zo::offset;
+
+            if (fc.simdConvertion) {
+                // Gather the components of every line of the blocks, convert
+                // the luma with the vector kernels, and then convert the
+                // averaged blocks.
+
+                uint8_t xi[blockHeight][SIMD_TILE_SIZE];
+                uint8_t yi[blockHeight][SIMD_TILE_SIZE];
+                uint8_t zi[blockHeight][SIMD_TILE_SIZE];
+                uint8_t ai[blockHeight][SIMD_TILE_SIZE];
+                uint8_t lo[SIMD_TILE_SIZE];
+                uint8_t xb[SIMD_TILE_SIZE];
+                uint8_t yb[SIMD_TILE_SIZE];
+                uint8_t zb[SIMD_TILE_SIZE];
+                uint8_t ab[SIMD_TILE_SIZE];
+                uint8_t xbo[SIMD_TILE_SIZE];
+                uint8_t ybo[SIMD_TILE_SIZE];
+                uint8_t zbo[SIMD_TILE_SIZE];
+
+                for (int x = fc.xmin; x < fc.xmax; x += SIMD_TILE_SIZE) {
+                    int tileSize = std::min(fc.xmax - x, SIMD_TILE_SIZE);
+
+                    for (int row = 0; row < rows; ++row) {
+                        for (int i = 0; i < tileSize; ++i) {
+                            xi[row][i] = src_line_x[row][Xi::position(x + i)];
+                            yi[row][i] = src_line_y[row][Yi::position(x + i)];
+                            zi[row][i] = src_line_z[row][Zi::position(x + i)];
+
+                            if constexpr (alphaIn) {
+                                using Ai = typename InputFormat::A;
+                                ai[row][i] = src_line_a[row][Ai::position(x + i)];
+                            }
+                        }
+
+                        Simd::matrix3to1(fc.simdColorMatrix,
+                                         xi[row], yi[row], zi[row],
+                                         lo,
+                                         tileSize);
+
+                        if constexpr (alphaIn) {
+                            if (fc.simdAlphaBlending) {
+                                Simd::alphaBlend1(fc.simdAlphaMatrix,
+                                                  ai[row],
+                                                  lo,
+                                                  tileSize);
+                            } else {
+                                for (int i = 0; i < tileSize; ++i) {
+                                    int64_t lp = lo[i];
+                                    fc.colorConvert.applyAlpha(ai[row][i], &lp);
+                                    lo[i] = uint8_t(lp);
+                                }
+                            }
+                        }
+
+                        for (int i = 0; i < tileSize; ++i)
+                            dst_line_x[row][Xo::position(x + i)] = lo[i];
+                    }
+
+                    int blocks = tileSize >> widthDiv;
+
+                    if (rows == blockHeight) {
+                        for (int block = 0; block < blocks; ++block) {
+                            int i = block << widthDiv;
+                            int sumX = 0;
+                            int sumY = 0;
+                            int sumZ = 0;
+
+                            for (int row = 0; row < blockHeight; ++row)
+                                for (int col = 0; col < blockWidth; ++col) {
+                                    sumX += xi[row][i + col];
+                                    sumY += yi[row][i + col];
+                                    sumZ += zi[row][i + col];
+                                }
+
+                            constexpr int n = blockWidth * blockHeight;
+                            xb[block] = uint8_t((sumX + n / 2) / n);
+                            yb[block] = uint8_t((sumY + n / 2) / n);
+                            zb[block] = uint8_t((sumZ + n / 2) / n);
+
+                            if constexpr (alphaIn) {
+                                int sumA = 0;
+
+                                for (int row = 0; row < blockHeight; ++row)
+                                    for (int col = 0; col < blockWidth; ++col)
+                                        sumA += ai[row][i + col];
+
+                                ab[block] = uint8_t((sumA + n / 2) / n);
+                            }
+                        }
+
+                        Simd::matrix3to3(fc.simdColorMatrix,
+                                         xb, yb, zb,
+                                         xbo, ybo, zbo,
+                                         blocks);
+
+                        if constexpr (alphaIn) {
+                            if (fc.simdAlphaBlending) {
+                                Simd::alphaBlend3(fc.simdAlphaMatrix,
+                                                  ab,
+                                                  xbo, ybo, zbo,
+                                                  blocks);
+                            } else {
+                                for (int block = 0; block < blocks; ++block) {
+                                    int64_t xp = xbo[block];
+                                    int64_t yp = ybo[block];
+                                    int64_t zp = zbo[block];
+                                    fc.colorConvert.applyAlpha(ab[block],
+                                                               &xp,
+                                                               &yp,
+                                                               &zp);
+                                    ybo[block] = uint8_t(yp);
+                                    zbo[block] = uint8_t(zp);
+                                }
+                            }
+                        }
+
+                        for (int block = 0; block < blocks; ++block) {
+                            int i = block << widthDiv;
+                            dst_line_y[Yo::position(x + i)] = ybo[block];
+                            dst_line_z[Zo::position(x + i)] = zbo[block];
+                        }
+                    } else {
+                        blocks = 0;
+                    }
+
+                    // Incomplete blocks
+
+                    for (int i = blocks << widthDiv; i < tileSize; i += blockWidth) {
+                        int cols = std::min(blockWidth, tileSize - i);
+                        int sumX = 0;
+                        int sumY = 0;
+                        int sumZ = 0;
+                        int sumA = 0;
+
+                        for (int row = 0; row < rows; ++row)
+                            for (int col = 0; col < cols; ++col) {
+                                sumX += xi[row][i + col];
+                                sumY += yi[row][i + col];
+                                sumZ += zi[row][i + col];
+
+                                if constexpr (alphaIn)
+                                    sumA += ai[row][i + col];
+                            }
+
+                        writeChroma(dst_line_y,
+                                    dst_line_z,
+                                    x + i,
+                                    rows * cols,
+                                    sumX,
+                                    sumY,
+                                    sumZ,
+                                    sumA);
+                    }
+                }
+
+                continue;
+            }
+
+            auto convertBlock = [&] (int x, int rows, int cols) {
+                int sumX = 0;
+                int sumY = 0;
+                int sumZ = 0;
+                int sumA = 0;
+
+                for (int row = 0; row < rows; ++row)
+                    for (int col = 0; col < cols; ++col) {
+                        int xi = src_line_x[row][Xi::position(x + col)];
+                        int yi = src_line_y[row][Yi::position(x + col)];
+                        int zi = src_line_z[row][Zi::position(x + col)];
+                        sumX += xi;
+                        sumY += yi;
+                        sumZ += zi;
+
+                        int64_t lp = 0;
+                        fc.colorConvert.applyPoint(xi, yi, zi, &lp);
+
+                        if constexpr (alphaIn) {
+                            using Ai = typename InputFormat::A;
+                            int ai = src_line_a[row][Ai::position(x + col)];
+                            sumA += ai;
+                            fc.colorConvert.applyAlpha(ai, &lp);
+                        }
+
+                        dst_line_x[row][Xo::position(x + col)] = uint8_t(lp);
+                    }
+
+                writeChroma(dst_line_y,
+                            dst_line_z,
+                            x,
+                            rows * cols,
+                            sumX,
+                            sumY,
+                            sumZ,
+                            sumA);
+            };
+
+            int x = fc.xmin;
+
+            // Passing the block size as constants lets the compiler unroll
+            // the loops of the complete blocks.
+            if (rows == blockHeight)
+                for (; x + blockWidth <= fc.xmax; x += blockWidth)
+                    convertBlock(x, blockHeight, blockWidth);
+
+            for (; x < fc.xmax; x += blockWidth)
+                convertBlock(x, rows, std::min(blockWidth, fc.xmax - x));
+        }
+    }
+
+    struct DirectConverter
+    {
+        PixelFormat from;
+        PixelFormat to;
+        DirectConvertFunc convert;
+    };
+
+    static const DirectConverter directConverters[] = {
+        {PixelFormat_argb   , PixelFormat_rgb24  , convertDirect<DirectFormatARGB , DirectFormatRGB24>},
+        {PixelFormat_rgb24  , PixelFormat_argb   , convertDirect<DirectFormatRGB24, DirectFormatARGB>},
+
+        // YUV to RGB
+        {PixelFormat_yuyv422, PixelFormat_rgb24  , convertDirect<DirectFormatYUYV , DirectFormatRGB24>},
+        {PixelFormat_yuyv422, PixelFormat_argb   , convertDirect<DirectFormatYUYV , DirectFormatARGB>},
+        {PixelFormat_yuyv422, PixelFormat_bgrx   , convertDirect<DirectFormatYUYV , DirectFormatBGRX>},
+        {PixelFormat_uyvy422, PixelFormat_rgb24  , convertDirect<DirectFormatUYVY , DirectFormatRGB24>},
+        {PixelFormat_uyvy422, PixelFormat_argb   , convertDirect<DirectFormatUYVY , DirectFormatARGB>},
+        {PixelFormat_uyvy422, PixelFormat_bgrx   , convertDirect<DirectFormatUYVY , DirectFormatBGRX>},
+        {PixelFormat_nv12   , PixelFormat_rgb24  , convertDirect<DirectFormatNV12 , DirectFormatRGB24>},
+        {PixelFormat_nv12   , PixelFormat_argb   , convertDirect<DirectFormatNV12 , DirectFormatARGB>},
+        {PixelFormat_nv12   , PixelFormat_bgrx   , convertDirect<DirectFormatNV12 , DirectFormatBGRX>},
+        {PixelFormat_nv21   , PixelFormat_rgb24  , convertDirect<DirectFormatNV21 , DirectFormatRGB24>},
+        {PixelFormat_nv21   , PixelFormat_argb   , convertDirect<DirectFormatNV21 , DirectFormatARGB>},
+        {PixelFormat_nv21   , PixelFormat_bgrx   , convertDirect<DirectFormatNV21 , DirectFormatBGRX>},
+        {PixelFormat_nv16   , PixelFormat_rgb24  , convertDirect<DirectFormatNV16 , DirectFormatRGB24>},
+        {PixelFormat_nv16   , PixelFormat_argb   , convertDirect<DirectFormatNV16 , DirectFormatARGB>},
+        {PixelFormat_nv16   , PixelFormat_bgrx   , convertDirect<DirectFormatNV16 , DirectFormatBGRX>},
+        {PixelFormat_nv61   , PixelFormat_rgb24  , convertDirect<DirectFormatNV61 , DirectFormatRGB24>},
+        {PixelFormat_nv61   , PixelFormat_argb   , convertDirect<DirectFormatNV61 , DirectFormatARGB>},
+        {PixelFormat_nv61   , PixelFormat_bgrx   , convertDirect<DirectFormatNV61 , DirectFormatBGRX>},
+        {PixelFormat_i420   , PixelFormat_rgb24  , convertDirect<DirectFormatI420 , DirectFormatRGB24>},
+        {PixelFormat_i420   , PixelFormat_argb   , convertDirect<DirectFormatI420 , DirectFormatARGB>},
+        {PixelFormat_i420   , PixelFormat_bgrx   , convertDirect<DirectFormatI420 , DirectFormatBGRX>},
+        {PixelFormat_yv12   , PixelFormat_rgb24  , convertDirect<DirectFormatYV12 , DirectFormatRGB24>},
+        {PixelFormat_yv12   , PixelFormat_argb   , convertDirect<DirectFormatYV12 , DirectFormatARGB>},
+        {PixelFormat_yv12   , PixelFormat_bgrx   , convertDirect<DirectFormatYV12 , DirectFormatBGRX>},
+
+        // YUV to the packed YUV formats and NV12
+        {PixelFormat_nv21   , PixelFormat_yuyv422, convertDirect<DirectFormatNV21 , DirectFormatYUYV>},
+        {PixelFormat_nv21   , PixelFormat_uyvy422, convertDirect<DirectFormatNV21 , DirectFormatUYVY>},
+        {PixelFormat_nv21   , PixelFormat_nv12   , convertDirect<DirectFormatNV21 , DirectFormatNV12>},
+        {PixelFormat_nv16   , PixelFormat_yuyv422, convertDirect<DirectFormatNV16 , DirectFormatYUYV>},
+        {PixelFormat_nv16   , PixelFormat_uyvy422, convertDirect<DirectFormatNV16 , DirectFormatUYVY>},
+        {PixelFormat_nv16   , PixelFormat_nv12   , convertDirect<DirectFormatNV16 , DirectFormatNV12>},
+        {PixelFormat_nv61   , PixelFormat_yuyv422, convertDirect<DirectFormatNV61 , DirectFormatYUYV>},
+        {PixelFormat_nv61   , PixelFormat_uyvy422, convertDirect<DirectFormatNV61 , DirectFormatUYVY>},
+        {PixelFormat_nv61   , PixelFormat_nv12   , convertDirect<DirectFormatNV61 , DirectFormatNV12>},
+        {PixelFormat_i420   , PixelFormat_yuyv422, convertDirect<DirectFormatI420 , DirectFormatYUYV>},
+        {PixelFormat_i420   , PixelFormat_uyvy422, convertDirect<DirectFormatI420 , DirectFormatUYVY>},
+        {PixelFormat_i420   , PixelFormat_nv12   , convertDirect<DirectFormatI420 , DirectFormatNV12>},
+        {PixelFormat_yv12   , PixelFormat_yuyv422, convertDirect<DirectFormatYV12 , DirectFormatYUYV>},
+        {PixelFormat_yv12   , PixelFormat_uyvy422, convertDirect<DirectFormatYV12 , DirectFormatUYVY>},
+        {PixelFormat_yv12   , PixelFormat_nv12   , convertDirect<DirectFormatYV12 , DirectFormatNV12>},
+
+        // RGB to subsampled YUV
+        {PixelFormat_xrgb   , PixelFormat_yuyv422, convertDirectSubsampled<DirectFormatXRGB , DirectFormatYUYV>},
+        {PixelFormat_rgb24  , PixelFormat_yuyv422, convertDirectSubsampled<DirectFormatRGB24, DirectFormatYUYV>},
+        {PixelFormat_argb   , PixelFormat_yuyv422, convertDirectSubsampled<DirectFormatARGB , DirectFormatYUYV>},
+        {PixelFormat_bgrx   , PixelFormat_yuyv422, convertDirectSubsampled<DirectFormatBGRX , DirectFormatYUYV>},
+        {PixelFormat_bgr24  , PixelFormat_yuyv422, convertDirectSubsampled<DirectFormatBGR24, DirectFormatYUYV>},
+        {PixelFormat_bgra   , PixelFormat_yuyv422, convertDirectSubsampled<DirectFormatBGRA , DirectFormatYUYV>},
+        {PixelFormat_xrgb   , PixelFormat_uyvy422, convertDirectSubsampled<DirectFormatXRGB , DirectFormatUYVY>},
+        {PixelFormat_rgb24  , PixelFormat_uyvy422, convertDirectSubsampled<DirectFormatRGB24, DirectFormatUYVY>},
+        {PixelFormat_argb   , PixelFormat_uyvy422, convertDirectSubsampled<DirectFormatARGB , DirectFormatUYVY>},
+        {PixelFormat_bgrx   , PixelFormat_uyvy422, convertDirectSubsampled<DirectFormatBGRX , DirectFormatUYVY>},
+        {PixelFormat_bgr24  , PixelFormat_uyvy422, convertDirectSubsampled<DirectFormatBGR24, DirectFormatUYVY>},
+        {PixelFormat_bgra   , PixelFormat_uyvy422, convertDirectSubsampled<DirectFormatBGRA , DirectFormatUYVY>},
+        {PixelFormat_xrgb   , PixelFormat_nv12   , convertDirectSubsampled<DirectFormatXRGB , DirectFormatNV12>},
+        {PixelFormat_rgb24  , PixelFormat_nv12   , convertDirectSubsampled<DirectFormatRGB24, DirectFormatNV12>},
+        {PixelFormat_argb   , PixelFormat_nv12   , convertDirectSubsampled<DirectFormatARGB , DirectFormatNV12>},
+        {PixelFormat_bgrx   , PixelFormat_nv12   , convertDirectSubsampled<DirectFormatBGRX , DirectFormatNV12>},
+        {PixelFormat_bgr24  , PixelFormat_nv12   , convertDirectSubsampled<DirectFormatBGR24, DirectFormatNV12>},
+        {PixelFormat_bgra   , PixelFormat_nv12   , convertDirectSubsampled<DirectFormatBGRA , DirectFormatNV12>},
+        {PixelFormat_xrgb   , PixelFormat_nv21   , convertDirectSubsampled<DirectFormatXRGB , DirectFormatNV21>},
+        {PixelFormat_rgb24  , PixelFormat_nv21   , convertDirectSubsampled<DirectFormatRGB24, DirectFormatNV21>},
+        {PixelFormat_argb   , PixelFormat_nv21   , convertDirectSubsampled<DirectFormatARGB , DirectFormatNV21>},
+        {PixelFormat_bgrx   , PixelFormat_nv21   , convertDirectSubsampled<DirectFormatBGRX , DirectFormatNV21>},
+        {PixelFormat_bgr24  , PixelFormat_nv21   , convertDirectSubsampled<DirectFormatBGR24, DirectFormatNV21>},
+        {PixelFormat_bgra   , PixelFormat_nv21   , convertDirectSubsampled<DirectFormatBGRA , DirectFormatNV21>},
+        {PixelFormat_xrgb   , PixelFormat_nv16   , convertDirectSubsampled<DirectFormatXRGB , DirectFormatNV16>},
+        {PixelFormat_rgb24  , PixelFormat_nv16   , convertDirectSubsampled<DirectFormatRGB24, DirectFormatNV16>},
+        {PixelFormat_argb   , PixelFormat_nv16   , convertDirectSubsampled<DirectFormatARGB , DirectFormatNV16>},
+        {PixelFormat_bgrx   , PixelFormat_nv16   , convertDirectSubsampled<DirectFormatBGRX , DirectFormatNV16>},
+        {PixelFormat_bgr24  , PixelFormat_nv16   , convertDirectSubsampled<DirectFormatBGR24, DirectFormatNV16>},
+        {PixelFormat_bgra   , PixelFormat_nv16   , convertDirectSubsampled<DirectFormatBGRA , DirectFormatNV16>},
+        {PixelFormat_xrgb   , PixelFormat_nv61   , convertDirectSubsampled<DirectFormatXRGB , DirectFormatNV61>},
+        {PixelFormat_rgb24  , PixelFormat_nv61   , convertDirectSubsampled<DirectFormatRGB24, DirectFormatNV61>},
+        {PixelFormat_argb   , PixelFormat_nv61   , convertDirectSubsampled<DirectFormatARGB , DirectFormatNV61>},
+        {PixelFormat_bgrx   , PixelFormat_nv61   , convertDirectSubsampled<DirectFormatBGRX , DirectFormatNV61>},
+        {PixelFormat_bgr24  , PixelFormat_nv61   , convertDirectSubsampled<DirectFormatBGR24, DirectFormatNV61>},
+        {PixelFormat_bgra   , PixelFormat_nv61   , convertDirectSubsampled<DirectFormatBGRA , DirectFormatNV61>},
+        {PixelFormat_xrgb   , PixelFormat_i420   , convertDirectSubsampled<DirectFormatXRGB , DirectFormatI420>},
+        {PixelFormat_rgb24  , PixelFormat_i420   , convertDirectSubsampled<DirectFormatRGB24, DirectFormatI420>},
+        {PixelFormat_argb   , PixelFormat_i420   , convertDirectSubsampled<DirectFormatARGB , DirectFormatI420>},
+        {PixelFormat_bgrx   , PixelFormat_i420   , convertDirectSubsampled<DirectFormatBGRX , DirectFormatI420>},
+        {PixelFormat_bgr24  , PixelFormat_i420   , convertDirectSubsampled<DirectFormatBGR24, DirectFormatI420>},
+        {PixelFormat_bgra   , PixelFormat_i420   , convertDirectSubsampled<DirectFormatBGRA , DirectFormatI420>},
+        {PixelFormat_xrgb   , PixelFormat_yv12   , convertDirectSubsampled<DirectFormatXRGB , DirectFormatYV12>},
+        {PixelFormat_rgb24  , PixelFormat_yv12   , convertDirectSubsampled<DirectFormatRGB24, DirectFormatYV12>},
+        {PixelFormat_argb   , PixelFormat_yv12   , convertDirectSubsampled<DirectFormatARGB , DirectFormatYV12>},
+        {PixelFormat_bgrx   , PixelFormat_yv12   , convertDirectSubsampled<DirectFormatBGRX , DirectFormatYV12>},
+        {PixelFormat_bgr24  , PixelFormat_yv12   , convertDirectSubsampled<DirectFormatBGR24, DirectFormatYV12>},
+        {PixelFormat_bgra   , PixelFormat_yv12   , convertDirectSubsampled<DirectFormatBGRA , DirectFormatYV12>},
+    };
+
+    inline DirectConvertFunc directConverter(PixelFormat from, PixelFormat to)
+    {
+        for (auto &converter: directConverters)
+            if (converter.from == from && converter.to == to)
+                return converter.convert;
+
+        return nullptr;
+    }
+}
+
+AkVCam::VideoConverter::VideoConverter()
+{
+    this->d = new VideoConverterPrivate();
+}
+
+AkVCam::VideoConverter::VideoConverter(const VideoFormat &outputFormat)
+{
+    this->d = new VideoConverterPrivate();
+    this->d->m_outputFormat = outputFormat;
+}
+
+AkVCam::VideoConverter::VideoConverter(const VideoConverter &other)
+{
+    this->d = new VideoConverterPrivate();
+    this->d->m_outputFormat = other.d->m_outputFormat;
+    this->d->m_yuvColorSpace = other.d->m_yuvColorSpace;
     this->d->m_yuvColorSpaceType = other.d->m_yuvColorSpaceType;
+    this->d->m_alphaMode = other.d->m_alphaMode;
+    this->d->m_backgroundColor = other.d->m_backgroundColor;
     this->d->m_scalingMode = other.d->m_scalingMode;
     this->d->m_aspectRatioMode = other.d->m_aspectRatioMode;
     this->d->m_inputRect = other.d->m_inputRect;
+    this->setThreadCount(other.d->m_threadCount);
 }
 
 AkVCam::VideoConverter::~VideoConverter()
 {
-    if (this->d->m_fc) {
-        delete [] this->d->m_fc;
-        this->d->m_fc = nullptr;
-    }
-
     delete this->d;
 }
 
@@ -7554,10 +8987,13 @@ AkVCam::VideoConverter &AkVCam::VideoConverter::operator =(const VideoConverter
     if (this != &other) {
         this->d->m_yuvColorSpace = other.d->m_yuvColorSpace;
         this->d->m_yuvColorSpaceType = other.d->m_yuvColorSpaceType;
+        this->d->m_alphaMode = other.d->m_alphaMode;
+        this->d->m_backgroundColor = other.d->m_backgroundColor;
         this->d->m_outputFormat = other.d->m_outputFormat;
         this->d->m_scalingMode = other.d->m_scalingMode;
         this->d->m_aspectRatioMode = other.d->m_aspectRatioMode;
         this->d->m_inputRect = other.d->m_inputRect;
+        this->setThreadCount(other.d->m_threadCount);
     }
 
     return *this;
@@ -7578,6 +9014,16 @@ AkVCam::ColorConvert::YuvColorSpaceType AkVCam::VideoConverter::yuvColorSpaceTyp
     return this->d->m_yuvColorSpaceType;
 }
 
+AkVCam::ColorConvert::AlphaMode AkVCam::VideoConverter::alphaMode() const
+{
+    return this->d->m_alphaMode;
+}
+
+uint32_t AkVCam::VideoConverter::backgroundColor() const
+{
+    return this->d->m_backgroundColor;
+}
+
 AkVCam::VideoConverter::ScalingMode AkVCam::VideoConverter::scalingMode() const
 {
     return this->d->m_scalingMode;
@@ -7593,6 +9039,11 @@ AkVCam::Rect AkVCam::VideoConverter::inputRect() const
     return this->d->m_inputRect;
 }
 
+int AkVCam::VideoConverter::threadCount() const
+{
+    return this->d->m_threadCount;
+}
+
 bool AkVCam::VideoConverter::begin()
 {
     this->d->m_cacheIndex = 0;
@@ -7600,205 +9051,642 @@ bool AkVCam::VideoConverter::begin()
     return true;
 }
 
-void AkVCam::VideoConverter::end()
-{
-    this->d->m_cacheIndex = 0;
-}
+void AkVCam::VideoConverter::end()
+{
+    this->d->m_cacheIndex = 0;
+}
+
+AkVCam::VideoFrame AkVCam::VideoConverter::convert(const VideoFrame &frame)
+{
+    if (!frame)
+        return {};
+
+    if (this->d->isPassThrough(frame.format(), this->d->m_outputFormat))
+        return frame;
+
+    return this->d->convert(frame, this->d->m_outputFormat);
+}
+
+bool AkVCam::VideoConverter::convert(const VideoFrame &frame,
+                                     uint8_t *const planes[],
+                                     const size_t lineSizes[])
+{
+    if (!frame)
+        return false;
+
+    if (this->d->isPassThrough(frame.format(), this->d->m_outputFormat)) {
+        VideoConverterPrivate::copyFrame(frame, planes, lineSizes);
+
+        return true;
+    }
+
+    return this->d->convert(frame, this->d->m_outputFormat, planes, lineSizes);
+}
+
+std::vector<AkVCam::VideoFrame> AkVCam::VideoConverter::convert(const VideoFrame &frame,
+                                                                const std::vector<VideoFormat> &outputFormats)
+{
+    if (!frame)
+        return {};
+
+    return this->d->convert(frame, outputFormats);
+}
+
+bool AkVCam::VideoConverter::convert(const VideoFrame &frame,
+                                     const std::vector<VideoFormat> &outputFormats,
+                                     uint8_t *const *const planes[],
+                                     const size_t *const lineSizes[])
+{
+    if (!frame)
+        return false;
+
+    return this->d->convert(frame, outputFormats, planes, lineSizes);
+}
+
+void AkVCam::VideoConverter::setCacheIndex(int index)
+{
+    this->d->m_cacheIndex = index;
+}
+
+void AkVCam::VideoConverter::setOutputFormat(const VideoFormat &outputFormat)
+{
+    this->d->m_mutex.lock();
+    this->d->m_outputFormat = outputFormat;
+    this->d->m_mutex.unlock();
+}
+
+void AkVCam::VideoConverter::setYuvColorSpace(AkVCam::ColorConvert::YuvColorSpace yuvColorSpace)
+{
+    this->d->m_yuvColorSpace = yuvColorSpace;
+}
+
+void AkVCam::VideoConverter::setYuvColorSpaceType(AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType)
+{
+    this->d->m_yuvColorSpaceType = yuvColorSpaceType;
+}
+
+void AkVCam::VideoConverter::setAlphaMode(AkVCam::ColorConvert::AlphaMode alphaMode)
+{
+    this->d->m_alphaMode = alphaMode;
+}
+
+void AkVCam::VideoConverter::setBackgroundColor(uint32_t backgroundColor)
+{
+    this->d->m_backgroundColor = backgroundColor;
+}
+
+void AkVCam::VideoConverter::setScalingMode(AkVCam::VideoConverter::ScalingMode scalingMode)
+{
+    this->d->m_scalingMode = scalingMode;
+}
+
+void AkVCam::VideoConverter::setAspectRatioMode(AkVCam::VideoConverter::AspectRatioMode aspectRatioMode)
+{
+    this->d->m_aspectRatioMode = aspectRatioMode;
+}
+
+void AkVCam::VideoConverter::setInputRect(const Rect &inputRect)
+{
+    this->d->m_inputRect = inputRect;
+}
+
+void AkVCam::VideoConverter::setThreadCount(int threadCount)
+{
+    if (threadCount < 1)
+        threadCount = std::max<int>(int(std::thread::hardware_concurrency()), 1);
+
+    this->d->m_threadCount = threadCount;
+    this->d->m_workerPool.setWorkers(threadCount - 1);
+}
+
+void AkVCam::VideoConverter::reset()
+{
+    this->d->m_slots.clear();
+}
+
+#define DEFINE_CASE_SM(sm) \
+    case AkVCam::VideoConverter::sm: \
+        os << #sm; \
+        \
+        break;
+
+std::ostream &operator <<(std::ostream &os, AkVCam::VideoConverter::ScalingMode mode)
+{
+    switch (mode) {
+    DEFINE_CASE_SM(ScalingMode_Fast)
+    DEFINE_CASE_SM(ScalingMode_Linear)
+
+    default:
+        os << "ScalingMode_Unknown";
+
+        break;
+    }
+
+    return os;
+}
+
+#define DEFINE_CASE_ARM(arm) \
+    case AkVCam::VideoConverter::arm: \
+        os << #arm; \
+        \
+        break;
+
+std::ostream &operator <<(std::ostream &os, AkVCam::VideoConverter::AspectRatioMode mode)
+{
+    switch (mode) {
+    DEFINE_CASE_ARM(AspectRatioMode_Ignore)
+    DEFINE_CASE_ARM(AspectRatioMode_Keep)
+    DEFINE_CASE_ARM(AspectRatioMode_Expanding)
+    DEFINE_CASE_ARM(AspectRatioMode_Fit)
+
+    default:
+        os << "AspectRatioMode_Unknown";
+
+        break;
+    }
+
+    return os;
+}
+
+#define DEFINE_CONVERT_FUNC(isize, osize) \
+    case ConvertDataTypes_##isize##_##osize: \
+        this->convert<uint##isize##_t, uint##osize##_t>(fc, \
+                                                        frame, \
+                                                        dst, \
+                                                        ymin, \
+                                                        ymax); \
+        break;
+
+bool AkVCam::VideoConverterPrivate::isPassThrough(const VideoFormat &iformat,
+                                                  const VideoFormat &oformat) const
+{
+    return iformat.format() == oformat.format()
+           && iformat.width() == oformat.width()
+           && iformat.height() == oformat.height()
+           && this->m_inputRect.isEmpty();
+}
+
+AkVCam::FrameConvertSlot *AkVCam::VideoConverterPrivate::slot(const VideoFrame &frame,
+                                                               const VideoFormat &oformat)
+{
+    static const int maxCacheAlloc = 1 << 16;
+
+    if (this->m_cacheIndex >= maxCacheAlloc)
+        return nullptr;
+
+    if (size_t(this->m_cacheIndex) >= this->m_slots.size()) {
+        static const int cacheBlockSize = 8;
+        this->m_slots.resize(bound(cacheBlockSize, this->m_cacheIndex + cacheBlockSize, maxCacheAlloc));
+    }
+
+    auto &slot = this->m_slots[this->m_cacheIndex];
+
+    if (!slot.fc
+        || !slot.fc->isSame(frame.format(),
+                            oformat,
+                            this->m_yuvColorSpace,
+                            this->m_yuvColorSpaceType,
+                            this->m_alphaMode,
+                            this->m_backgroundColor,
+                            this->m_scalingMode,
+                            this->m_aspectRatioMode,
+                            this->m_inputRect)) {
+        if (this->updateSlot(slot, frame, oformat))
+            return &slot;
+
+        slot.ownFc.reset();
+        slot.fc =
+            FrameConvertCache::instance().parameters(frame.format(),
+                                                     oformat,
+                                                     this->m_yuvColorSpace,
+                                                     this->m_yuvColorSpaceType,
+                                                     this->m_alphaMode,
+                                                     this->m_backgroundColor,
+                                                     this->m_scalingMode,
+                                                     this->m_aspectRatioMode,
+                                                     this->m_inputRect);
+        // Start from a zeroed frame, so the bits not used by the output
+        // format, like the padding components or the lower bits of P010,
+        // are always zero.
+        slot.outputFrame = {slot.fc->outputConvertFormat, true};
+
+        if (this->m_aspectRatioMode == AkVCam::VideoConverter::AspectRatioMode_Fit)
+            slot.outputFrame.fillRgb(Color::rgb(0, 0, 0, 0));
+    }
+
+    return &slot;
+}
+
+bool AkVCam::VideoConverterPrivate::updateSlot(FrameConvertSlot &slot,
+                                               const VideoFrame &frame,
+                                               const VideoFormat &oformat)
+{
+    /* When only the input size or the input rectangle changes, as when
+     * panning or zooming a frame, the color conversion and the output
+     * offsets are the same, so just update the offsets of the input in the
+     * plan of the slot instead of configuring a new one.
+     */
+
+    if (!slot.fc
+        || !slot.fc->isSameConversion(frame.format(),
+                                      oformat,
+                                      this->m_yuvColorSpace,
+                                      this->m_yuvColorSpaceType,
+                                      this->m_alphaMode,
+                                      this->m_backgroundColor,
+                                      this->m_scalingMode,
+                                      this->m_aspectRatioMode))
+        return false;
+
+    if (slot.fc != slot.ownFc)
+        slot.ownFc = std::make_shared<FrameConvertParameters>(*slot.fc);
+
+    auto &fc = *slot.ownFc;
+    Rect outputRect(fc.xmin, fc.ymin, fc.xmax - fc.xmin, fc.ymax - fc.ymin);
+
+    if (!fc.updateScaling(frame.format(), this->m_inputRect))
+        return false;
+
+    slot.fc = slot.ownFc;
+
+    bool isFit =
+            this->m_aspectRatioMode == AkVCam::VideoConverter::AspectRatioMode_Fit;
+
+    // In Fit mode the borders left by the previous rectangle must be cleared
+    // too.
+    if (slot.outputFrame.format() != fc.outputConvertFormat
+        || (isFit
+            && outputRect != Rect(fc.xmin, fc.ymin, fc.xmax - fc.xmin, fc.ymax - fc.ymin))) {
+        slot.outputFrame = {fc.outputConvertFormat, true};
+
+        if (isFit)
+            slot.outputFrame.fillRgb(Color::rgb(0, 0, 0, 0));
+    }
+
+    return true;
+}
+
+void AkVCam::VideoConverterPrivate::convertLines(const FrameConvertParameters &fc,
+                                                 const VideoFrame &frame,
+                                                 VideoFrame &dst,
+                                                 int ymin,
+                                                 int ymax)
+{
+    if (fc.directConvert) {
+        fc.directConvert(fc, frame, dst, ymin, ymax);
+    } else if (fc.fastConvertion) {
+        this->convertFast8bits(fc, frame, dst, ymin, ymax);
+    } else {
+        switch (fc.convertDataTypes) {
+        DEFINE_CONVERT_FUNC(8 , 8 )
+        DEFINE_CONVERT_FUNC(8 , 16)
+        DEFINE_CONVERT_FUNC(8 , 32)
+        DEFINE_CONVERT_FUNC(16, 8 )
+        DEFINE_CONVERT_FUNC(16, 16)
+        DEFINE_CONVERT_FUNC(16, 32)
+        DEFINE_CONVERT_FUNC(32, 8 )
+        DEFINE_CONVERT_FUNC(32, 16)
+        DEFINE_CONVERT_FUNC(32, 32)
+        }
+    }
+}
+
+void AkVCam::VideoConverterPrivate::convert(const FrameConvertParameters &fc,
+                                            const VideoFrame &frame,
+                                            VideoFrame &dst)
+{
+    // The output lines are written from several threads, so the output
+    // pixels must be copied before, if shared with other frames.
+    dst.detach();
+    dst.copyTiming(frame);
+
+    this->convertStripes(fc, dst, [this, &fc, &frame, &dst] (int ymin, int ymax) {
+        this->convertLines(fc, frame, dst, ymin, ymax);
+    });
+}
+
+AkVCam::VideoFrame AkVCam::VideoConverterPrivate::convert(const VideoFrame &frame,
+                                                          const VideoFormat &oformat)
+{
+    auto slot = this->slot(frame, oformat);
+
+    if (!slot)
+        return {};
+
+    if (slot->fc->outputConvertFormat.isSameFormat(frame.format())) {
+        this->m_cacheIndex++;
+
+        return frame;
+    }
+
+    this->convert(*slot->fc, frame, slot->outputFrame);
+    this->m_cacheIndex++;
+
+    return slot->outputFrame;
+}
+
+bool AkVCam::VideoConverterPrivate::convert(const VideoFrame &frame,
+                                            const VideoFormat &oformat,
+                                            uint8_t *const planes[],
+                                            const size_t lineSizes[])
+{
+    auto slot = this->slot(frame, oformat);
+
+    if (!slot)
+        return false;
+
+    if (slot->fc->outputConvertFormat.isSameFormat(frame.format())) {
+        copyFrame(frame, planes, lineSizes);
+    } else {
+        VideoFrame dst(slot->fc->outputConvertFormat, planes, lineSizes);
+        clearPadding(*slot, dst);
+        copyBorders(*slot, dst);
+        this->convert(*slot->fc, frame, dst);
+    }
+
+    this->m_cacheIndex++;
+
+    return true;
+}
+
+std::vector<AkVCam::VideoFrame> AkVCam::VideoConverterPrivate::convert(const VideoFrame &frame,
+                                                                       const std::vector<VideoFormat> &oformats)
+{
+    std::vector<VideoFrame> frames(oformats.size());
+
+    // Reserve a slot for each output first, the slots can be reallocated
+    // while adding new ones.
+
+    std::vector<int> slotIndexes(oformats.size(), -1);
+
+    for (size_t i = 0; i < oformats.size(); ++i) {
+        if (this->isPassThrough(frame.format(), oformats[i]))
+            continue;
+
+        if (!this->slot(frame, oformats[i]))
+            return {};
+
+        slotIndexes[i] = this->m_cacheIndex++;
+    }
+
+    std::vector<FrameConvertTarget> targets;
+
+    for (size_t i = 0; i < oformats.size(); ++i) {
+        if (slotIndexes[i] < 0)
+            continue;
+
+        auto &slot = this->m_slots[size_t(slotIndexes[i])];
+
+        if (!slot.fc->outputConvertFormat.isSameFormat(frame.format()))
+            targets.push_back({slot.fc.get(), &slot.outputFrame});
+    }
+
+    this->convertBands(frame, targets);
+
+    for (size_t i = 0; i < oformats.size(); ++i) {
+        if (slotIndexes[i] < 0) {
+            frames[i] = frame;
+
+            continue;
+        }
+
+        auto &slot = this->m_slots[size_t(slotIndexes[i])];
+
+        if (slot.fc->outputConvertFormat.isSameFormat(frame.format()))
+            frames[i] = frame;
+        else
+            frames[i] = slot.outputFrame;
+    }
+
+    return frames;
+}
+
+bool AkVCam::VideoConverterPrivate::convert(const VideoFrame &frame,
+                                            const std::vector<VideoFormat> &oformats,
+                                            uint8_t *const *const planes[],
+                                            const size_t *const lineSizes[])
+{
+    std::vector<int> slotIndexes(oformats.size(), -1);
+
+    for (size_t i = 0; i < oformats.size(); ++i) {
+        if (this->isPassThrough(frame.format(), oformats[i]))
+            continue;
+
+        if (!this->slot(frame, oformats[i]))
+            return false;
+
+        slotIndexes[i] = this->m_cacheIndex++;
+    }
+
+    // The external planes are wrapped in frames, these must live until all
+    // the outputs were converted.
 
-AkVCam::VideoFrame AkVCam::VideoConverter::convert(const VideoFrame &frame)
-{
-    if (!frame)
-        return {};
+    std::vector<std::unique_ptr<VideoFrame>> dstFrames;
+    std::vector<FrameConvertTarget> targets;
 
-    auto format = frame.format();
+    for (size_t i = 0; i < oformats.size(); ++i) {
+        if (slotIndexes[i] < 0) {
+            copyFrame(frame, planes[i], lineSizes[i]);
 
-    if (format.format() == this->d->m_outputFormat.format()
-        && format.width() == this->d->m_outputFormat.width()
-        && format.height() == this->d->m_outputFormat.height()
-        && this->d->m_inputRect.isEmpty())
-        return frame;
+            continue;
+        }
 
-    return this->d->convert(frame, this->d->m_outputFormat);
-}
+        auto &slot = this->m_slots[size_t(slotIndexes[i])];
 
-void AkVCam::VideoConverter::setCacheIndex(int index)
-{
-    this->d->m_cacheIndex = index;
-}
+        if (slot.fc->outputConvertFormat.isSameFormat(frame.format())) {
+            copyFrame(frame, planes[i], lineSizes[i]);
 
-void AkVCam::VideoConverter::setOutputFormat(const VideoFormat &outputFormat)
-{
-    this->d->m_mutex.lock();
-    this->d->m_outputFormat = outputFormat;
-    this->d->m_mutex.unlock();
-}
+            continue;
+        }
 
-void AkVCam::VideoConverter::setYuvColorSpace(AkVCam::ColorConvert::YuvColorSpace yuvColorSpace)
-{
-    this->d->m_yuvColorSpace = yuvColorSpace;
-}
+        auto dst = new VideoFrame(slot.fc->outputConvertFormat,
+                                  planes[i],
+                                  lineSizes[i]);
+        dstFrames.emplace_back(dst);
+        clearPadding(slot, *dst);
+        copyBorders(slot, *dst);
+        targets.push_back({slot.fc.get(), dst});
+    }
 
-void AkVCam::VideoConverter::setYuvColorSpaceType(AkVCam::ColorConvert::YuvColorSpaceType yuvColorSpaceType)
-{
-    this->d->m_yuvColorSpaceType = yuvColorSpaceType;
-}
+    this->convertBands(frame, targets);
 
-void AkVCam::VideoConverter::setScalingMode(AkVCam::VideoConverter::ScalingMode scalingMode)
-{
-    this->d->m_scalingMode = scalingMode;
+    return true;
 }
 
-void AkVCam::VideoConverter::setAspectRatioMode(AkVCam::VideoConverter::AspectRatioMode aspectRatioMode)
+void AkVCam::VideoConverterPrivate::copyFrame(const VideoFrame &src,
+                                              uint8_t *const planes[],
+                                              const size_t lineSizes[])
 {
-    this->d->m_aspectRatioMode = aspectRatioMode;
-}
+    for (size_t plane = 0; plane < src.planes(); ++plane) {
+        auto srcLineSize = src.lineSize(plane);
+        auto dstLineSize = lineSizes[plane];
+        auto bytesUsed = std::min(src.bytesUsed(plane), dstLineSize);
+        auto srcLine = src.constPlane(plane);
+        auto dstLine = planes[plane];
+        int heightDiv = int(src.heightDiv(plane));
+        int height = (src.format().height() + (1 << heightDiv) - 1) >> heightDiv;
+
+        if (srcLineSize == dstLineSize) {
+            memcpy(dstLine, srcLine, srcLineSize * size_t(height));
+
+            continue;
+        }
 
-void AkVCam::VideoConverter::setInputRect(const Rect &inputRect)
-{
-    this->d->m_inputRect = inputRect;
+        for (int y = 0; y < height; ++y) {
+            memcpy(dstLine, srcLine, bytesUsed);
+            srcLine += srcLineSize;
+            dstLine += dstLineSize;
+        }
+    }
 }
 
-void AkVCam::VideoConverter::reset()
+void AkVCam::VideoConverterPrivate::clearPadding(const FrameConvertSlot &slot,
+                                                 VideoFrame &dst)
 {
-    if (this->d->m_fc) {
-        delete [] this->d->m_fc;
-        this->d->m_fc = nullptr;
-    }
-
-    this->d->m_fcSize = 0;
-}
+    /* The components are written over the previous content of the output
+     * words, so the bits that belong to no component, like the X of XRGB,
+     * keep whatever the caller's planes had. Clear them, as in the internal
+     * output frames.
+     */
 
-#define DEFINE_CASE_SM(sm) \
-    case AkVCam::VideoConverter::sm: \
-        os << #sm; \
-        \
-        break;
+    if (!slot.fc->outputPadding)
+        return;
 
-std::ostream &operator <<(std::ostream &os, AkVCam::VideoConverter::ScalingMode mode)
-{
-    switch (mode) {
-    DEFINE_CASE_SM(ScalingMode_Fast)
-    DEFINE_CASE_SM(ScalingMode_Linear)
+    int height = slot.fc->outputConvertFormat.height();
 
-    default:
-        os << "ScalingMode_Unknown";
+    for (size_t plane = 0; plane < dst.planes(); ++plane) {
+        auto bytesUsed = dst.bytesUsed(plane);
+        int yStep = 1 << dst.heightDiv(plane);
 
-        break;
+        for (int y = 0; y < height; y += yStep)
+            memset(dst.line(plane, y), 0, bytesUsed);
     }
-
-    return os;
 }
 
-#define DEFINE_CASE_ARM(arm) \
-    case AkVCam::VideoConverter::arm: \
-        os << #arm; \
-        \
-        break;
-
-std::ostream &operator <<(std::ostream &os, AkVCam::VideoConverter::AspectRatioMode mode)
+void AkVCam::VideoConverterPrivate::copyBorders(const FrameConvertSlot &slot,
+                                                VideoFrame &dst)
 {
-    switch (mode) {
-    DEFINE_CASE_ARM(AspectRatioMode_Ignore)
-    DEFINE_CASE_ARM(AspectRatioMode_Keep)
-    DEFINE_CASE_ARM(AspectRatioMode_Expanding)
-    DEFINE_CASE_ARM(AspectRatioMode_Fit)
+    // The letterbox is already painted in the internal output frame, copy it
+    // to the parts of the external frame that won't be written.
 
-    default:
-        os << "AspectRatioMode_Unknown";
+    auto &fc = *slot.fc;
 
-        break;
-    }
+    if (fc.xmin == 0
+        && fc.ymin == 0
+        && fc.xmax == fc.outputConvertFormat.width()
+        && fc.ymax == fc.outputConvertFormat.height())
+        return;
 
-    return os;
-}
+    auto &src = slot.outputFrame;
+    int width = fc.outputConvertFormat.width();
+    int height = fc.outputConvertFormat.height();
 
-#define DEFINE_CONVERT_FUNC(isize, osize) \
-    case ConvertDataTypes_##isize##_##osize: \
-        this->convert<uint##isize##_t, uint##osize##_t>(fc, \
-                                                        frame, \
-                                                        fc.outputFrame); \
-        \
-        if (fc.toEndian != ENDIANNESS_BO) \
-            Algorithm::swapDataBytes(reinterpret_cast<uint##osize##_t *>(fc.outputFrame.data()), fc.outputFrame.size()); \
-        \
-        break;
+    for (size_t plane = 0; plane < dst.planes(); ++plane) {
+        auto bytesUsed = dst.bytesUsed(plane);
+        auto left = size_t(fc.xmin) * bytesUsed / size_t(width);
+        auto right = size_t(fc.xmax) * bytesUsed / size_t(width);
+        int yStep = 1 << dst.heightDiv(plane);
 
-AkVCam::VideoFrame AkVCam::VideoConverterPrivate::convert(const VideoFrame &frame,
-                                                          const VideoFormat &oformat)
-{
-    static const int maxCacheAlloc = 1 << 16;
+        for (int y = 0; y < height; y += yStep) {
+            auto srcLine = src.constLine(plane, y);
+            auto dstLine = dst.line(plane, y);
 
-    if (this->m_cacheIndex >= this->m_fcSize) {
-        static const int cacheBlockSize = 8;
-        auto newSize = bound(cacheBlockSize, this->m_cacheIndex + cacheBlockSize, maxCacheAlloc);
-        auto fc = new FrameConvertParameters[newSize];
+            if (y < fc.ymin || y >= fc.ymax) {
+                memcpy(dstLine, srcLine, bytesUsed);
+            } else {
+                memcpy(dstLine, srcLine, left);
+                memcpy(dstLine + right, srcLine + right, bytesUsed - right);
+            }
+        }
+    }
+}
 
-        if (this->m_fc) {
-            for (int i = 0; i < this->m_fcSize; ++i)
-                fc[i] = this->m_fc[i];
+AkVCam::FrameConvertCache &AkVCam::FrameConvertCache::instance()
+{
+    static FrameConvertCache cache;
 
-            delete [] this->m_fc;
-        }
+    return cache;
+}
 
-        this->m_fc = fc;
-        this->m_fcSize = newSize;
-    }
+AkVCam::FrameConvertParametersPtr AkVCam::FrameConvertCache::parameters(const VideoFormat &iformat,
+                                                                        const VideoFormat &oformat,
+                                                                        ColorConvert::YuvColorSpace yuvColorSpace,
+                                                                        ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                                                                        ColorConvert::AlphaMode inputAlphaMode,
+                                                                        uint32_t backgroundColor,
+                                                                        VideoConverter::ScalingMode scalingMode,
+                                                                        VideoConverter::AspectRatioMode aspectRatioMode,
+                                                                        const Rect &inputRect)
+{
+    auto find = [&] () -> FrameConvertParametersPtr {
+        for (auto it = this->m_plans.begin(); it != this->m_plans.end(); ++it)
+            if ((*it)->isSame(iformat,
+                              oformat,
+                              yuvColorSpace,
+                              yuvColorSpaceType,
+                              inputAlphaMode,
+                              backgroundColor,
+                              scalingMode,
+                              aspectRatioMode,
+                              inputRect)) {
+                // Move the plan to the front, as the most recently used.
+                this->m_plans.splice(this->m_plans.begin(), this->m_plans, it);
+
+                return *it;
+            }
 
-    if (this->m_cacheIndex >= maxCacheAlloc)
         return {};
+    };
 
-    auto &fc = this->m_fc[this->m_cacheIndex];
-
-    if (frame.format() != fc.inputFormat
-        || oformat != fc.outputFormat
-        || this->m_yuvColorSpace != fc.yuvColorSpace
-        || this->m_yuvColorSpaceType != fc.yuvColorSpaceType
-        || this->m_scalingMode != fc.scalingMode
-        || this->m_aspectRatioMode != fc.aspectRatioMode
-        || this->m_inputRect != fc.inputRect) {
-        fc.configure(frame.format(),
-                     oformat,
-                     fc.colorConvert,
-                     this->m_yuvColorSpace,
-                     this->m_yuvColorSpaceType);
-        fc.configureScaling(frame.format(),
-                            oformat,
-                            this->m_inputRect,
-                            this->m_aspectRatioMode);
-        fc.inputFormat = frame.format();
-        fc.outputFormat = oformat;
-        fc.yuvColorSpace = this->m_yuvColorSpace;
-        fc.yuvColorSpaceType = this->m_yuvColorSpaceType;
-        fc.scalingMode = this->m_scalingMode;
-        fc.aspectRatioMode = this->m_aspectRatioMode;
-        fc.inputRect = this->m_inputRect;
-    }
-
-    if (fc.outputConvertFormat.isSameFormat(frame.format())) {
-        this->m_cacheIndex++;
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        auto plan = find();
 
-        return frame;
+        if (plan)
+            return plan;
     }
 
-    if (fc.fastConvertion) {
-        this->convertFast8bits(fc, frame, fc.outputFrame);
-    } else {
-        switch (fc.convertDataTypes) {
-        DEFINE_CONVERT_FUNC(8 , 8 )
-        DEFINE_CONVERT_FUNC(8 , 16)
-        DEFINE_CONVERT_FUNC(8 , 32)
-        DEFINE_CONVERT_FUNC(16, 8 )
-        DEFINE_CONVERT_FUNC(16, 16)
-        DEFINE_CONVERT_FUNC(16, 32)
-        DEFINE_CONVERT_FUNC(32, 8 )
-        DEFINE_CONVERT_FUNC(32, 16)
-        DEFINE_CONVERT_FUNC(32, 32)
-        }
+    // Configure the plan out of the lock, since it's the slow part.
+
+    auto fc = std::make_shared<FrameConvertParameters>();
+    fc->configure(iformat,
+                  oformat,
+                  fc->colorConvert,
+                  yuvColorSpace,
+                  yuvColorSpaceType,
+                  inputAlphaMode,
+                  backgroundColor);
+    fc->configureScaling(iformat,
+                         oformat,
+                         inputRect,
+                         aspectRatioMode);
+    fc->inputFormat = iformat;
+    fc->outputFormat = oformat;
+    fc->yuvColorSpace = yuvColorSpace;
+    fc->yuvColorSpaceType = yuvColorSpaceType;
+    fc->inputAlphaMode = inputAlphaMode;
+    fc->backgroundColor = backgroundColor;
+    fc->scalingMode = scalingMode;
+    fc->aspectRatioMode = aspectRatioMode;
+    fc->inputRect = inputRect;
+
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+
+    // Other thread could have added the same plan meanwhile.
+    auto plan = find();
+
+    if (plan)
+        return plan;
+
+    this->m_plans.push_front(fc);
+    this->m_size += fc->memorySize();
+
+    while (this->m_size > PLAN_CACHE_MAX_SIZE && this->m_plans.size() > 1) {
+        this->m_size -= this->m_plans.back()->memorySize();
+        this->m_plans.pop_back();
     }
 
-    this->m_cacheIndex++;
-
-    return fc.outputFrame;
+    return fc;
 }
 
 AkVCam::FrameConvertParameters::FrameConvertParameters()
@@ -7806,10 +9694,15 @@ AkVCam::FrameConvertParameters::FrameConvertParameters()
 }
 
 AkVCam::FrameConvertParameters::FrameConvertParameters(const FrameConvertParameters &other):
+    colorConvert(other.colorConvert),
     inputFormat(other.inputFormat),
     outputFormat(other.outputFormat),
     outputConvertFormat(other.outputConvertFormat),
-    outputFrame(other.outputFrame),
+    inputRect(other.inputRect),
+    yuvColorSpace(other.yuvColorSpace),
+    yuvColorSpaceType(other.yuvColorSpaceType),
+    inputAlphaMode(other.inputAlphaMode),
+    backgroundColor(other.backgroundColor),
     scalingMode(other.scalingMode),
     aspectRatioMode(other.aspectRatioMode),
     convertType(other.convertType),
@@ -7817,6 +9710,12 @@ AkVCam::FrameConvertParameters::FrameConvertParameters(const FrameConvertParamet
     alphaMode(other.alphaMode),
     resizeMode(other.resizeMode),
     fastConvertion(other.fastConvertion),
+    simdConvertion(other.simdConvertion),
+    outputPadding(other.outputPadding),
+    simdColorMatrix(other.simdColorMatrix),
+    simdAlphaBlending(other.simdAlphaBlending),
+    simdAlphaMatrix(other.simdAlphaMatrix),
+    directConvert(other.directConvert),
     fromEndian(other.fromEndian),
     toEndian(other.toEndian),
     xmin(other.xmin),
@@ -7866,10 +9765,14 @@ AkVCam::FrameConvertParameters::FrameConvertParameters(const FrameConvertParamet
     maskYo(other.maskYo),
     maskZo(other.maskZo),
     maskAo(other.maskAo),
-    alphaMask(other.alphaMask)
+    alphaMask(other.alphaMask),
+    dlSumType(other.dlSumType),
+    dlFixedPoint(other.dlFixedPoint),
+    dlShiftX(other.dlShiftX),
+    dlShiftY(other.dlShiftY)
 {
-    auto oWidth = this->outputFormat.width();
-    auto oHeight = this->outputFormat.height();
+    auto oWidth = this->outputConvertFormat.width();
+    auto oHeight = this->outputConvertFormat.height();
 
     size_t oWidthDataSize = sizeof(int) * oWidth;
     size_t oHeightDataSize = sizeof(int) * oHeight;
@@ -7977,59 +9880,24 @@ AkVCam::FrameConvertParameters::FrameConvertParameters(const FrameConvertParamet
         memcpy(this->dstWidthOffsetA, other.dstWidthOffsetA, oWidthDataSize);
     }
 
-    size_t oHeightDlDataSize = sizeof(size_t) * oHeight;
-
-    if (other.srcHeightDlOffset) {
-        this->srcHeightDlOffset = new size_t [oHeight];
-        memcpy(this->srcHeightDlOffset, other.srcHeightDlOffset, oHeightDlDataSize);
-    }
-
-    if (other.srcHeightDlOffset_1) {
-        this->srcHeightDlOffset_1 = new size_t [oHeight];
-        memcpy(this->srcHeightDlOffset_1, other.srcHeightDlOffset_1, oHeightDlDataSize);
-    }
-
-    size_t iWidth_1 = this->inputFormat.width() + 1;
-    size_t iHeight_1 = this->inputFormat.height() + 1;
-    size_t integralImageSize = iWidth_1 * iHeight_1;
-    size_t integralImageDataSize = sizeof(DlSumType) * integralImageSize;
-
-    if (other.integralImageDataX) {
-        this->integralImageDataX = new DlSumType [integralImageSize];
-        memcpy(this->integralImageDataX, other.integralImageDataX, integralImageDataSize);
-    }
-
-    if (other.integralImageDataY) {
-        this->integralImageDataY = new DlSumType [integralImageSize];
-        memcpy(this->integralImageDataY, other.integralImageDataY, integralImageDataSize);
-    }
-
-    if (other.integralImageDataZ) {
-        this->integralImageDataZ = new DlSumType [integralImageSize];
-        memcpy(this->integralImageDataZ, other.integralImageDataZ, integralImageDataSize);
-    }
-
-    if (other.integralImageDataA) {
-        this->integralImageDataA = new DlSumType [integralImageSize];
-        memcpy(this->integralImageDataA, other.integralImageDataA, integralImageDataSize);
-    }
-
     if (other.kx) {
-        this->kx = new int64_t [oWidth];
-        memcpy(this->kx, other.kx, sizeof(int64_t) * oWidth);
+        this->kx = new uint16_t [oWidth];
+        memcpy(this->kx, other.kx, sizeof(uint16_t) * oWidth);
     }
 
     if (other.ky) {
-        this->ky = new int64_t [oHeight];
-        memcpy(this->ky, other.ky, sizeof(int64_t) * oHeight);
+        this->ky = new uint16_t [oHeight];
+        memcpy(this->ky, other.ky, sizeof(uint16_t) * oHeight);
     }
 
-    auto kdlSize = size_t(this->inputFormat.width()) * this->inputFormat.height();
-    auto kdlDataSize = sizeof(DlSumType) * kdlSize;
+    if (other.kdlX) {
+        this->kdlX = new uint64_t [oWidth];
+        memcpy(this->kdlX, other.kdlX, sizeof(uint64_t) * oWidth);
+    }
 
-    if (other.kdl) {
-        this->kdl = new DlSumType [kdlSize];
-        memcpy(this->kdl, other.kdl, kdlDataSize);
+    if (other.kdlY) {
+        this->kdlY = new uint64_t [oHeight];
+        memcpy(this->kdlY, other.kdlY, sizeof(uint64_t) * oHeight);
     }
 }
 
@@ -8042,10 +9910,15 @@ AkVCam::FrameConvertParameters::~FrameConvertParameters()
 AkVCam::FrameConvertParameters &AkVCam::FrameConvertParameters::operator =(const FrameConvertParameters &other)
 {
     if (this != &other) {
+        this->colorConvert = other.colorConvert;
         this->inputFormat = other.inputFormat;
         this->outputFormat = other.outputFormat;
         this->outputConvertFormat = other.outputConvertFormat;
-        this->outputFrame = other.outputFrame;
+        this->inputRect = other.inputRect;
+        this->yuvColorSpace = other.yuvColorSpace;
+        this->yuvColorSpaceType = other.yuvColorSpaceType;
+        this->inputAlphaMode = other.inputAlphaMode;
+        this->backgroundColor = other.backgroundColor;
         this->scalingMode = other.scalingMode;
         this->aspectRatioMode = other.aspectRatioMode;
         this->convertType = other.convertType;
@@ -8053,6 +9926,12 @@ AkVCam::FrameConvertParameters &AkVCam::FrameConvertParameters::operator =(const
         this->alphaMode = other.alphaMode;
         this->resizeMode = other.resizeMode;
         this->fastConvertion = other.fastConvertion;
+        this->simdConvertion = other.simdConvertion;
+        this->outputPadding = other.outputPadding;
+        this->simdColorMatrix = other.simdColorMatrix;
+        this->simdAlphaBlending = other.simdAlphaBlending;
+        this->simdAlphaMatrix = other.simdAlphaMatrix;
+        this->directConvert = other.directConvert;
         this->fromEndian = other.fromEndian;
         this->toEndian = other.toEndian;
         this->xmin = other.xmin;
@@ -8103,12 +9982,16 @@ AkVCam::FrameConvertParameters &AkVCam::FrameConvertParameters::operator =(const
         this->maskZo = other.maskZo;
         this->maskAo = other.maskAo;
         this->alphaMask = other.alphaMask;
+        this->dlSumType = other.dlSumType;
+        this->dlFixedPoint = other.dlFixedPoint;
+        this->dlShiftX = other.dlShiftX;
+        this->dlShiftY = other.dlShiftY;
 
         this->clearBuffers();
         this->clearDlBuffers();
 
-        auto oWidth = this->outputFormat.width();
-        auto oHeight = this->outputFormat.height();
+        auto oWidth = this->outputConvertFormat.width();
+        auto oHeight = this->outputConvertFormat.height();
 
         size_t oWidthDataSize = sizeof(int) * oWidth;
         size_t oHeightDataSize = sizeof(int) * oHeight;
@@ -8216,59 +10099,24 @@ AkVCam::FrameConvertParameters &AkVCam::FrameConvertParameters::operator =(const
             memcpy(this->dstWidthOffsetA, other.dstWidthOffsetA, oWidthDataSize);
         }
 
-        size_t oHeightDlDataSize = sizeof(size_t) * oHeight;
-
-        if (other.srcHeightDlOffset) {
-            this->srcHeightDlOffset = new size_t [oHeight];
-            memcpy(this->srcHeightDlOffset, other.srcHeightDlOffset, oHeightDlDataSize);
-        }
-
-        if (other.srcHeightDlOffset_1) {
-            this->srcHeightDlOffset_1 = new size_t [oHeight];
-            memcpy(this->srcHeightDlOffset_1, other.srcHeightDlOffset_1, oHeightDlDataSize);
-        }
-
-        size_t iWidth_1 = this->inputFormat.width() + 1;
-        size_t iHeight_1 = this->inputFormat.height() + 1;
-        size_t integralImageSize = iWidth_1 * iHeight_1;
-        size_t integralImageDataSize = sizeof(DlSumType) * integralImageSize;
-
-        if (other.integralImageDataX) {
-            this->integralImageDataX = new DlSumType [integralImageSize];
-            memcpy(this->integralImageDataX, other.integralImageDataX, integralImageDataSize);
-        }
-
-        if (other.integralImageDataY) {
-            this->integralImageDataY = new DlSumType [integralImageSize];
-            memcpy(this->integralImageDataY, other.integralImageDataY, integralImageDataSize);
-        }
-
-        if (other.integralImageDataZ) {
-            this->integralImageDataZ = new DlSumType [integralImageSize];
-            memcpy(this->integralImageDataZ, other.integralImageDataZ, integralImageDataSize);
-        }
-
-        if (other.integralImageDataA) {
-            this->integralImageDataA = new DlSumType [integralImageSize];
-            memcpy(this->integralImageDataA, other.integralImageDataA, integralImageDataSize);
-        }
-
         if (other.kx) {
-            this->kx = new int64_t [oWidth];
-            memcpy(this->kx, other.kx, sizeof(int64_t) * oWidth);
+            this->kx = new uint16_t [oWidth];
+            memcpy(this->kx, other.kx, sizeof(uint16_t) * oWidth);
         }
 
         if (other.ky) {
-            this->ky = new int64_t [oHeight];
-            memcpy(this->ky, other.ky, sizeof(int64_t) * oHeight);
+            this->ky = new uint16_t [oHeight];
+            memcpy(this->ky, other.ky, sizeof(uint16_t) * oHeight);
         }
 
-        auto kdlSize = size_t(this->inputFormat.width()) * this->inputFormat.height();
-        auto kdlDataSize = sizeof(DlSumType) * kdlSize;
+        if (other.kdlX) {
+            this->kdlX = new uint64_t [oWidth];
+            memcpy(this->kdlX, other.kdlX, sizeof(uint64_t) * oWidth);
+        }
 
-        if (other.kdl) {
-            this->kdl = new DlSumType [kdlSize];
-            memcpy(this->kdl, other.kdl, kdlDataSize);
+        if (other.kdlY) {
+            this->kdlY = new uint64_t [oHeight];
+            memcpy(this->kdlY, other.kdlY, sizeof(uint64_t) * oHeight);
         }
     }
 
@@ -8370,39 +10218,14 @@ void AkVCam::FrameConvertParameters::clearBuffers()
 
 void AkVCam::FrameConvertParameters::clearDlBuffers()
 {
-    if (this->integralImageDataX) {
-        delete [] this->integralImageDataX;
-        this->integralImageDataX = nullptr;
-    }
-
-    if (this->integralImageDataY) {
-        delete [] this->integralImageDataY;
-        this->integralImageDataY = nullptr;
-    }
-
-    if (this->integralImageDataZ) {
-        delete [] this->integralImageDataZ;
-        this->integralImageDataZ = nullptr;
+    if (this->kdlX) {
+        delete [] this->kdlX;
+        this->kdlX = nullptr;
     }
 
-    if (this->integralImageDataA) {
-        delete [] this->integralImageDataA;
-        this->integralImageDataA = nullptr;
-    }
-
-    if (this->kdl) {
-        delete [] this->kdl;
-        this->kdl = nullptr;
-    }
-
-    if (this->srcHeightDlOffset) {
-        delete [] this->srcHeightDlOffset;
-        this->srcHeightDlOffset = nullptr;
-    }
-
-    if (this->srcHeightDlOffset_1) {
-        delete [] this->srcHeightDlOffset_1;
-        this->srcHeightDlOffset_1 = nullptr;
+    if (this->kdlY) {
+        delete [] this->kdlY;
+        this->kdlY = nullptr;
     }
 
     if (this->dlSrcWidthOffsetX) {
@@ -8449,32 +10272,15 @@ void AkVCam::FrameConvertParameters::allocateBuffers(const VideoFormat &oformat)
     this->dstWidthOffsetZ = new int [oformat.width()];
     this->dstWidthOffsetA = new int [oformat.width()];
 
-    this->kx = new int64_t [oformat.width()];
-    this->ky = new int64_t [oformat.height()];
+    this->kx = new uint16_t [oformat.width()];
+    this->ky = new uint16_t [oformat.height()];
 }
 
 void AkVCam::FrameConvertParameters::allocateDlBuffers(const VideoFormat &iformat,
                                                        const VideoFormat &oformat)
 {
-    size_t width_1 = iformat.width() + 1;
-    size_t height_1 = iformat.height() + 1;
-    auto integralImageSize = width_1 * height_1;
-
-    this->integralImageDataX = new DlSumType [integralImageSize];
-    this->integralImageDataY = new DlSumType [integralImageSize];
-    this->integralImageDataZ = new DlSumType [integralImageSize];
-    this->integralImageDataA = new DlSumType [integralImageSize];
-    memset(this->integralImageDataX, 0, integralImageSize);
-    memset(this->integralImageDataY, 0, integralImageSize);
-    memset(this->integralImageDataZ, 0, integralImageSize);
-    memset(this->integralImageDataA, 0, integralImageSize);
-
-    auto kdlSize = size_t(iformat.width()) * iformat.height();
-    this->kdl = new DlSumType [kdlSize];
-    memset(this->kdl, 0, kdlSize);
-
-    this->srcHeightDlOffset = new size_t [oformat.height()];
-    this->srcHeightDlOffset_1 = new size_t [oformat.height()];
+    this->kdlX = new uint64_t [oformat.width()];
+    this->kdlY = new uint64_t [oformat.height()];
 
     this->dlSrcWidthOffsetX = new int [iformat.width()];
     this->dlSrcWidthOffsetY = new int [iformat.width()];
@@ -8483,22 +10289,24 @@ void AkVCam::FrameConvertParameters::allocateDlBuffers(const VideoFormat &iforma
 }
 
 #define DEFINE_CONVERT_TYPES(isize, osize) \
-    if (ispecs.depth() == isize && ospecs.depth() == osize) \
+    if (8 * ispecs.byteDepth() == isize && 8 * ospecs.byteDepth() == osize) \
         this->convertDataTypes = ConvertDataTypes_##isize##_##osize;
 
 void AkVCam::FrameConvertParameters::configure(const VideoFormat &iformat,
                                                const VideoFormat &oformat,
                                                ColorConvert &colorConvert,
                                                ColorConvert::YuvColorSpace yuvColorSpace,
-                                               ColorConvert::YuvColorSpaceType yuvColorSpaceType)
+                                               ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                                               ColorConvert::AlphaMode inputAlphaMode,
+                                               uint32_t backgroundColor)
 {
-    auto ispecs = VideoFormat::formatSpecs(iformat.format());
+    auto &ispecs = VideoFormat::formatSpecs(iformat.format());
     auto oFormat = oformat.format();
 
     if (oFormat == PixelFormat_none)
         oFormat = iformat.format();
 
-    auto ospecs = VideoFormat::formatSpecs(oFormat);
+    auto &ospecs = VideoFormat::formatSpecs(oFormat);
 
     DEFINE_CONVERT_TYPES(8, 8);
     DEFINE_CONVERT_TYPES(8, 16);
@@ -8528,6 +10336,8 @@ void AkVCam::FrameConvertParameters::configure(const VideoFormat &iformat,
     this->toEndian = ospecs.endianness();
     colorConvert.setYuvColorSpace(yuvColorSpace);
     colorConvert.setYuvColorSpaceType(yuvColorSpaceType);
+    colorConvert.setAlphaMode(inputAlphaMode);
+    colorConvert.setBackgroundColor(backgroundColor);
     colorConvert.loadMatrix(ispecs, ospecs);
 
     switch (ispecs.type()) {
@@ -8645,7 +10455,76 @@ void AkVCam::FrameConvertParameters::configure(const VideoFormat &iformat,
     else if (!hasAlphaIn && !hasAlphaOut)
         this->alphaMode = ConvertAlphaMode_I_O;
 
-    this->fastConvertion = ispecs.isFast() && ospecs.isFast();
+    this->outputPadding = false;
+
+    for (size_t i = 0; i < ospecs.planes(); ++i) {
+        auto &plane = ospecs.plane(i);
+        size_t step = 1;
+
+        for (size_t c = 0; c < plane.components(); ++c)
+            step = std::lcm(step, plane.component(c).step());
+
+        size_t bits = 0;
+
+        for (size_t c = 0; c < plane.components(); ++c) {
+            auto &component = plane.component(c);
+            bits += component.depth() * (step / component.step());
+        }
+
+        if (bits < 8 * step)
+            this->outputPadding = true;
+    }
+
+    // The fast paths read the color matrix from the 8 bits tables.
+    this->fastConvertion = ispecs.isFast()
+                           && ospecs.isFast()
+                           && this->convertDataTypes == ConvertDataTypes_8_8
+                           && colorConvert.has8bitsTables();
+    this->simdConvertion = false;
+
+    if (this->fastConvertion
+        && this->convertDataTypes == ConvertDataTypes_8_8
+        && this->convertType != ConvertType_Vector
+        && this->convertType != ConvertType_1to1
+        && colorConvert.colorPrecision() == ColorConvert::Precision_16
+        && Simd::instruction() != Simd::Instruction_None) {
+        int64_t colorMatrix[12];
+        int64_t minValues[3];
+        int64_t maxValues[3];
+        int64_t colorShift = 0;
+        colorConvert.readMatrix<int64_t>(colorMatrix,
+                                         nullptr,
+                                         minValues,
+                                         maxValues,
+                                         &colorShift);
+        this->simdConvertion = Simd::loadColorMatrix(colorMatrix,
+                                                     minValues,
+                                                     maxValues,
+                                                     colorShift,
+                                                     &this->simdColorMatrix);
+    }
+
+    this->simdAlphaBlending = false;
+
+    if (this->fastConvertion
+        && this->alphaMode == ConvertAlphaMode_AI_O
+        && Simd::instruction() != Simd::Instruction_None) {
+        int64_t alphaMatrix[12];
+        int64_t minValues[3];
+        int64_t maxValues[3];
+        int64_t alphaShift = 0;
+        colorConvert.readMatrix<int64_t>(nullptr,
+                                         alphaMatrix,
+                                         minValues,
+                                         maxValues,
+                                         nullptr,
+                                         &alphaShift);
+        this->simdAlphaBlending = Simd::loadAlphaMatrix(alphaMatrix,
+                                                        minValues,
+                                                        maxValues,
+                                                        alphaShift,
+                                                        &this->simdAlphaMatrix);
+    }
 }
 
 void AkVCam::FrameConvertParameters::configureScaling(const VideoFormat &iformat,
@@ -8653,7 +10532,64 @@ void AkVCam::FrameConvertParameters::configureScaling(const VideoFormat &iformat
                                                       const Rect &inputRect,
                                                       VideoConverter::AspectRatioMode aspectRatioMode)
 {
-    Rect irect(0, 0, iformat.width(), iformat.height());
+    Rect irect;
+    int owidth = 0;
+    int oheight = 0;
+    this->configureGeometry(iformat,
+                            oformat,
+                            inputRect,
+                            aspectRatioMode,
+                            irect,
+                            owidth,
+                            oheight);
+    this->allocateBuffers(this->outputConvertFormat);
+
+    for (int x = 0; x < this->outputConvertFormat.width(); ++x) {
+        this->dstWidthOffsetX[x] = (x >> this->compXo.widthDiv()) * this->compXo.step();
+        this->dstWidthOffsetY[x] = (x >> this->compYo.widthDiv()) * this->compYo.step();
+        this->dstWidthOffsetZ[x] = (x >> this->compZo.widthDiv()) * this->compZo.step();
+        this->dstWidthOffsetA[x] = (x >> this->compAo.widthDiv()) * this->compAo.step();
+    }
+
+    this->clearDlBuffers();
+    this->configureSourceTables(iformat, irect, owidth, oheight);
+}
+
+bool AkVCam::FrameConvertParameters::updateScaling(const VideoFormat &iformat,
+                                                   const Rect &inputRect)
+{
+    auto outputConvertFormat = this->outputConvertFormat;
+    Rect irect;
+    int owidth = 0;
+    int oheight = 0;
+    this->configureGeometry(iformat,
+                            this->outputFormat,
+                            inputRect,
+                            this->aspectRatioMode,
+                            irect,
+                            owidth,
+                            oheight);
+
+    if (this->outputConvertFormat.width() != outputConvertFormat.width()
+        || this->outputConvertFormat.height() != outputConvertFormat.height())
+        return false;
+
+    this->configureSourceTables(iformat, irect, owidth, oheight);
+    this->inputFormat = iformat;
+    this->inputRect = inputRect;
+
+    return true;
+}
+
+void AkVCam::FrameConvertParameters::configureGeometry(const VideoFormat &iformat,
+                                                       const VideoFormat &oformat,
+                                                       const Rect &inputRect,
+                                                       VideoConverter::AspectRatioMode aspectRatioMode,
+                                                       Rect &irect,
+                                                       int &owidth,
+                                                       int &oheight)
+{
+    irect = {0, 0, iformat.width(), iformat.height()};
 
     if (!inputRect.isEmpty())
         irect = irect.intersected(inputRect);
@@ -8669,8 +10605,8 @@ void AkVCam::FrameConvertParameters::configureScaling(const VideoFormat &iformat
     int height = this->outputConvertFormat.height() > 1?
                      this->outputConvertFormat.height():
                      irect.height();
-    int owidth = width;
-    int oheight = height;
+    owidth = width;
+    oheight = height;
 
     if (aspectRatioMode == AkVCam::VideoConverter::AspectRatioMode_Keep
         || aspectRatioMode == AkVCam::VideoConverter::AspectRatioMode_Fit) {
@@ -8723,30 +10659,39 @@ void AkVCam::FrameConvertParameters::configureScaling(const VideoFormat &iformat
         auto y = (irect.y() + irect.height() - h) / 2;
         irect = {x, y, w, h};
     }
+}
 
-    this->allocateBuffers(this->outputConvertFormat);
-
+void AkVCam::FrameConvertParameters::configureSourceTables(const VideoFormat &iformat,
+                                                           const Rect &irect,
+                                                           int owidth,
+                                                           int oheight)
+{
     auto &xomin = this->xmin;
 
-    int wi_1 = std::max(1, irect.width() - 1);
+    int wi_1 = std::max(0, irect.width() - 1);
     int wo_1 = std::max(1, owidth - 1);
 
-    auto xSrcToDst = [&irect, &xomin, &wi_1, &wo_1] (int x) -> int {
-        return ((x - irect.x()) * wo_1 + xomin * wi_1) / wi_1;
-    };
-
     auto xDstToSrc = [&irect, &xomin, &wi_1, &wo_1] (int x) -> int {
         return ((x - xomin) * wi_1 + irect.x() * wo_1) / wo_1;
     };
 
+    // Fractional part of the source position, in 2^SCALE_EMULT units.
+    auto xDstToSrcK = [&xomin, &owidth, &wi_1, &wo_1] (int x) -> uint16_t {
+        if (x < xomin || x >= xomin + owidth)
+            return 0;
+
+        auto k = (int64_t(x - xomin) * wi_1) % wo_1;
+
+        return uint16_t((k << SCALE_EMULT) / wo_1);
+    };
+
     for (int x = 0; x < this->outputConvertFormat.width(); ++x) {
         auto xs = xDstToSrc(x);
-        auto xs_1 = xDstToSrc(std::min(x + 1, this->outputConvertFormat.width() - 1));
-        auto xmin = xSrcToDst(xs);
-        auto xmax = xSrcToDst(xs + 1);
+        auto xs_1 = std::min(xs + 1, irect.x() + irect.width() - 1);
 
         this->srcWidth[x]   = xs;
-        this->srcWidth_1[x] = std::min(xDstToSrc(x + 1), iformat.width());
+        this->srcWidth_1[x] = std::min(std::max(xDstToSrc(x + 1), xs + 1),
+                                       iformat.width());
         this->srcWidthOffsetX[x] = (xs >> this->compXi.widthDiv()) * this->compXi.step();
         this->srcWidthOffsetY[x] = (xs >> this->compYi.widthDiv()) * this->compYi.step();
         this->srcWidthOffsetZ[x] = (xs >> this->compZi.widthDiv()) * this->compZi.step();
@@ -8757,87 +10702,199 @@ void AkVCam::FrameConvertParameters::configureScaling(const VideoFormat &iformat
         this->srcWidthOffsetZ_1[x] = (xs_1 >> this->compZi.widthDiv()) * this->compZi.step();
         this->srcWidthOffsetA_1[x] = (xs_1 >> this->compAi.widthDiv()) * this->compAi.step();
 
-        this->dstWidthOffsetX[x] = (x >> this->compXo.widthDiv()) * this->compXo.step();
-        this->dstWidthOffsetY[x] = (x >> this->compYo.widthDiv()) * this->compYo.step();
-        this->dstWidthOffsetZ[x] = (x >> this->compZo.widthDiv()) * this->compZo.step();
-        this->dstWidthOffsetA[x] = (x >> this->compAo.widthDiv()) * this->compAo.step();
-
-        if (xmax > xmin)
-            this->kx[x] = SCALE_EMULT * (x - xmin) / (xmax - xmin);
-        else
-            this->kx[x] = 0;
+        this->kx[x] = xDstToSrcK(x);
     }
 
     auto &yomin = this->ymin;
 
-    int hi_1 = std::max(1, irect.height() - 1);
+    int hi_1 = std::max(0, irect.height() - 1);
     int ho_1 = std::max(1, oheight - 1);
 
-    auto ySrcToDst = [&irect, &yomin, &hi_1, &ho_1] (int y) -> int {
-        return ((y - irect.y()) * ho_1 + yomin * hi_1) / hi_1;
-    };
-
     auto yDstToSrc = [&irect, &yomin, &hi_1, &ho_1] (int y) -> int {
         return ((y - yomin) * hi_1 + irect.y() * ho_1) / ho_1;
     };
 
+    auto yDstToSrcK = [&yomin, &oheight, &hi_1, &ho_1] (int y) -> uint16_t {
+        if (y < yomin || y >= yomin + oheight)
+            return 0;
+
+        auto k = (int64_t(y - yomin) * hi_1) % ho_1;
+
+        return uint16_t((k << SCALE_EMULT) / ho_1);
+    };
+
     for (int y = 0; y < this->outputConvertFormat.height(); ++y) {
         if (this->resizeMode == ResizeMode_Down) {
-            this->srcHeight[y] = yDstToSrc(y);
-            this->srcHeight_1[y] = std::min(yDstToSrc(y + 1), iformat.height());
-        } else {
             auto ys = yDstToSrc(y);
-            auto ys_1 = yDstToSrc(std::min(y + 1, this->outputConvertFormat.height() - 1));
-            auto ymin = ySrcToDst(ys);
-            auto ymax = ySrcToDst(ys + 1);
 
             this->srcHeight[y] = ys;
-            this->srcHeight_1[y] = ys_1;
+            this->srcHeight_1[y] = std::min(std::max(yDstToSrc(y + 1), ys + 1),
+                                            iformat.height());
+        } else {
+            auto ys = yDstToSrc(y);
 
-            if (ymax > ymin)
-                this->ky[y] = SCALE_EMULT * (y - ymin) / (ymax - ymin);
-            else
-                this->ky[y] = 0;
+            this->srcHeight[y] = ys;
+            this->srcHeight_1[y] = std::min(ys + 1, irect.y() + irect.height() - 1);
+            this->ky[y] = yDstToSrcK(y);
         }
     }
 
-    this->inputWidth = iformat.width();
-    this->inputWidth_1 = iformat.width() + 1;
-    this->inputHeight = iformat.height();
-
-    this->clearDlBuffers();
-
     if (this->resizeMode == ResizeMode_Down) {
-        this->allocateDlBuffers(iformat, this->outputConvertFormat);
+        // The input offsets only depends on the input width, keep them if
+        // the input width didn't changed.
 
-        for (int x = 0; x < iformat.width(); ++x) {
-            this->dlSrcWidthOffsetX[x] = (x >> this->compXi.widthDiv()) * this->compXi.step();
-            this->dlSrcWidthOffsetY[x] = (x >> this->compYi.widthDiv()) * this->compYi.step();
-            this->dlSrcWidthOffsetZ[x] = (x >> this->compZi.widthDiv()) * this->compZi.step();
-            this->dlSrcWidthOffsetA[x] = (x >> this->compAi.widthDiv()) * this->compAi.step();
+        if (!this->dlSrcWidthOffsetX || this->inputWidth != iformat.width()) {
+            this->clearDlBuffers();
+            this->allocateDlBuffers(iformat, this->outputConvertFormat);
+
+            for (int x = 0; x < iformat.width(); ++x) {
+                this->dlSrcWidthOffsetX[x] = (x >> this->compXi.widthDiv()) * this->compXi.step();
+                this->dlSrcWidthOffsetY[x] = (x >> this->compYi.widthDiv()) * this->compYi.step();
+                this->dlSrcWidthOffsetZ[x] = (x >> this->compZi.widthDiv()) * this->compZi.step();
+                this->dlSrcWidthOffsetA[x] = (x >> this->compAi.widthDiv()) * this->compAi.step();
+            }
         }
 
-        for (int y = 0; y < this->outputConvertFormat.height(); ++y) {
-            auto &ys = this->srcHeight[y];
-            auto &ys_1 = this->srcHeight_1[y];
+        // Select the smallest type that can hold the sums of a whole line.
 
-            this->srcHeightDlOffset[y] = size_t(ys) * this->inputWidth_1;
-            this->srcHeightDlOffset_1[y] = size_t(ys_1) * this->inputWidth_1;
+        auto maxValue = std::max<uint64_t>({1,
+                                            this->maxXi,
+                                            this->maxYi,
+                                            this->maxZi,
+                                            this->maxAi});
+        uint64_t maxBoxWidth = 1;
+        uint64_t maxBoxHeight = 1;
 
-            auto diffY = ys_1 - ys;
-            auto line = this->kdl + size_t(y) * iformat.width();
+        for (int x = this->xmin; x < this->xmax; ++x)
+            maxBoxWidth = std::max<uint64_t>(maxBoxWidth,
+                                             this->srcWidth_1[x] - this->srcWidth[x]);
 
-            for (int x = 0; x < this->outputConvertFormat.width(); ++x) {
-                auto diffX = this->srcWidth_1[x] - this->srcWidth[x];
-                line[x] = diffX * diffY;
-            }
+        for (int y = this->ymin; y < this->ymax; ++y)
+            maxBoxHeight = std::max<uint64_t>(maxBoxHeight,
+                                              this->srcHeight_1[y] - this->srcHeight[y]);
+
+        auto maxLineSize = uint64_t(this->inputWidth) * maxBoxHeight;
+
+        if (maxLineSize <= std::numeric_limits<uint32_t>::max() / maxValue)
+            this->dlSumType = DlSumType_32;
+        else if (maxLineSize <= std::numeric_limits<uint64_t>::max() / maxValue)
+            this->dlSumType = DlSumType_64;
+        else
+            this->dlSumType = DlSumType_Double;
+
+        /* A sum s of a box of width w is divided exactly by w with
+         * (s * (2^n / w + 1)) >> n when s * w < 2^n, and the same goes for
+         * the height. Select the shifts so the products fit in 64 bits.
+         */
+
+        auto bits = [] (uint64_t value) -> int {
+            int n = 0;
+
+            for (; value; value >>= 1)
+                n++;
+
+            return n;
+        };
+
+        int widthBits = bits(maxBoxWidth);
+        int heightBits = bits(maxBoxHeight);
+        int valueBits = bits(maxValue);
+
+        this->dlShiftX = 2 * widthBits + heightBits + valueBits;
+        this->dlShiftY = 2 * heightBits + valueBits;
+        this->dlFixedPoint =
+                this->dlSumType != DlSumType_Double
+                && heightBits + valueBits + this->dlShiftX < 64
+                && valueBits + this->dlShiftY < 64;
+
+        for (int x = 0; x < this->outputConvertFormat.width(); ++x) {
+            auto boxWidth = std::max(1, this->srcWidth_1[x] - this->srcWidth[x]);
+            this->kdlX[x] = this->dlFixedPoint?
+                                (uint64_t(1) << this->dlShiftX) / uint64_t(boxWidth) + 1:
+                                0;
+        }
+
+        for (int y = 0; y < this->outputConvertFormat.height(); ++y) {
+            auto boxHeight = std::max(1, this->srcHeight_1[y] - this->srcHeight[y]);
+            this->kdlY[y] = this->dlFixedPoint?
+                                (uint64_t(1) << this->dlShiftY) / uint64_t(boxHeight) + 1:
+                                0;
         }
     }
 
-    this->outputFrame = {this->outputConvertFormat};
+    this->inputWidth = iformat.width();
+    this->inputWidth_1 = iformat.width() + 1;
+    this->inputHeight = iformat.height();
+
+    // The direct kernels can only be used if the frame is not scaled.
+
+    if (this->resizeMode != ResizeMode_Keep
+        || irect != Rect(0, 0, iformat.width(), iformat.height())
+        || this->xmin != 0
+        || this->ymin != 0
+        || this->xmax != this->outputConvertFormat.width()
+        || this->ymax != this->outputConvertFormat.height())
+        this->directConvert = nullptr;
+    else
+        this->directConvert =
+                directConverter(iformat.format(),
+                                this->outputConvertFormat.format());
+}
+
+bool AkVCam::FrameConvertParameters::isSame(const VideoFormat &iformat,
+                                            const VideoFormat &oformat,
+                                            ColorConvert::YuvColorSpace yuvColorSpace,
+                                            ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                                            ColorConvert::AlphaMode inputAlphaMode,
+                                            uint32_t backgroundColor,
+                                            VideoConverter::ScalingMode scalingMode,
+                                            VideoConverter::AspectRatioMode aspectRatioMode,
+                                            const Rect &inputRect) const
+{
+    return iformat == this->inputFormat
+           && oformat == this->outputFormat
+           && yuvColorSpace == this->yuvColorSpace
+           && yuvColorSpaceType == this->yuvColorSpaceType
+           && inputAlphaMode == this->inputAlphaMode
+           && backgroundColor == this->backgroundColor
+           && scalingMode == this->scalingMode
+           && aspectRatioMode == this->aspectRatioMode
+           && inputRect == this->inputRect;
+}
+
+bool AkVCam::FrameConvertParameters::isSameConversion(const VideoFormat &iformat,
+                                                      const VideoFormat &oformat,
+                                                      ColorConvert::YuvColorSpace yuvColorSpace,
+                                                      ColorConvert::YuvColorSpaceType yuvColorSpaceType,
+                                                      ColorConvert::AlphaMode inputAlphaMode,
+                                                      uint32_t backgroundColor,
+                                                      VideoConverter::ScalingMode scalingMode,
+                                                      VideoConverter::AspectRatioMode aspectRatioMode) const
+{
+    return iformat.format() == this->inputFormat.format()
+           && iformat.fps() == this->inputFormat.fps()
+           && oformat == this->outputFormat
+           && yuvColorSpace == this->yuvColorSpace
+           && yuvColorSpaceType == this->yuvColorSpaceType
+           && inputAlphaMode == this->inputAlphaMode
+           && backgroundColor == this->backgroundColor
+           && scalingMode == this->scalingMode
+           && aspectRatioMode == this->aspectRatioMode;
+}
+
+size_t AkVCam::FrameConvertParameters::memorySize() const
+{
+    size_t width = size_t(this->outputConvertFormat.width());
+    size_t height = size_t(this->outputConvertFormat.height());
+    size_t size = sizeof(FrameConvertParameters)
+                  + width * (16 * sizeof(int) + sizeof(uint16_t))
+                  + height * (2 * sizeof(int) + sizeof(uint16_t));
+
+    if (this->kdlX)
+        size += (width + height) * sizeof(uint64_t)
+                + 4 * size_t(this->inputFormat.width()) * sizeof(int);
 
-    if (aspectRatioMode == AkVCam::VideoConverter::AspectRatioMode_Fit)
-        this->outputFrame.fillRgb(Color::rgb(0, 0, 0, 0));
+    return size;
 }
 
 void AkVCam::FrameConvertParameters::reset()
@@ -8845,7 +10902,6 @@ void AkVCam::FrameConvertParameters::reset()
     this->inputFormat = VideoFormat();
     this->outputFormat = VideoFormat();
     this->outputConvertFormat = VideoFormat();
-    this->outputFrame = VideoFrame();
     this->scalingMode = AkVCam::VideoConverter::ScalingMode_Fast;
     this->aspectRatioMode = AkVCam::VideoConverter::AspectRatioMode_Ignore;
     this->convertType = ConvertType_Vector;
@@ -8853,6 +10909,12 @@ void AkVCam::FrameConvertParameters::reset()
     this->alphaMode = ConvertAlphaMode_AI_AO;
     this->resizeMode = ResizeMode_Keep;
     this->fastConvertion = false;
+    this->simdConvertion = false;
+    this->outputPadding = false;
+    this->simdColorMatrix = {};
+    this->simdAlphaBlending = false;
+    this->simdAlphaMatrix = {};
+    this->directConvert = nullptr;
 
     this->fromEndian = ENDIANNESS_BO;
     this->toEndian = ENDIANNESS_BO;
@@ -8920,4 +10982,9 @@ void AkVCam::FrameConvertParameters::reset()
     this->maskAo = 0;
 
     this->alphaMask = 0;
+
+    this->dlSumType = DlSumType_64;
+    this->dlFixedPoint = false;
+    this->dlShiftX = 0;
+    this->dlShiftY = 0;
 }
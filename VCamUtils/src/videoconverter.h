@@ -20,6 +20,8 @@
 #ifndef AKVCAMUTILS_VIDEOCONVERTER_H
 #define AKVCAMUTILS_VIDEOCONVERTER_H
 
+#include <vector>
+
 #include "colorconvert.h"
 
 namespace AkVCam
@@ -53,21 +55,63 @@ namespace AkVCam
             VideoFormat outputFormat() const;
             ColorConvert::YuvColorSpace yuvColorSpace() const;
             ColorConvert::YuvColorSpaceType yuvColorSpaceType() const;
+            ColorConvert::AlphaMode alphaMode() const;
+            uint32_t backgroundColor() const;
             VideoConverter::ScalingMode scalingMode() const;
             VideoConverter::AspectRatioMode aspectRatioMode() const;
             Rect inputRect() const;
+            int threadCount() const;
 
             bool begin();
             void end();
             VideoFrame convert(const VideoFrame &frame);
 
+            // Converts the frame and writes the result directly into the
+            // caller's planes. The planes must be big enough to hold a frame
+            // with the output format, or the frame size adjusted to the
+            // aspect ratio when using AspectRatioMode_Keep. The bits that
+            // belong to no component, like the X of XRGB, are written as
+            // zero.
+            bool convert(const VideoFrame &frame,
+                         uint8_t *const planes[],
+                         const size_t lineSizes[]);
+
+            // Converts the frame to several output formats at once. The
+            // input frame is read only once for all the outputs, instead of
+            // once per output. Each output uses its own cache index, starting
+            // from the current one.
+            std::vector<VideoFrame> convert(const VideoFrame &frame,
+                                            const std::vector<VideoFormat> &outputFormats);
+
+            // Same as above, but the i-th output is written directly into
+            // planes[i], with lineSizes[i] as the line sizes of its planes.
+            bool convert(const VideoFrame &frame,
+                         const std::vector<VideoFormat> &outputFormats,
+                         uint8_t *const *const planes[],
+                         const size_t *const lineSizes[]);
+
             void setCacheIndex(int index);
             void setOutputFormat(const VideoFormat &outputFormat);
             void setYuvColorSpace(ColorConvert::YuvColorSpace yuvColorSpace);
             void setYuvColorSpaceType(ColorConvert::YuvColorSpaceType yuvColorSpaceType);
+
+            // How the alpha of the input frames is interpreted, and the color
+            // that is shown through the transparent pixels when the output
+            // format has no alpha. The background defaults to black.
+            void setAlphaMode(ColorConvert::AlphaMode alphaMode);
+            void setBackgroundColor(uint32_t backgroundColor);
+
             void setScalingMode(VideoConverter::ScalingMode scalingMode);
             void setAspectRatioMode(VideoConverter::AspectRatioMode aspectRatioMode);
+
+            // Converts only the given rectangle of the input frame. Moving the
+            // rectangle between frames only updates the input offsets of the
+            // conversion, as long as the output size doesn't change.
             void setInputRect(const Rect &inputRect);
+
+            // Number of threads used for converting a frame, values lower
+            // than 1 uses one thread per CPU core.
+            void setThreadCount(int threadCount);
             void reset();
 
         private:
@@ -22,11 +22,13 @@
 #include <limits>
 #include <map>
 #include <ostream>
+#include <type_traits>
 
 #include "videoformat.h"
 #include "algorithm.h"
 #include "fraction.h"
 #include "videoformatspec.h"
+#include "videoframetypes.h"
 #include "utils.h"
 
 #define VFT_Unknown VideoFormatSpec::VFT_Unknown
@@ -46,6 +48,12 @@
 #define MAX_PLANES 4
 #define MAX_COMPONENTS 4
 
+// Number of slots of the hash table of the format specs, must be a power of
+// two greater than twice the number of formats.
+#define SPEC_TABLE_BITS 6
+#define SPEC_TABLE_SIZE (1 << SPEC_TABLE_BITS)
+#define SPEC_TABLE_MASK (SPEC_TABLE_SIZE - 1)
+
 namespace AkVCam
 {
     struct Component
@@ -243,6 +251,51 @@ namespace AkVCam
                  {2, {{CT_V, 2, 0, 0, 1, 8, 1, 1},
                  {CT_U, 2, 1, 0, 1, 8, 1, 1}}, 8}
                  }},
+                {PixelFormat_nv16,
+                 "NV16",
+                 VFT_YUV,
+                 ENDIANNESS_BO,
+                 2,
+                 {{1, {{CT_Y, 1, 0, 0, 1, 8, 0, 0}}, 8},
+                 {2, {{CT_U, 2, 0, 0, 1, 8, 1, 0},
+                 {CT_V, 2, 1, 0, 1, 8, 1, 0}}, 8}
+                 }},
+                {PixelFormat_nv61,
+                 "NV61",
+                 VFT_YUV,
+                 ENDIANNESS_BO,
+                 2,
+                 {{1, {{CT_Y, 1, 0, 0, 1, 8, 0, 0}}, 8},
+                 {2, {{CT_V, 2, 0, 0, 1, 8, 1, 0},
+                 {CT_U, 2, 1, 0, 1, 8, 1, 0}}, 8}
+                 }},
+                {PixelFormat_p010,
+                 "P010",
+                 VFT_YUV,
+                 ENDIANNESS_LE,
+                 2,
+                 {{1, {{CT_Y, 2, 0, 6, 2, 10, 0, 0}}, 16},
+                 {2, {{CT_U, 4, 0, 6, 2, 10, 1, 1},
+                 {CT_V, 4, 2, 6, 2, 10, 1, 1}}, 16}
+                 }},
+                {PixelFormat_i420,
+                 "I420",
+                 VFT_YUV,
+                 ENDIANNESS_BO,
+                 3,
+                 {{1, {{CT_Y, 1, 0, 0, 1, 8, 0, 0}}, 8},
+                 {1, {{CT_U, 1, 0, 0, 1, 8, 1, 1}}, 4},
+                 {1, {{CT_V, 1, 0, 0, 1, 8, 1, 1}}, 4}
+                 }},
+                {PixelFormat_yv12,
+                 "YV12",
+                 VFT_YUV,
+                 ENDIANNESS_BO,
+                 3,
+                 {{1, {{CT_Y, 1, 0, 0, 1, 8, 0, 0}}, 8},
+                 {1, {{CT_V, 1, 0, 0, 1, 8, 1, 1}}, 4},
+                 {1, {{CT_U, 1, 0, 0, 1, 8, 1, 1}}, 4}
+                 }},
                 {PixelFormat_none,
                  "none",
                  VFT_Unknown,
@@ -254,16 +307,7 @@ namespace AkVCam
             return akvcamVideoFormatSpecTable;
         }
 
-        static inline const VideoFmt *byPixelFormat(PixelFormat pixelFormat)
-        {
-            auto it = formats();
-
-            for (; it->format != PixelFormat_none; ++it)
-                if (it->format == pixelFormat)
-                    return it;
-
-            return it;
-        }
+        static inline const VideoFmt *byPixelFormat(PixelFormat pixelFormat);
 
         static inline const VideoFmt *byName(const std::string &name)
         {
@@ -286,185 +330,206 @@ namespace AkVCam
             return allFormats;
         }
 
-        static VideoFormatSpec formatSpecs(PixelFormat format)
+        static inline const VideoFormatSpec &formatSpecs(PixelFormat format);
+
+        static VideoFormatSpec makeSpecs(const VideoFmt *fmt)
         {
-            auto fmt = formats();
-
-            for (; fmt->format != PixelFormat_none; fmt++)
-                if (fmt->format == format) {
-                    ColorPlanes planes;
-
-                    for (size_t i = 0; i < fmt->nplanes; ++i) {
-                        auto &plane = fmt->planes[i];
-                        ColorComponentList components;
-
-                        for (size_t i = 0; i < plane.ncomponents; ++i) {
-                            auto &component = plane.components[i];
-                            components.push_back(ColorComponent(component.type,
-                                                                component.step,
-                                                                component.offset,
-                                                                component.shift,
-                                                                component.byteDepth,
-                                                                component.depth,
-                                                                component.widthDiv,
-                                                                component.heightDiv));
-                        }
-
-                        planes.push_back(ColorPlane(components,
-                                                    plane.bitsSize));
-                    }
-
-                    return VideoFormatSpec(fmt->type,
-                                           fmt->endianness,
-                                           planes);
+            ColorPlanes planes;
+
+            for (size_t i = 0; i < fmt->nplanes; ++i) {
+                auto &plane = fmt->planes[i];
+                ColorComponentList components;
+
+                for (size_t i = 0; i < plane.ncomponents; ++i) {
+                    auto &component = plane.components[i];
+                    components.push_back(ColorComponent(component.type,
+                                                        component.step,
+                                                        component.offset,
+                                                        component.shift,
+                                                        component.byteDepth,
+                                                        component.depth,
+                                                        component.widthDiv,
+                                                        component.heightDiv));
                 }
 
-            return {};
+                planes.push_back(ColorPlane(components,
+                                            plane.bitsSize));
+            }
+
+            return VideoFormatSpec(fmt->type,
+                                   fmt->endianness,
+                                   planes);
         }
     };
 
-    class VideoFormatPrivate
+    /* The specs of the formats are built once and never modified after that,
+     * so these can be shared by all threads without locking. The formats are
+     * found by their fourcc in an open addressing hash table, which is kept
+     * less than half full so most lookups end in the first slot.
+     */
+    class VideoFormatSpecTable
     {
         public:
-            PixelFormat m_format {PixelFormat_none};
-            int m_width {0};
-            int m_height {0};
-            Fraction m_fps;
-    };
-}
+            VideoFormatSpecTable();
 
-AkVCam::VideoFormat::VideoFormat()
-{
-    this->d = new VideoFormatPrivate;
-}
+            static const VideoFormatSpecTable &instance();
 
-AkVCam::VideoFormat::VideoFormat(PixelFormat format,
-                                 int width,
-                                 int height)
-{
-    this->d = new VideoFormatPrivate;
-    this->d->m_format = format;
-    this->d->m_width = width;
-    this->d->m_height = height;
-}
+            // Index of the format in the formats table, or the index of the
+            // PixelFormat_none entry if the format is not supported.
+            inline size_t index(PixelFormat format) const
+            {
+                for (auto slot = hash(format);; slot = (slot + 1) & SPEC_TABLE_MASK) {
+                    auto index = this->m_slots[slot];
 
-AkVCam::VideoFormat::VideoFormat(PixelFormat format,
-                                 int width,
-                                 int height,
-                                 const Fraction &fps)
-{
-    this->d = new VideoFormatPrivate;
-    this->d->m_format = format;
-    this->d->m_width = width;
-    this->d->m_height = height;
-    this->d->m_fps = fps;
-}
+                    if (index < 0)
+                        return this->m_none;
 
-AkVCam::VideoFormat::VideoFormat(const VideoFormat &other)
-{
-    this->d = new VideoFormatPrivate;
-    this->d->m_format = other.d->m_format;
-    this->d->m_width = other.d->m_width;
-    this->d->m_height = other.d->m_height;
-    this->d->m_fps = other.d->m_fps;
-}
+                    if (VideoFmt::formats()[index].format == format)
+                        return size_t(index);
+                }
+            }
 
-AkVCam::VideoFormat::~VideoFormat()
-{
-    delete this->d;
-}
+            inline const VideoFormatSpec &specs(size_t index) const
+            {
+                return this->m_specs[index];
+            }
 
-AkVCam::VideoFormat &AkVCam::VideoFormat::operator =(const VideoFormat &other)
-{
-    if (this != &other) {
-        this->d->m_format = other.d->m_format;
-        this->d->m_width = other.d->m_width;
-        this->d->m_height = other.d->m_height;
-        this->d->m_fps = other.d->m_fps;
+        private:
+            std::vector<VideoFormatSpec> m_specs;
+            int m_slots[SPEC_TABLE_SIZE];
+            size_t m_none {0};
+
+            inline static size_t hash(PixelFormat format)
+            {
+                return (uint32_t(format) * 0x9e3779b1u) >> (32 - SPEC_TABLE_BITS);
+            }
+    };
+
+    inline const VideoFmt *VideoFmt::byPixelFormat(PixelFormat pixelFormat)
+    {
+        return formats() + VideoFormatSpecTable::instance().index(pixelFormat);
+    }
+
+    inline const VideoFormatSpec &VideoFmt::formatSpecs(PixelFormat format)
+    {
+        auto &table = VideoFormatSpecTable::instance();
+
+        return table.specs(table.index(format));
     }
 
-    return *this;
+    static_assert(std::is_trivially_copyable_v<VideoFormat>,
+                  "VideoFormat must be copyable without allocating");
 }
 
-bool AkVCam::VideoFormat::operator ==(const AkVCam::VideoFormat &other) const
+AkVCam::VideoFormatSpecTable::VideoFormatSpecTable()
 {
-    return this->d->m_format == other.d->m_format
-           && this->d->m_width == other.d->m_width
-           && this->d->m_height == other.d->m_height
-           && this->d->m_fps == other.d->m_fps;
+    std::fill_n(this->m_slots, SPEC_TABLE_SIZE, -1);
+    auto fmt = VideoFmt::formats();
+
+    for (int index = 0;; ++index, ++fmt) {
+        this->m_specs.push_back(VideoFmt::makeSpecs(fmt));
+
+        if (fmt->format == PixelFormat_none) {
+            this->m_none = size_t(index);
+
+            break;
+        }
+
+        auto slot = hash(fmt->format);
+
+        while (this->m_slots[slot] >= 0)
+            slot = (slot + 1) & SPEC_TABLE_MASK;
+
+        this->m_slots[slot] = index;
+    }
 }
 
-bool AkVCam::VideoFormat::operator !=(const AkVCam::VideoFormat &other) const
+const AkVCam::VideoFormatSpecTable &AkVCam::VideoFormatSpecTable::instance()
 {
-    return this->d->m_format != other.d->m_format
-           || this->d->m_width != other.d->m_width
-           || this->d->m_height != other.d->m_height
-           || this->d->m_fps != other.d->m_fps;
+    static const VideoFormatSpecTable table;
+
+    return table;
 }
 
-AkVCam::VideoFormat::operator bool() const
+AkVCam::VideoFormat::VideoFormat(PixelFormat format,
+                                 int width,
+                                 int height):
+    m_format(format),
+    m_width(width),
+    m_height(height)
 {
-    return this->d->m_format != PixelFormat_none
-           && this->d->m_width > 0
-           && this->d->m_height > 0;
 }
 
-AkVCam::PixelFormat AkVCam::VideoFormat::format() const
+AkVCam::VideoFormat::VideoFormat(PixelFormat format,
+                                 int width,
+                                 int height,
+                                 const Fraction &fps):
+    m_format(format),
+    m_width(width),
+    m_height(height),
+    m_fps(fps)
 {
-    return this->d->m_format;
 }
 
-int AkVCam::VideoFormat::width() const
+bool AkVCam::VideoFormat::operator ==(const AkVCam::VideoFormat &other) const
 {
-    return this->d->m_width;
+    return this->m_format == other.m_format
+           && this->m_width == other.m_width
+           && this->m_height == other.m_height
+           && this->m_fps == other.m_fps;
 }
 
-int AkVCam::VideoFormat::height() const
+bool AkVCam::VideoFormat::operator !=(const AkVCam::VideoFormat &other) const
 {
-    return this->d->m_height;
+    return this->m_format != other.m_format
+           || this->m_width != other.m_width
+           || this->m_height != other.m_height
+           || this->m_fps != other.m_fps;
 }
 
-AkVCam::Fraction AkVCam::VideoFormat::fps() const
+AkVCam::VideoFormat::operator bool() const
 {
-    return this->d->m_fps;
+    return this->m_format != PixelFormat_none
+           && this->m_width > 0
+           && this->m_height > 0;
 }
 
 size_t AkVCam::VideoFormat::bpp() const
 {
-    return VideoFmt::formatSpecs(this->d->m_format).bpp();
+    return VideoFmt::formatSpecs(this->m_format).bpp();
 }
 
 void AkVCam::VideoFormat::setFormat(PixelFormat format)
 {
-    this->d->m_format = format;
+    this->m_format = format;
 }
 
 void AkVCam::VideoFormat::setWidth(int width)
 {
-    this->d->m_width = width;
+    this->m_width = width;
 }
 
 void AkVCam::VideoFormat::setHeight(int height)
 {
-    this->d->m_height = height;
+    this->m_height = height;
 }
 
 void AkVCam::VideoFormat::setFps(const Fraction &fps)
 {
-    this->d->m_fps = fps;
+    this->m_fps = fps;
 }
 
 AkVCam::VideoFormat AkVCam::VideoFormat::nearest(const VideoFormats &caps) const
 {
     VideoFormat nearestCap;
     auto q = std::numeric_limits<uint64_t>::max();
-    auto sspecs = VideoFmt::formatSpecs(this->d->m_format);
+    auto &sspecs = VideoFmt::formatSpecs(this->m_format);
 
     for (auto &cap: caps) {
-        auto specs = VideoFmt::formatSpecs(cap.d->m_format);
-        uint64_t diffFourcc = cap.d->m_format == this->d->m_format? 0: 1;
-        auto diffWidth = cap.d->m_width - this->d->m_width;
-        auto diffHeight = cap.d->m_height - this->d->m_height;
+        auto &specs = VideoFmt::formatSpecs(cap.m_format);
+        uint64_t diffFourcc = cap.m_format == this->m_format? 0: 1;
+        auto diffWidth = cap.m_width - this->m_width;
+        auto diffHeight = cap.m_height - this->m_height;
         auto diffBpp = specs.bpp() - sspecs.bpp();
         auto diffPlanes = specs.planes() - sspecs.planes();
         int diffPlanesBits = 0;
@@ -503,30 +568,36 @@ AkVCam::VideoFormat AkVCam::VideoFormat::nearest(const VideoFormats &caps) const
 
 bool AkVCam::VideoFormat::isSameFormat(const VideoFormat &other) const
 {
-    return this->d->m_format == other.d->m_format
-            && this->d->m_width == other.d->m_width
-            && this->d->m_height == other.d->m_height;
+    return this->m_format == other.m_format
+            && this->m_width == other.m_width
+            && this->m_height == other.m_height;
 }
 
 size_t AkVCam::VideoFormat::dataSize() const
 {
     size_t dataSize = 0;
-    static const size_t align = 32;
-    auto specs = VideoFormat::formatSpecs(this->d->m_format);
+    static const size_t align = AKVCAM_FRAME_ALIGNMENT;
+    auto &specs = VideoFormat::formatSpecs(this->m_format);
 
     // Calculate parameters for each plane
     for (size_t i = 0; i < specs.planes(); ++i) {
         auto &plane = specs.plane(i);
 
-        // Calculate bytes used per line (bits per pixel * width / 8)
-        size_t bytesUsed = plane.bitsSize() * this->d->m_width / 8;
+        // Calculate bytes used per line (bits per pixel * width / 8), the
+        // last chroma sample must be allocated for odd widths
+        size_t samples = (this->m_width + (1 << plane.widthDiv()) - 1)
+                         >> plane.widthDiv();
+        size_t bytesUsed = (plane.bitsSize() << plane.widthDiv()) * samples / 8;
 
         // Align line size for SIMD compatibility
         size_t lineSize =
                 Algorithm::alignUp(bytesUsed, align);
 
-        // Calculate plane size, considering sub-sampling
-        size_t planeSize = (lineSize * this->d->m_height) >> plane.heightDiv();
+        // Calculate plane size, considering sub-sampling, the last line
+        // must be allocated for odd heights
+        size_t lines = (this->m_height + (1 << plane.heightDiv()) - 1)
+                       >> plane.heightDiv();
+        size_t planeSize = lineSize * lines;
 
         // Align plane size to ensure next plane starts aligned and update
         // total data size
@@ -540,13 +611,13 @@ size_t AkVCam::VideoFormat::dataSize() const
 
 bool AkVCam::VideoFormat::isValid() const
 {
-    if (this->d->m_format < PixelFormat_none)
+    if (this->m_format < PixelFormat_none)
         return false;
 
-    if (this->d->m_width < 1 || this->d->m_height < 1)
+    if (this->m_width < 1 || this->m_height < 1)
         return false;
 
-    if (this->d->m_fps.num() < 1 || this->d->m_fps.den() < 1)
+    if (this->m_fps.num() < 1 || this->m_fps.den() < 1)
         return false;
 
     return true;
@@ -555,13 +626,13 @@ bool AkVCam::VideoFormat::isValid() const
 std::string AkVCam::VideoFormat::toString() const
 {
     return std::string("VideoFormat(")
-            + pixelFormatToString(this->d->m_format)
+            + pixelFormatToString(this->m_format)
             + ' '
-            + std::to_string(this->d->m_width)
+            + std::to_string(this->m_width)
             + 'x'
-            + std::to_string(this->d->m_height)
+            + std::to_string(this->m_height)
             + ' '
-            + this->d->m_fps.toString()
+            + this->m_fps.toString()
             + ')';
 }
 
@@ -580,7 +651,7 @@ AkVCam::PixelFormat AkVCam::VideoFormat::pixelFormatFromString(const std::string
     return VideoFmt::byName(pixelFormat)->format;
 }
 
-AkVCam::VideoFormatSpec AkVCam::VideoFormat::formatSpecs(PixelFormat pixelFormat)
+const AkVCam::VideoFormatSpec &AkVCam::VideoFormat::formatSpecs(PixelFormat pixelFormat)
 {
     return VideoFmt::formatSpecs(pixelFormat);
 }
@@ -23,20 +23,23 @@
 #include <string>
 #include <vector>
 
+#include "fraction.h"
 #include "videoformattypes.h"
 
 namespace AkVCam
 {
     class VideoFormat;
-    class VideoFormatPrivate;
-    class Fraction;
     class VideoFormatSpec;
     using VideoFormats = std::vector<VideoFormat>;
 
+    /* The format is stored inline and it's trivially copyable, so the
+     * formats returned by value, like VideoFrame::format(), are copied
+     * without allocating.
+     */
     class VideoFormat
     {
         public:
-            VideoFormat();
+            VideoFormat() = default;
             VideoFormat(PixelFormat format,
                         int width,
                         int height);
@@ -44,17 +47,33 @@ namespace AkVCam
                         int width,
                         int height,
                         const Fraction &fps);
-            VideoFormat(const VideoFormat &other);
-            ~VideoFormat();
-            VideoFormat &operator =(const VideoFormat &other);
+            VideoFormat(const VideoFormat &other) = default;
+            ~VideoFormat() = default;
+            VideoFormat &operator =(const VideoFormat &other) = default;
             bool operator ==(const VideoFormat &other) const;
             bool operator !=(const VideoFormat &other) const;
             operator bool() const;
 
-            PixelFormat format() const;
-            int width() const;
-            int height() const;
-            Fraction fps() const;
+            inline PixelFormat format() const
+            {
+                return this->m_format;
+            }
+
+            inline int width() const
+            {
+                return this->m_width;
+            }
+
+            inline int height() const
+            {
+                return this->m_height;
+            }
+
+            inline Fraction fps() const
+            {
+                return this->m_fps;
+            }
+
             size_t bpp() const;
 
             void setFormat(PixelFormat format);
@@ -71,11 +90,14 @@ namespace AkVCam
             static int bitsPerPixel(PixelFormat pixelFormat);
             static std::string pixelFormatToString(PixelFormat pixelFormat);
             static PixelFormat pixelFormatFromString(const std::string &pixelFormat);
-            static VideoFormatSpec formatSpecs(PixelFormat pixelFormat);
+            static const VideoFormatSpec &formatSpecs(PixelFormat pixelFormat);
             static std::vector<PixelFormat> supportedPixelFormats();
 
         private:
-            VideoFormatPrivate *d;
+            PixelFormat m_format {PixelFormat_none};
+            int m_width {0};
+            int m_height {0};
+            Fraction m_fps;
 
         friend bool operator <(const VideoFormat &format1, const VideoFormat &format2);
     };
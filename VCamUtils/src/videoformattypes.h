@@ -56,6 +56,15 @@ namespace AkVCam
         // two planes -- one Y, one Cr + Cb interleaved
         PixelFormat_nv12 = AKVCAM_MAKE_FOURCC('N', 'V', 12, 0),
         PixelFormat_nv21 = AKVCAM_MAKE_FOURCC('N', 'V', 21, 0),
+        PixelFormat_nv16 = AKVCAM_MAKE_FOURCC('N', 'V', 16, 0),
+        PixelFormat_nv61 = AKVCAM_MAKE_FOURCC('N', 'V', 61, 0),
+
+        // two planes -- 10 bits in the high bits of 16 bits little endian words
+        PixelFormat_p010 = AKVCAM_MAKE_FOURCC('P', '0', '1', '0'),
+
+        // three planes -- one Y, one Cb, one Cr
+        PixelFormat_i420 = AKVCAM_MAKE_FOURCC('I', '4', '2', '0'),
+        PixelFormat_yv12 = AKVCAM_MAKE_FOURCC('Y', 'V', '1', '2'),
 
 #if ENDIANNESS_BO == ENDIANNESS_LE
         PixelFormat_xrgbpackbe    = PixelFormat_xrgb,
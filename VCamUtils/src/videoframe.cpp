@@ -18,15 +18,29 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "videoframe.h"
 #include "algorithm.h"
 #include "color.h"
 #include "colorcomponent.h"
 #include "colorconvert.h"
+#include "framebufferpool.h"
+#include "rect.h"
+#include "simd.h"
 #include "videoformat.h"
 #include "videoformatspec.h"
 #include "utils.h"
@@ -66,14 +80,6 @@ namespace AkVCam
 
             int endianess {ENDIANNESS_BO};
 
-            int width {0};
-            int height {0};
-
-            int *dstWidthOffsetX {nullptr};
-            int *dstWidthOffsetY {nullptr};
-            int *dstWidthOffsetZ {nullptr};
-            int *dstWidthOffsetA {nullptr};
-
             int planeXo {0};
             int planeYo {0};
             int planeZo {0};
@@ -103,20 +109,25 @@ namespace AkVCam
             FillParameters(const FillParameters &other);
             ~FillParameters();
             FillParameters &operator =(const FillParameters &other);
-            inline void clearBuffers();
-            inline void allocateBuffers(const VideoFormat &caps);
             void configure(const VideoFormat &caps, ColorConvert &colorConvert);
-            void configureFill(const VideoFormat &caps);
             void reset();
+
+            // Offset in bytes of the component of the pixel x.
+            inline static int offset(const ColorComponent &component, size_t x);
+
+            // The parameters only depend on the pixel format, so these are
+            // configured once and shared by all the frames.
+            static std::shared_ptr<const FillParameters> parameters(PixelFormat format);
     };
 
-    using FillParametersPtr = std::shared_ptr<FillParameters>;
+    using FillParametersPtr = std::shared_ptr<const FillParameters>;
+    using VideoFrameBuffer = FrameBufferPool::Buffer;
 
     class VideoFramePrivate
     {
         public:
             VideoFormat m_format;
-            uint8_t *m_data {nullptr};
+            VideoFrameBuffer m_data;
             size_t m_dataSize {0};
             size_t m_nPlanes {0};
             uint8_t *m_planes[MAX_PLANES];
@@ -127,12 +138,56 @@ namespace AkVCam
             size_t m_bytesUsed[MAX_PLANES];
             size_t m_widthDiv[MAX_PLANES];
             size_t m_heightDiv[MAX_PLANES];
-            size_t m_align {32};
+            size_t m_align {AKVCAM_FRAME_ALIGNMENT};
             FillParametersPtr m_fc;
 
+            // Keeps the external memory wrapped by the frame alive, and calls
+            // the release callback when the last frame referencing it is
+            // destroyed.
+            std::shared_ptr<void> m_external;
+
+            // The frame is a view of the pixels of other frame, these are
+            // copied to a buffer of its own before modifying them.
+            bool m_view {false};
+
+            int64_t m_pts {-1};
+            int64_t m_captureTime {-1};
+            int64_t m_duration {0};
+            uint64_t m_sequence {0};
+
+            // The private objects come from the buffer pool, so the frames
+            // are created without allocating.
+            static void *operator new(size_t size);
+            static void operator delete(void *ptr);
+
+            // Size of the buffer stored before the object.
+            inline static size_t headerSize();
+
+            inline void copyTiming(const VideoFramePrivate *other);
+
             void updateParams(const VideoFormatSpec &specs);
+            inline void allocate();
             inline void updatePlanes();
 
+            // Points the planes to the copied data, or to the same memory of
+            // the other frame if it doesn't own it.
+            inline void updatePlanes(const VideoFramePrivate *other);
+
+            // Copies the pixels if these are shared with other frames, so
+            // they can be modified.
+            void detach();
+
+            // Copies the pixels referenced by a view to a buffer of its own.
+            void detachView();
+
+            // Format and planes of the given rectangle of the frame.
+            bool viewPlanes(int x,
+                            int y,
+                            int width,
+                            int height,
+                            VideoFormat &format,
+                            uint8_t **planes) const;
+
             /* Fill functions */
 
             template <typename DataType>
@@ -146,7 +201,12 @@ namespace AkVCam
                 int64_t xo_ = 0;
                 int64_t yo_ = 0;
                 int64_t zo_ = 0;
-                fc.colorConvert.applyMatrix(xi, yi, zi, &xo_, &yo_, &zo_);
+
+                if (fc.colorConvert.has8bitsTables())
+                    fc.colorConvert.applyMatrix8bits(xi, yi, zi, &xo_, &yo_, &zo_);
+                else
+                    fc.colorConvert.applyMatrix(xi, yi, zi, &xo_, &yo_, &zo_);
+
                 fc.colorConvert.applyAlpha(ai, &xo_, &yo_, &zo_);
 
                 auto line_x = this->m_planes[fc.planeXo] + fc.xoOffset;
@@ -156,9 +216,9 @@ namespace AkVCam
                 auto width = std::max<size_t>(8 * this->m_pixelSize[0] / this->m_format.bpp(), 1);
 
                 for (size_t x = 0; x < width; ++x) {
-                    int &xd_x = fc.dstWidthOffsetX[x];
-                    int &xd_y = fc.dstWidthOffsetY[x];
-                    int &xd_z = fc.dstWidthOffsetZ[x];
+                    int xd_x = FillParameters::offset(fc.compXo, x);
+                    int xd_y = FillParameters::offset(fc.compYo, x);
+                    int xd_z = FillParameters::offset(fc.compZo, x);
 
                     auto xo = reinterpret_cast<DataType *>(line_x + xd_x);
                     auto yo = reinterpret_cast<DataType *>(line_y + xd_y);
@@ -181,7 +241,11 @@ namespace AkVCam
                 int64_t xo_ = 0;
                 int64_t yo_ = 0;
                 int64_t zo_ = 0;
-                fc.colorConvert.applyMatrix(xi, yi, zi, &xo_, &yo_, &zo_);
+
+                if (fc.colorConvert.has8bitsTables())
+                    fc.colorConvert.applyMatrix8bits(xi, yi, zi, &xo_, &yo_, &zo_);
+                else
+                    fc.colorConvert.applyMatrix(xi, yi, zi, &xo_, &yo_, &zo_);
 
                 auto line_x = this->m_planes[fc.planeXo] + fc.xoOffset;
                 auto line_y = this->m_planes[fc.planeYo] + fc.yoOffset;
@@ -191,10 +255,10 @@ namespace AkVCam
                 auto width = std::max<size_t>(8 * this->m_pixelSize[0] / this->m_format.bpp(), 1);
 
                 for (size_t x = 0; x < width; ++x) {
-                    int &xd_x = fc.dstWidthOffsetX[x];
-                    int &xd_y = fc.dstWidthOffsetY[x];
-                    int &xd_z = fc.dstWidthOffsetZ[x];
-                    int &xd_a = fc.dstWidthOffsetA[x];
+                    int xd_x = FillParameters::offset(fc.compXo, x);
+                    int xd_y = FillParameters::offset(fc.compYo, x);
+                    int xd_z = FillParameters::offset(fc.compZo, x);
+                    int xd_a = FillParameters::offset(fc.compAo, x);
 
                     auto xo = reinterpret_cast<DataType *>(line_x + xd_x);
                     auto yo = reinterpret_cast<DataType *>(line_y + xd_y);
@@ -224,7 +288,7 @@ namespace AkVCam
                 auto width = std::max<size_t>(8 * this->m_pixelSize[0] / this->m_format.bpp(), 1);
 
                 for (size_t x = 0; x < width; ++x) {
-                    int &xd_x = fc.dstWidthOffsetX[x];
+                    int xd_x = FillParameters::offset(fc.compXo, x);
                     auto xo = reinterpret_cast<DataType *>(line_x + xd_x);
                     *xo = (*xo & DataType(fc.maskXo)) | (DataType(xo_) << fc.xoShift);
                 }
@@ -247,8 +311,8 @@ namespace AkVCam
                 auto width = std::max<size_t>(8 * this->m_pixelSize[0] / this->m_format.bpp(), 1);
 
                 for (size_t x = 0; x < width; ++x) {
-                    int &xd_x = fc.dstWidthOffsetX[x];
-                    int &xd_a = fc.dstWidthOffsetA[x];
+                    int xd_x = FillParameters::offset(fc.compXo, x);
+                    int xd_a = FillParameters::offset(fc.compAo, x);
 
                     auto xo = reinterpret_cast<DataType *>(line_x + xd_x);
                     auto ao = reinterpret_cast<DataType *>(line_a + xd_a);
@@ -281,9 +345,9 @@ namespace AkVCam
                 auto width = std::max<size_t>(8 * this->m_pixelSize[0] / this->m_format.bpp(), 1);
 
                 for (size_t x = 0; x < width; ++x) {
-                    int &xd_x = fc.dstWidthOffsetX[x];
-                    int &xd_y = fc.dstWidthOffsetY[x];
-                    int &xd_z = fc.dstWidthOffsetZ[x];
+                    int xd_x = FillParameters::offset(fc.compXo, x);
+                    int xd_y = FillParameters::offset(fc.compYo, x);
+                    int xd_z = FillParameters::offset(fc.compZo, x);
 
                     auto xo = reinterpret_cast<DataType *>(line_x + xd_x);
                     auto yo = reinterpret_cast<DataType *>(line_y + xd_y);
@@ -316,10 +380,10 @@ namespace AkVCam
                 auto width = std::max<size_t>(8 * this->m_pixelSize[0] / this->m_format.bpp(), 1);
 
                 for (size_t x = 0; x < width; ++x) {
-                    int &xd_x = fc.dstWidthOffsetX[x];
-                    int &xd_y = fc.dstWidthOffsetY[x];
-                    int &xd_z = fc.dstWidthOffsetZ[x];
-                    int &xd_a = fc.dstWidthOffsetA[x];
+                    int xd_x = FillParameters::offset(fc.compXo, x);
+                    int xd_y = FillParameters::offset(fc.compYo, x);
+                    int xd_z = FillParameters::offset(fc.compZo, x);
+                    int xd_a = FillParameters::offset(fc.compAo, x);
 
                     auto xo = reinterpret_cast<DataType *>(line_x + xd_x);
                     auto yo = reinterpret_cast<DataType *>(line_y + xd_y);
@@ -384,6 +448,9 @@ namespace AkVCam
             }
 
             inline void fill(Rgb color);
+
+            // Repeats the pattern over the pixels of the plane.
+            void fill(size_t plane, const uint8_t *pattern, size_t patternSize);
     };
 
     struct BmpHeader
@@ -422,34 +489,77 @@ AkVCam::VideoFrame::VideoFrame(const std::string &fileName)
 }
 
 AkVCam::VideoFrame::VideoFrame(const AkVCam::VideoFormat &format,
-                               bool initialized)
+                               bool initialized,
+                               size_t alignment)
 {
     this->d = new VideoFramePrivate;
     this->d->m_format = format;
-    auto specs = VideoFormat::formatSpecs(this->d->m_format.format());
+    this->d->m_align = AKVCAM_FRAME_ALIGNMENT;
+
+    while (this->d->m_align < alignment)
+        this->d->m_align <<= 1;
+
+    auto &specs = VideoFormat::formatSpecs(this->d->m_format.format());
     this->d->m_nPlanes = specs.planes();
     this->d->updateParams(specs);
 
-    if (this->d->m_dataSize > 0) {
-            this->d->m_data = new uint8_t [this->d->m_dataSize];
+    this->d->allocate();
 
-            if (initialized)
-                memset(this->d->m_data, 0, this->d->m_dataSize);
-    }
+    if (this->d->m_data && initialized)
+        memset(this->d->m_data.get(), 0, this->d->m_dataSize);
 
     this->d->updatePlanes();
 }
 
-AkVCam::VideoFrame::VideoFrame(const AkVCam::VideoFrame &other)
+AkVCam::VideoFrame::VideoFrame(const VideoFormat &format,
+                               uint8_t *const planes[],
+                               const size_t lineSizes[],
+                               const ReleaseCallback &release)
 {
     this->d = new VideoFramePrivate;
-    this->d->m_format = other.d->m_format;
+    this->d->m_format = format;
+
+    if (release)
+        this->d->m_external =
+                std::shared_ptr<void>(planes[0], [release] (void *) {
+                    release();
+                });
+
+    auto &specs = VideoFormat::formatSpecs(this->d->m_format.format());
+    this->d->m_nPlanes = specs.planes();
+    this->d->updateParams(specs);
+    this->d->m_dataSize = 0;
+
+    for (size_t i = 0; i < this->d->m_nPlanes; ++i) {
+        this->d->m_planes[i] = planes[i];
+        this->d->m_lineSize[i] = lineSizes[i];
+        this->d->m_planeSize[i] =
+                lineSizes[i]
+                * ((this->d->m_format.height() + (1 << this->d->m_heightDiv[i]) - 1)
+                   >> this->d->m_heightDiv[i]);
+        this->d->m_planeOffset[i] = 0;
+
+        // Lowest power of two dividing the address of the plane and the
+        // line size.
+        auto bits = reinterpret_cast<uintptr_t>(planes[i]) | lineSizes[i];
+
+        if (bits)
+            this->d->m_align = std::min(this->d->m_align,
+                                        size_t(bits & (~bits + 1)));
+    }
+}
 
-    if (other.d->m_data && other.d->m_dataSize > 0) {
-        this->d->m_data = new uint8_t [other.d->m_dataSize];
-        memcpy(this->d->m_data, other.d->m_data, other.d->m_dataSize);
+AkVCam::VideoFrame::VideoFrame(const AkVCam::VideoFrame &other)
+{
+    if (!other.d) {
+        this->d = nullptr;
+
+        return;
     }
 
+    this->d = new VideoFramePrivate;
+    this->d->m_format = other.d->m_format;
+    this->d->m_data = other.d->m_data;
     this->d->m_dataSize = other.d->m_dataSize;
     this->d->m_nPlanes = other.d->m_nPlanes;
 
@@ -466,32 +576,38 @@ AkVCam::VideoFrame::VideoFrame(const AkVCam::VideoFrame &other)
 
     this->d->m_align = other.d->m_align;
     this->d->m_fc = other.d->m_fc;
-    this->d->updatePlanes();
+    this->d->m_external = other.d->m_external;
+    this->d->m_view = other.d->m_view;
+    this->d->copyTiming(other.d);
+    this->d->updatePlanes(other.d);
 }
 
-AkVCam::VideoFrame::~VideoFrame()
+AkVCam::VideoFrame::VideoFrame(VideoFrame &&other) noexcept
 {
-    if (this->d->m_data)
-        delete [] this->d->m_data;
+    this->d = other.d;
+    other.d = nullptr;
+}
 
+AkVCam::VideoFrame::~VideoFrame()
+{
     delete this->d;
 }
 
 AkVCam::VideoFrame &AkVCam::VideoFrame::operator =(const AkVCam::VideoFrame &other)
 {
     if (this != &other) {
-        this->d->m_format = other.d->m_format;
+        if (!other.d) {
+            delete this->d;
+            this->d = nullptr;
 
-        if (this->d->m_data) {
-            delete [] this->d->m_data;
-            this->d->m_data = nullptr;
+            return *this;
         }
 
-        if (other.d->m_data && other.d->m_dataSize > 0) {
-            this->d->m_data = new uint8_t [other.d->m_dataSize];
-            memcpy(this->d->m_data, other.d->m_data, other.d->m_dataSize);
-        }
+        if (!this->d)
+            this->d = new VideoFramePrivate;
 
+        this->d->m_format = other.d->m_format;
+        this->d->m_data = other.d->m_data;
         this->d->m_dataSize = other.d->m_dataSize;
         this->d->m_nPlanes = other.d->m_nPlanes;
 
@@ -507,15 +623,29 @@ AkVCam::VideoFrame &AkVCam::VideoFrame::operator =(const AkVCam::VideoFrame &oth
 
         this->d->m_align = other.d->m_align;
         this->d->m_fc = other.d->m_fc;
-        this->d->updatePlanes();
+        this->d->m_external = other.d->m_external;
+        this->d->m_view = other.d->m_view;
+        this->d->copyTiming(other.d);
+        this->d->updatePlanes(other.d);
     }
 
     return *this;
 }
 
+AkVCam::VideoFrame &AkVCam::VideoFrame::operator =(VideoFrame &&other) noexcept
+{
+    if (this != &other)
+        std::swap(this->d, other.d);
+
+    return *this;
+}
+
 AkVCam::VideoFrame::operator bool() const
 {
-    return this->d->m_format && this->d->m_data;
+    return this->d
+           && this->d->m_format
+           && (this->d->m_data
+               || (this->d->m_nPlanes > 0 && this->d->m_planes[0]));
 }
 
 // http://www.dragonwins.com/domains/getteched/bmp/bmpfileformat.htm
@@ -523,12 +653,17 @@ bool AkVCam::VideoFrame::load(const std::string &fileName)
 {
     AkLogFunction();
 
-    this->d->m_format = {};
+    if (!this->d)
+        this->d = new VideoFramePrivate;
 
-    if (this->d->m_data) {
-        delete [] this->d->m_data;
-        this->d->m_data = nullptr;
-    }
+    this->d->m_format = {};
+    this->d->m_data.reset();
+    this->d->m_external.reset();
+    this->d->m_view = false;
+    this->d->m_pts = -1;
+    this->d->m_captureTime = -1;
+    this->d->m_duration = 0;
+    this->d->m_sequence = 0;
 
     if (fileName.empty()) {
         AkLogError("The file name is empty");
@@ -578,19 +713,10 @@ bool AkVCam::VideoFrame::load(const std::string &fileName)
         this->d->m_format = {PixelFormat_argbpack,
                              int(imageHeader.width),
                              int(imageHeader.height)};
-
-        if (this->d->m_data) {
-            delete [] this->d->m_data;
-            this->d->m_data = nullptr;
-        }
-
-        auto specs = VideoFormat::formatSpecs(this->d->m_format.format());
+        auto &specs = VideoFormat::formatSpecs(this->d->m_format.format());
         this->d->m_nPlanes = specs.planes();
         this->d->updateParams(specs);
-
-        if (this->d->m_dataSize > 0)
-            this->d->m_data = new uint8_t [this->d->m_dataSize];
-
+        this->d->allocate();
         this->d->updatePlanes();
         data.resize(imageHeader.sizeImage);
         stream.read(reinterpret_cast<char *>(data.data()),
@@ -647,71 +773,125 @@ bool AkVCam::VideoFrame::load(const std::string &fileName)
 
 AkVCam::VideoFormat AkVCam::VideoFrame::format() const
 {
+    if (!this->d)
+        return {};
+
     return this->d->m_format;
 }
 
 size_t AkVCam::VideoFrame::size() const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_dataSize;
 }
 
 size_t AkVCam::VideoFrame::planes() const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_nPlanes;
 }
 
 size_t AkVCam::VideoFrame::planeSize(int plane) const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_planeSize[plane];
 }
 
 size_t AkVCam::VideoFrame::pixelSize(int plane) const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_pixelSize[plane];
 }
 
 size_t AkVCam::VideoFrame::lineSize(int plane) const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_lineSize[plane];
 }
 
 size_t AkVCam::VideoFrame::bytesUsed(int plane) const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_bytesUsed[plane];
 }
 
 size_t AkVCam::VideoFrame::widthDiv(int plane) const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_widthDiv[plane];
 }
 
 size_t AkVCam::VideoFrame::heightDiv(int plane) const
 {
+    if (!this->d)
+        return 0;
+
     return this->d->m_heightDiv[plane];
 }
 
+size_t AkVCam::VideoFrame::alignment() const
+{
+    if (!this->d)
+        return 0;
+
+    return this->d->m_align;
+}
+
 const uint8_t *AkVCam::VideoFrame::constData() const
 {
-    return reinterpret_cast<uint8_t *>(this->d->m_data);
+    if (!this->d)
+        return nullptr;
+
+    return this->d->m_data.get();
 }
 
 uint8_t *AkVCam::VideoFrame::data()
 {
-    return reinterpret_cast<uint8_t *>(this->d->m_data);
+    if (!this->d)
+        return nullptr;
+
+    this->d->detach();
+
+    return this->d->m_data.get();
 }
 
 const uint8_t *AkVCam::VideoFrame::constPlane(int plane) const
 {
+    if (!this->d)
+        return nullptr;
+
     return this->d->m_planes[plane];
 }
 
 uint8_t *AkVCam::VideoFrame::plane(int plane)
 {
+    if (!this->d)
+        return nullptr;
+
+    this->d->detach();
+
     return this->d->m_planes[plane];
 }
 
 const uint8_t *AkVCam::VideoFrame::constLine(int plane, int y) const
 {
+    if (!this->d)
+        return nullptr;
+
     return this->d->m_planes[plane]
             + size_t(y >> this->d->m_heightDiv[plane])
             * this->d->m_lineSize[plane];
@@ -719,6 +899,11 @@ const uint8_t *AkVCam::VideoFrame::constLine(int plane, int y) const
 
 uint8_t *AkVCam::VideoFrame::line(int plane, int y)
 {
+    if (!this->d)
+        return nullptr;
+
+    this->d->detach();
+
     return this->d->m_planes[plane]
             + size_t(y >> this->d->m_heightDiv[plane])
             * this->d->m_lineSize[plane];
@@ -729,46 +914,330 @@ AkVCam::VideoFrame AkVCam::VideoFrame::copy(int x,
                                             int width,
                                             int height) const
 {
+    if (!this->d)
+        return {};
+
     auto ocaps = this->d->m_format;
     ocaps.setWidth(width);
     ocaps.setHeight(height);
     VideoFrame dst(ocaps, true);
+    dst.d->copyTiming(this->d);
+    auto src = this->constView(x, y, width, height);
 
-    auto maxX = std::min(x + width, this->d->m_format.width());
-    auto maxY = std::min(y + height, this->d->m_format.height());
-    auto copyWidth = std::max(maxX - x, 0);
-
-    if (copyWidth < 1)
+    if (!src)
         return dst;
 
-    auto diffY = maxY - y;
-
-    for (int plane = 0; plane < this->d->m_nPlanes; plane++) {
-        size_t offset = x
-                        * this->d->m_bytesUsed[plane]
-                        / this->d->m_format.width();
-        size_t copyBytes = copyWidth
-                           * this->d->m_bytesUsed[plane]
-                           / this->d->m_format.width();
-        auto srcLineOffset = this->d->m_lineSize[plane];
-        auto dstLineOffset = dst.d->m_lineSize[plane];
-        auto srcLine = this->constLine(plane, y) + offset;
+    auto srcHeight = src.d->m_format.height();
+
+    for (size_t plane = 0; plane < this->d->m_nPlanes; plane++) {
+        auto copyBytes = std::min(src.d->m_bytesUsed[plane],
+                                  dst.d->m_bytesUsed[plane]);
+        auto heightDiv = this->d->m_heightDiv[plane];
+        int lines = (srcHeight + (1 << heightDiv) - 1) >> heightDiv;
+        auto srcLine = src.d->m_planes[plane];
         auto dstLine = dst.d->m_planes[plane];
-        auto maxY = diffY >> this->d->m_heightDiv[plane];
 
-        for (int y = 0; y < maxY; y++) {
+        for (int i = 0; i < lines; i++) {
             memcpy(dstLine, srcLine, copyBytes);
-            srcLine += srcLineOffset;
-            dstLine += dstLineOffset;
+            srcLine += src.d->m_lineSize[plane];
+            dstLine += dst.d->m_lineSize[plane];
         }
     }
 
     return dst;
 }
 
+AkVCam::VideoFrame AkVCam::VideoFrame::constView(int x,
+                                                 int y,
+                                                 int width,
+                                                 int height) const
+{
+    if (!this->d)
+        return {};
+
+    VideoFormat format;
+    uint8_t *planes[MAX_PLANES];
+
+    if (!this->d->viewPlanes(x, y, width, height, format, planes))
+        return {};
+
+    VideoFrame view(format, planes, this->d->m_lineSize);
+    view.d->m_view = true;
+    view.d->copyTiming(this->d);
+
+    // Keep the pixels alive, and make the writes to this frame detach it.
+
+    if (this->d->m_data)
+        view.d->m_external = this->d->m_data;
+    else
+        view.d->m_external = this->d->m_external;
+
+    return view;
+}
+
+AkVCam::VideoFrame AkVCam::VideoFrame::view(int x,
+                                            int y,
+                                            int width,
+                                            int height)
+{
+    if (!this->d)
+        return {};
+
+    this->d->detach();
+    VideoFormat format;
+    uint8_t *planes[MAX_PLANES];
+
+    if (!this->d->viewPlanes(x, y, width, height, format, planes))
+        return {};
+
+    VideoFrame view(format, planes, this->d->m_lineSize);
+    view.d->copyTiming(this->d);
+
+    return view;
+}
+
+bool AkVCam::VideoFrame::isBorrowed() const
+{
+    if (!this->d)
+        return false;
+
+    return !this->d->m_data
+           && !this->d->m_external
+           && this->d->m_nPlanes > 0
+           && this->d->m_planes[0];
+}
+
+size_t AkVCam::VideoFrame::copyTo(uint8_t *data, size_t size) const
+{
+    if (!data || !*this)
+        return 0;
+
+    // The allocated frames already have the same layout.
+
+    if (this->d->m_data) {
+        size = std::min(size, this->d->m_dataSize);
+        memcpy(data, this->d->m_data.get(), size);
+
+        return size;
+    }
+
+    VideoFramePrivate layout;
+    layout.m_format = this->d->m_format;
+    layout.updateParams(VideoFormat::formatSpecs(layout.m_format.format()));
+
+    for (size_t plane = 0; plane < this->d->m_nPlanes; ++plane) {
+        auto srcLine = this->d->m_planes[plane];
+        auto srcLineSize = this->d->m_lineSize[plane];
+        auto dstLineSize = layout.m_lineSize[plane];
+        auto offset = layout.m_planeOffset[plane];
+        auto bytesUsed = std::min(this->d->m_bytesUsed[plane], srcLineSize);
+        auto heightDiv = this->d->m_heightDiv[plane];
+        int lines = (this->d->m_format.height() + (1 << heightDiv) - 1)
+                    >> heightDiv;
+
+        for (int y = 0; y < lines && offset < size; ++y) {
+            memcpy(data + offset, srcLine, std::min(bytesUsed, size - offset));
+            srcLine += srcLineSize;
+            offset += dstLineSize;
+        }
+    }
+
+    return std::min(size, layout.m_dataSize);
+}
+
+int64_t AkVCam::VideoFrame::pts() const
+{
+    if (!this->d)
+        return -1;
+
+    return this->d->m_pts;
+}
+
+void AkVCam::VideoFrame::setPts(int64_t pts)
+{
+    if (!this->d)
+        this->d = new VideoFramePrivate;
+
+    this->d->m_pts = pts;
+}
+
+int64_t AkVCam::VideoFrame::captureTime() const
+{
+    if (!this->d)
+        return -1;
+
+    return this->d->m_captureTime;
+}
+
+void AkVCam::VideoFrame::setCaptureTime(int64_t captureTime)
+{
+    if (!this->d)
+        this->d = new VideoFramePrivate;
+
+    this->d->m_captureTime = captureTime;
+}
+
+int64_t AkVCam::VideoFrame::duration() const
+{
+    if (!this->d)
+        return 0;
+
+    return this->d->m_duration;
+}
+
+void AkVCam::VideoFrame::setDuration(int64_t duration)
+{
+    if (!this->d)
+        this->d = new VideoFramePrivate;
+
+    this->d->m_duration = duration;
+}
+
+int64_t AkVCam::VideoFrame::latency() const
+{
+    auto captureTime = this->captureTime();
+
+    if (captureTime < 0)
+        return -1;
+
+    return monotonicTime() - captureTime;
+}
+
+uint64_t AkVCam::VideoFrame::sequence() const
+{
+    if (!this->d)
+        return 0;
+
+    return this->d->m_sequence;
+}
+
+void AkVCam::VideoFrame::setSequence(uint64_t sequence)
+{
+    if (!this->d)
+        this->d = new VideoFramePrivate;
+
+    this->d->m_sequence = sequence;
+}
+
+void AkVCam::VideoFrame::copyTiming(const VideoFrame &other)
+{
+    if (!this->d)
+        this->d = new VideoFramePrivate;
+
+    if (other.d) {
+        this->d->copyTiming(other.d);
+    } else {
+        VideoFramePrivate timing;
+        this->d->copyTiming(&timing);
+    }
+}
+
+uint64_t AkVCam::VideoFrame::droppedFrames(const VideoFrame &previous,
+                                          const VideoFrame &frame,
+                                          uint64_t sentSequence)
+{
+    uint64_t dropped = 0;
+
+    if (previous.sequence() > 0 && frame.sequence() > previous.sequence() + 1)
+        dropped = frame.sequence() - previous.sequence() - 1;
+
+    auto duration = previous.duration();
+
+    if (previous.pts() >= 0 && frame.pts() > previous.pts() && duration > 0) {
+        // Round to the nearest number of frames, to tolerate jitter.
+        auto periods = (frame.pts() - previous.pts() + duration / 2) / duration;
+
+        if (periods > 1)
+            dropped = std::max(dropped, uint64_t(periods - 1));
+    }
+
+    if (previous.sequence() > 0 && previous.sequence() != sentSequence)
+        dropped++;
+
+    return dropped;
+}
+
+void AkVCam::VideoFrame::detach()
+{
+    if (this->d)
+        this->d->detach();
+}
+
+void AkVCam::VideoFrame::fill(int plane,
+                              const uint8_t *pattern,
+                              size_t patternSize)
+{
+    if (!this->d)
+        return;
+
+    this->d->detach();
+    this->d->fill(size_t(plane), pattern, patternSize);
+}
+
 void AkVCam::VideoFrame::fillRgb(Rgb color)
 {
-    return this->d->fill(color);
+    if (!this->d)
+        return;
+
+    this->d->detach();
+    this->d->fill(color);
+}
+
+size_t AkVCam::VideoFrame::pageSize()
+{
+    static const size_t pageSize = [] () {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        return size_t(info.dwPageSize);
+#else
+        return size_t(sysconf(_SC_PAGESIZE));
+#endif
+    } ();
+
+    return pageSize;
+}
+
+int64_t AkVCam::VideoFrame::monotonicTime()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void *AkVCam::VideoFramePrivate::operator new(size_t size)
+{
+    // The buffer holding the object is stored before it.
+
+    auto buffer =
+            FrameBufferPool::instance().buffer(headerSize() + size,
+                                               alignof(std::max_align_t));
+    auto data = buffer.get();
+    new (data) VideoFrameBuffer(std::move(buffer));
+
+    return data + headerSize();
+}
+
+void AkVCam::VideoFramePrivate::operator delete(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    auto header =
+            reinterpret_cast<VideoFrameBuffer *>(static_cast<uint8_t *>(ptr)
+                                                 - headerSize());
+
+    // The buffer goes back to the pool when released, after the header is
+    // destroyed.
+    auto buffer = std::move(*header);
+    header->~VideoFrameBuffer();
+}
+
+size_t AkVCam::VideoFramePrivate::headerSize()
+{
+    return Algorithm::alignUp(sizeof(VideoFrameBuffer),
+                              alignof(std::max_align_t));
 }
 
 void AkVCam::VideoFramePrivate::updateParams(const VideoFormatSpec &specs)
@@ -779,24 +1248,30 @@ void AkVCam::VideoFramePrivate::updateParams(const VideoFormatSpec &specs)
     for (size_t i = 0; i < specs.planes(); ++i) {
         auto &plane = specs.plane(i);
 
-        // Calculate bytes used per line (bits per pixel * width / 8)
-        size_t bytesUsed = plane.bitsSize() * this->m_format.width() / 8;
+        // Calculate bytes used per line (bits per pixel * width / 8), the
+        // last chroma sample must be allocated for odd widths
+        size_t samples = (this->m_format.width() + (1 << plane.widthDiv()) - 1)
+                         >> plane.widthDiv();
+        size_t bytesUsed = (plane.bitsSize() << plane.widthDiv()) * samples / 8;
 
         // Align line size for SIMD compatibility
         size_t lineSize =
-                Algorithm::alignUp(bytesUsed, size_t(this->m_align));
+                Algorithm::alignUp(bytesUsed, size_t(AKVCAM_FRAME_ALIGNMENT));
 
         // Store pixel size, line size, and bytes used
         this->m_pixelSize[i] = plane.pixelSize();
         this->m_lineSize[i] = lineSize;
         this->m_bytesUsed[i] = bytesUsed;
 
-        // Calculate plane size, considering sub-sampling
-        size_t planeSize = (lineSize * this->m_format.height()) >> plane.heightDiv();
+        // Calculate plane size, considering sub-sampling, the last line
+        // must be allocated for odd heights
+        size_t lines = (this->m_format.height() + (1 << plane.heightDiv()) - 1)
+                       >> plane.heightDiv();
+        size_t planeSize = lineSize * lines;
 
         // Align plane size to ensure next plane starts aligned
         planeSize =
-                Algorithm::alignUp(planeSize, size_t(this->m_align));
+                Algorithm::alignUp(planeSize, size_t(AKVCAM_FRAME_ALIGNMENT));
 
         // Store plane size and offset
         this->m_planeSize[i] = planeSize;
@@ -815,10 +1290,142 @@ void AkVCam::VideoFramePrivate::updateParams(const VideoFormatSpec &specs)
             Algorithm::alignUp(this->m_dataSize, size_t(this->m_align));
 }
 
+void AkVCam::VideoFramePrivate::allocate()
+{
+    if (this->m_dataSize > 0)
+        this->m_data = FrameBufferPool::instance().buffer(this->m_dataSize,
+                                                          this->m_align);
+    else
+        this->m_data.reset();
+}
+
 void AkVCam::VideoFramePrivate::updatePlanes()
 {
     for (int i = 0; i < this->m_nPlanes; ++i)
-        this->m_planes[i] = this->m_data + this->m_planeOffset[i];
+        this->m_planes[i] = this->m_data.get() + this->m_planeOffset[i];
+}
+
+void AkVCam::VideoFramePrivate::updatePlanes(const VideoFramePrivate *other)
+{
+    if (this->m_data || !other->m_nPlanes) {
+        this->updatePlanes();
+
+        return;
+    }
+
+    for (size_t i = 0; i < this->m_nPlanes; ++i)
+        this->m_planes[i] = other->m_planes[i];
+}
+
+void AkVCam::VideoFramePrivate::copyTiming(const VideoFramePrivate *other)
+{
+    this->m_pts = other->m_pts;
+    this->m_captureTime = other->m_captureTime;
+    this->m_duration = other->m_duration;
+    this->m_sequence = other->m_sequence;
+}
+
+void AkVCam::VideoFramePrivate::detach()
+{
+    /* The pixels are released when the last frame referencing them is
+     * destroyed. If this is not the only one, the pixels are copied, so
+     * modifying them doesn't modify the copies of this frame.
+     */
+
+    if (this->m_view) {
+        this->detachView();
+
+        return;
+    }
+
+    if (!this->m_data || this->m_data.use_count() < 2)
+        return;
+
+    auto data = this->m_data;
+    this->allocate();
+    memcpy(this->m_data.get(), data.get(), this->m_dataSize);
+    this->updatePlanes();
+}
+
+void AkVCam::VideoFramePrivate::detachView()
+{
+    uint8_t *planes[MAX_PLANES];
+    size_t lineSize[MAX_PLANES];
+    size_t bytesUsed[MAX_PLANES];
+    memcpy(planes, this->m_planes, MAX_PLANES * sizeof(uint8_t *));
+    memcpy(lineSize, this->m_lineSize, MAX_PLANES * sizeof(size_t));
+    memcpy(bytesUsed, this->m_bytesUsed, MAX_PLANES * sizeof(size_t));
+
+    // Keep the referenced pixels alive until these are copied.
+    auto external = std::move(this->m_external);
+    this->m_view = false;
+
+    this->m_align = AKVCAM_FRAME_ALIGNMENT;
+    this->updateParams(VideoFormat::formatSpecs(this->m_format.format()));
+    this->allocate();
+    this->updatePlanes();
+
+    for (size_t plane = 0; plane < this->m_nPlanes; ++plane) {
+        auto copyBytes = std::min(bytesUsed[plane], this->m_bytesUsed[plane]);
+        auto heightDiv = this->m_heightDiv[plane];
+        int lines = (this->m_format.height() + (1 << heightDiv) - 1)
+                    >> heightDiv;
+        auto srcLine = planes[plane];
+        auto dstLine = this->m_planes[plane];
+
+        for (int i = 0; i < lines; i++) {
+            memcpy(dstLine, srcLine, copyBytes);
+            srcLine += lineSize[plane];
+            dstLine += this->m_lineSize[plane];
+        }
+    }
+}
+
+bool AkVCam::VideoFramePrivate::viewPlanes(int x,
+                                           int y,
+                                           int width,
+                                           int height,
+                                           VideoFormat &format,
+                                           uint8_t **planes) const
+{
+    if (!this->m_format
+        || (!this->m_data
+            && (this->m_nPlanes < 1 || !this->m_planes[0])))
+        return false;
+
+    size_t widthDiv = 0;
+    size_t heightDiv = 0;
+
+    for (size_t plane = 0; plane < this->m_nPlanes; ++plane) {
+        widthDiv = std::max(widthDiv, this->m_widthDiv[plane]);
+        heightDiv = std::max(heightDiv, this->m_heightDiv[plane]);
+    }
+
+    Rect rect = Rect(0, 0, this->m_format.width(), this->m_format.height())
+                    .intersected({x & ~((1 << widthDiv) - 1),
+                                  y & ~((1 << heightDiv) - 1),
+                                  width,
+                                  height});
+
+    if (rect.isEmpty())
+        return false;
+
+    format = this->m_format;
+    format.setWidth(rect.width());
+    format.setHeight(rect.height());
+    auto &specs = VideoFormat::formatSpecs(format.format());
+
+    for (size_t plane = 0; plane < this->m_nPlanes; ++plane) {
+        auto &planeSpecs = specs.plane(plane);
+        size_t bytesPerBlock = (planeSpecs.bitsSize() << planeSpecs.widthDiv()) / 8;
+        planes[plane] = this->m_planes[plane]
+                        + size_t(rect.y() >> planeSpecs.heightDiv())
+                          * this->m_lineSize[plane]
+                        + size_t(rect.x() >> planeSpecs.widthDiv())
+                          * bytesPerBlock;
+    }
+
+    return true;
 }
 
 #define DEFINE_FILL_FUNC(size) \
@@ -833,11 +1440,10 @@ void AkVCam::VideoFramePrivate::updatePlanes()
 
 void AkVCam::VideoFramePrivate::fill(Rgb color)
 {
-    if (!this->m_fc) {
-        this->m_fc = FillParametersPtr(new FillParameters);
-        this->m_fc->configure(this->m_format, this->m_fc->colorConvert);
-        this->m_fc->configureFill(this->m_format);
-    }
+    if (!this->m_fc)
+        this->m_fc = FillParameters::parameters(this->m_format.format());
+
+    // Write the first block of pixels of each plane, and then repeat it.
 
     switch (this->m_fc->fillDataTypes) {
     DEFINE_FILL_FUNC(8)
@@ -848,25 +1454,47 @@ void AkVCam::VideoFramePrivate::fill(Rgb color)
         break;
     }
 
-    for (size_t plane = 0; plane < this->m_nPlanes; plane++) {
-        auto &lineSize = this->m_lineSize[plane];
-        auto &pixelSize = this->m_pixelSize[plane];
-        auto line0 = this->m_planes[plane];
-        auto line = line0 + pixelSize;
-        auto width = lineSize / pixelSize;
-        auto height = this->m_fc->height >> this->m_heightDiv[plane];
-
-        for (int x = 1; x < width; ++x) {
-            memcpy(line, line0, pixelSize);
-            line += pixelSize;
-        }
+    for (size_t plane = 0; plane < this->m_nPlanes; plane++)
+        this->fill(plane, this->m_planes[plane], this->m_pixelSize[plane]);
+}
 
-        line = line0 + lineSize;
+void AkVCam::VideoFramePrivate::fill(size_t plane,
+                                     const uint8_t *pattern,
+                                     size_t patternSize)
+{
+    auto lineSize = this->m_lineSize[plane];
+    auto line0 = this->m_planes[plane];
+    auto height = (this->m_format.height() + (1 << this->m_heightDiv[plane]) - 1)
+                  >> this->m_heightDiv[plane];
 
-        for (int y = 1; y < height; ++y) {
-            memcpy(line, line0, lineSize);
-            line += lineSize;
-        }
+    if (patternSize < 1 || height < 1)
+        return;
+
+    if (pattern != line0)
+        memcpy(line0, pattern, patternSize);
+
+    /* The lines of the frames owning their pixels are contiguous, so when
+     * the pattern fits an exact number of times in a line, the whole plane
+     * is filled at once. The frames wrapping other memory only fill the
+     * bytes used by the pixels, the rest of the line can belong to other
+     * frame.
+     */
+
+    if (this->m_data && lineSize % patternSize == 0) {
+        Simd::fill(line0, lineSize * size_t(height), patternSize);
+
+        return;
+    }
+
+    auto fillSize = this->m_data?
+                        lineSize / patternSize * patternSize:
+                        this->m_bytesUsed[plane];
+    Simd::fill(line0, fillSize, patternSize);
+    auto line = line0 + lineSize;
+
+    for (int y = 1; y < height; ++y) {
+        memcpy(line, line0, fillSize);
+        line += lineSize;
     }
 }
 
@@ -880,8 +1508,6 @@ AkVCam::FillParameters::FillParameters(const FillParameters &other):
     fillDataTypes(other.fillDataTypes),
     alphaMode(other.alphaMode),
     endianess(other.endianess),
-    width(other.width),
-    height(other.height),
     planeXo(other.planeXo),
     planeYo(other.planeYo),
     planeZo(other.planeZo),
@@ -903,34 +1529,10 @@ AkVCam::FillParameters::FillParameters(const FillParameters &other):
     maskZo(other.maskZo),
     maskAo(other.maskAo)
 {
-    if (this->width > 0) {
-        size_t oWidthDataSize = sizeof(int) * this->width;
-
-        if (other.dstWidthOffsetX) {
-            this->dstWidthOffsetX = new int [this->width];
-            memcpy(this->dstWidthOffsetX, other.dstWidthOffsetX, oWidthDataSize);
-        }
-
-        if (other.dstWidthOffsetY) {
-            this->dstWidthOffsetY = new int [this->width];
-            memcpy(this->dstWidthOffsetY, other.dstWidthOffsetY, oWidthDataSize);
-        }
-
-        if (other.dstWidthOffsetZ) {
-            this->dstWidthOffsetZ = new int [this->width];
-            memcpy(this->dstWidthOffsetZ, other.dstWidthOffsetZ, oWidthDataSize);
-        }
-
-        if (other.dstWidthOffsetA) {
-            this->dstWidthOffsetA = new int [this->width];
-            memcpy(this->dstWidthOffsetA, other.dstWidthOffsetA, oWidthDataSize);
-        }
-    }
 }
 
 AkVCam::FillParameters::~FillParameters()
 {
-    this->clearBuffers();
 }
 
 AkVCam::FillParameters &AkVCam::FillParameters::operator =(const FillParameters &other)
@@ -941,8 +1543,6 @@ AkVCam::FillParameters &AkVCam::FillParameters::operator =(const FillParameters
         this->fillDataTypes = other.fillDataTypes;
         this->alphaMode = other.alphaMode;
         this->endianess = other.endianess;
-        this->width = other.width;
-        this->height = other.height;
         this->planeXo = other.planeXo;
         this->planeYo = other.planeYo;
         this->planeZo = other.planeZo;
@@ -963,79 +1563,42 @@ AkVCam::FillParameters &AkVCam::FillParameters::operator =(const FillParameters
         this->maskYo = other.maskYo;
         this->maskZo = other.maskZo;
         this->maskAo = other.maskAo;
-
-        if (this->width > 0) {
-            size_t oWidthDataSize = sizeof(int) * this->width;
-
-            if (other.dstWidthOffsetX) {
-                this->dstWidthOffsetX = new int [this->width];
-                memcpy(this->dstWidthOffsetX, other.dstWidthOffsetX, oWidthDataSize);
-            }
-
-            if (other.dstWidthOffsetY) {
-                this->dstWidthOffsetY = new int [this->width];
-                memcpy(this->dstWidthOffsetY, other.dstWidthOffsetY, oWidthDataSize);
-            }
-
-            if (other.dstWidthOffsetZ) {
-                this->dstWidthOffsetZ = new int [this->width];
-                memcpy(this->dstWidthOffsetZ, other.dstWidthOffsetZ, oWidthDataSize);
-            }
-
-            if (other.dstWidthOffsetA) {
-                this->dstWidthOffsetA = new int [this->width];
-                memcpy(this->dstWidthOffsetA, other.dstWidthOffsetA, oWidthDataSize);
-            }
-        }
     }
 
     return *this;
 }
 
-void AkVCam::FillParameters::clearBuffers()
+int AkVCam::FillParameters::offset(const ColorComponent &component, size_t x)
 {
-    if (this->dstWidthOffsetX) {
-        delete [] this->dstWidthOffsetX;
-        this->dstWidthOffsetX = nullptr;
-    }
-
-    if (this->dstWidthOffsetY) {
-        delete [] this->dstWidthOffsetY;
-        this->dstWidthOffsetY = nullptr;
-    }
-
-    if (this->dstWidthOffsetZ) {
-        delete [] this->dstWidthOffsetZ;
-        this->dstWidthOffsetZ = nullptr;
-    }
-
-    if (this->dstWidthOffsetA) {
-        delete [] this->dstWidthOffsetA;
-        this->dstWidthOffsetA = nullptr;
-    }
+    return int((x >> component.widthDiv()) * component.step());
 }
 
-void AkVCam::FillParameters::allocateBuffers(const VideoFormat &caps)
+AkVCam::FillParametersPtr AkVCam::FillParameters::parameters(PixelFormat format)
 {
-    this->clearBuffers();
+    static std::mutex mutex;
+    static std::map<PixelFormat, FillParametersPtr> parameters;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &fc = parameters[format];
 
-    if (caps.width() > 0) {
-        this->dstWidthOffsetX = new int [caps.width()];
-        this->dstWidthOffsetY = new int [caps.width()];
-        this->dstWidthOffsetZ = new int [caps.width()];
-        this->dstWidthOffsetA = new int [caps.width()];
+    if (!fc) {
+        auto newFc = std::make_shared<FillParameters>();
+        newFc->configure({format, 0, 0}, newFc->colorConvert);
+        fc = newFc;
     }
+
+    return fc;
 }
 
 #define DEFINE_FILL_TYPES(size) \
-    if (ospecs.depth() == size) \
+    if (8 * ospecs.byteDepth() == size) \
         this->fillDataTypes = FillDataTypes_##size;
 
 void AkVCam::FillParameters::configure(const VideoFormat &caps,
                                        ColorConvert &colorConvert)
 {
-    auto ispecs = VideoFormat::formatSpecs(PixelFormat_xrgbpack);
-    auto ospecs = VideoFormat::formatSpecs(caps.format());
+    auto &ispecs = VideoFormat::formatSpecs(PixelFormat_argbpack);
+    auto &ospecs = VideoFormat::formatSpecs(caps.format());
 
     DEFINE_FILL_TYPES(8);
     DEFINE_FILL_TYPES(16);
@@ -1121,21 +1684,6 @@ void AkVCam::FillParameters::configure(const VideoFormat &caps,
                           AlphaMode_O;
 }
 
-void AkVCam::FillParameters::configureFill(const VideoFormat &caps)
-{
-    this->allocateBuffers(caps);
-
-    for (int x = 0; x < caps.width(); ++x) {
-        this->dstWidthOffsetX[x] = (x >> this->compXo.widthDiv()) * this->compXo.step();
-        this->dstWidthOffsetY[x] = (x >> this->compYo.widthDiv()) * this->compYo.step();
-        this->dstWidthOffsetZ[x] = (x >> this->compZo.widthDiv()) * this->compZo.step();
-        this->dstWidthOffsetA[x] = (x >> this->compAo.widthDiv()) * this->compAo.step();
-    }
-
-    this->width = caps.width();
-    this->height = caps.height();
-}
-
 void AkVCam::FillParameters::reset()
 {
     this->fillType = FillType_3;
@@ -1144,11 +1692,6 @@ void AkVCam::FillParameters::reset()
 
     this->endianess = ENDIANNESS_BO;
 
-    this->clearBuffers();
-
-    this->width = 0;
-    this->height = 0;
-
     this->planeXo = 0;
     this->planeYo = 0;
     this->planeZo = 0;
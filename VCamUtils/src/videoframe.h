@@ -20,6 +20,7 @@
 #ifndef AKVCAMUTILS_VIDEOFRAME_H
 #define AKVCAMUTILS_VIDEOFRAME_H
 
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
@@ -31,17 +32,49 @@ namespace AkVCam
 {
     using Rgb = uint32_t;
 
+    class VideoConverterPrivate;
     class VideoFramePrivate;
     class VideoFormat;
 
+    /* The pixels are shared between the copies of a frame, and they are
+     * copied the first time one of the copies is modified through data(),
+     * plane(), line() or any of the functions writing to the frame.
+     */
     class VideoFrame
     {
         public:
+            using ReleaseCallback = std::function<void ()>;
+
             VideoFrame();
             VideoFrame(const std::string &fileName);
-            VideoFrame(const VideoFormat &format, bool initialized=false);
+
+            /* Allocates a frame of the given format.
+             *
+             * The buffer is aligned to the given alignment, rounded up to a
+             * power of two and to AKVCAM_FRAME_ALIGNMENT. Use pageSize() for
+             * page aligned buffers.
+             */
+            VideoFrame(const VideoFormat &format,
+                       bool initialized=false,
+                       size_t alignment=AKVCAM_FRAME_ALIGNMENT);
+
+            /* Wraps the planes of an external buffer without copying it.
+             *
+             * Without a release callback the memory is borrowed, the frame
+             * and its copies must not outlive it, so these can only be used
+             * for the duration of a call, use copy() for keeping the pixels.
+             * With a release callback the frame and its copies keep the
+             * memory alive, and the callback is called when the last of them
+             * is destroyed. Writing to the frame writes to the memory.
+             */
+            VideoFrame(const VideoFormat &format,
+                       uint8_t *const planes[],
+                       const size_t lineSizes[],
+                       const ReleaseCallback &release={});
             VideoFrame(const VideoFrame &other);
+            VideoFrame(VideoFrame &&other) noexcept;
             VideoFrame &operator =(const VideoFrame &other);
+            VideoFrame &operator =(VideoFrame &&other) noexcept;
             operator bool() const;
             ~VideoFrame();
 
@@ -55,6 +88,11 @@ namespace AkVCam
             size_t bytesUsed(int plane) const;
             size_t widthDiv(int plane) const;
             size_t heightDiv(int plane) const;
+
+            // Alignment of the buffer, the planes and the lines. Frames
+            // wrapping external memory report the alignment of their planes
+            // and lines.
+            size_t alignment() const;
             const uint8_t *constData() const;
             uint8_t *data();
             const uint8_t *constPlane(int plane) const;
@@ -66,6 +104,74 @@ namespace AkVCam
                             int width,
                             int height) const;
 
+            /* Returns a frame that references the pixels of the given
+             * rectangle of this frame, without copying them. The rectangle
+             * is clipped to the frame, and its origin aligned to the chroma
+             * subsampling.
+             *
+             * The view returned by constView() shares the pixels like a copy
+             * of this frame does, so it keeps them alive, and writing to any
+             * of both copies the pixels first.
+             *
+             * The view returned by view() copies the pixels of this frame if
+             * these are shared, and writing to the view modifies this frame.
+             * That view does not own the memory, so it must not outlive this
+             * frame, and copying it gives another view of the same pixels.
+             */
+            VideoFrame constView(int x, int y, int width, int height) const;
+            VideoFrame view(int x, int y, int width, int height);
+
+            // Returns true if the frame references memory that it doesn't
+            // keep alive.
+            bool isBorrowed() const;
+
+            // Copies the pixels to data, with the layout of the frames
+            // allocated by VideoFrame(format), and returns the number of
+            // bytes copied.
+            size_t copyTo(uint8_t *data, size_t size) const;
+
+            /* Timing of the frame in nanoseconds.
+             *
+             * The presentation timestamp is in the clock of the producer,
+             * while the capture time is in the monotonic clock of the
+             * system, see monotonicTime(), so the latency of the frame can
+             * be measured from other processes. Negative timestamps and a
+             * zero duration are unknown.
+             */
+            int64_t pts() const;
+            void setPts(int64_t pts);
+            int64_t captureTime() const;
+            void setCaptureTime(int64_t captureTime);
+            int64_t duration() const;
+            void setDuration(int64_t duration);
+
+            // Time elapsed since the capture of the frame, or -1 if
+            // unknown.
+            int64_t latency() const;
+
+            // Sequence number of the frame, counting from 1, or 0 if
+            // unknown.
+            uint64_t sequence() const;
+            void setSequence(uint64_t sequence);
+
+            // Copies the timing and the sequence number of other frame.
+            void copyTiming(const VideoFrame &other);
+
+            /* Number of frames of a producer a stream will never show,
+             * counted when it receives frame after previous.
+             *
+             * The streams send the last frame received at their own frame
+             * rate, so the frames skipped while the producer runs faster
+             * are not dropped. Only the gaps in the sequence numbers, the
+             * gaps in the timestamps when the producer gives the duration
+             * of the frames, and previous if it's replaced before being
+             * sent, are counted. sentSequence is the sequence number of
+             * the last frame sent by the stream.
+             */
+            static uint64_t droppedFrames(const VideoFrame &previous,
+                                          const VideoFrame &frame,
+                                          uint64_t sentSequence);
+
             template <typename T>
             inline T pixel(int plane, int x, int y) const
             {
@@ -84,18 +190,9 @@ namespace AkVCam
             template <typename T>
             inline void fill(int plane, T value)
             {
-                int width = this->format().width() >> this->widthDiv(plane);
-                auto line = new T [width];
-
-                for (int x = 0; x < width; x++)
-                    line[x] = value;
-
-                size_t lineSize = width * sizeof(T);
-
-                for (int y = 0; y < this->format().height(); y++)
-                    memcpy(this->line(plane, y), line, lineSize);
-
-                delete [] line;
+                this->fill(plane,
+                           reinterpret_cast<const uint8_t *>(&value),
+                           sizeof(T));
             }
 
             template <typename T>
@@ -107,8 +204,24 @@ namespace AkVCam
 
             void fillRgb(Rgb color);
 
+            // Size of the memory pages of the system.
+            static size_t pageSize();
+
+            // Current time of the monotonic clock of the system in
+            // nanoseconds.
+            static int64_t monotonicTime();
+
         private:
+            // Null in the frames moved to other frames.
             VideoFramePrivate *d;
+
+            // Copies the pixels if these are shared with other frames.
+            void detach();
+
+            // Repeats the pattern over the pixels of the plane.
+            void fill(int plane, const uint8_t *pattern, size_t patternSize);
+
+        friend class VideoConverterPrivate;
     };
 }
 
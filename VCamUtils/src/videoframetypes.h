@@ -20,6 +20,13 @@
 #ifndef AKVCAMUTILS_VIDEOFRAMETYPES_H
 #define AKVCAMUTILS_VIDEOFRAMETYPES_H
 
+/* Default alignment in bytes of the frame buffers, the size of a cache line.
+ * The planes and the lines of the frames are always aligned to it, so the
+ * vector kernels can use aligned loads and never split a load between two
+ * cache lines.
+ */
+#define AKVCAM_FRAME_ALIGNMENT 64
+
 namespace AkVCam
 {
     enum Scaling
@@ -0,0 +1,162 @@
+/* akvirtualcamera, virtual camera for Mac and Windows.
+ * Copyright (C) 2020  Gonzalo Exequiel Pedone
+ *
+ * akvirtualcamera is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * akvirtualcamera is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with akvirtualcamera. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Web-Site: http://webcamoid.github.io/
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "workerpool.h"
+
+namespace AkVCam
+{
+    class WorkerPoolPrivate
+    {
+        public:
+            std::vector<std::thread> m_threads;
+            std::mutex m_mutex;
+            std::mutex m_runMutex;
+            std::condition_variable m_taskAvailable;
+            std::condition_variable m_tasksDone;
+            const WorkerPool::Task *m_task {nullptr};
+            int m_nTasks {0};
+            int m_nextTask {0};
+            int m_doneTasks {0};
+            uint64_t m_batch {0};
+            bool m_quit {false};
+
+            void startWorkers(int workers);
+            void stopWorkers();
+            void workerLoop();
+            void runTasks(std::unique_lock<std::mutex> &lock);
+    };
+}
+
+AkVCam::WorkerPool::WorkerPool()
+{
+    this->d = new WorkerPoolPrivate();
+}
+
+AkVCam::WorkerPool::~WorkerPool()
+{
+    this->d->stopWorkers();
+    delete this->d;
+}
+
+int AkVCam::WorkerPool::workers() const
+{
+    return int(this->d->m_threads.size());
+}
+
+void AkVCam::WorkerPool::setWorkers(int workers)
+{
+    std::lock_guard<std::mutex> runLock(this->d->m_runMutex);
+    workers = std::max(workers, 0);
+
+    if (size_t(workers) == this->d->m_threads.size())
+        return;
+
+    this->d->stopWorkers();
+    this->d->startWorkers(workers);
+}
+
+void AkVCam::WorkerPool::run(int nTasks, const Task &task)
+{
+    if (nTasks < 1)
+        return;
+
+    std::lock_guard<std::mutex> runLock(this->d->m_runMutex);
+
+    if (nTasks < 2 || this->d->m_threads.empty()) {
+        for (int i = 0; i < nTasks; ++i)
+            task(i);
+
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(this->d->m_mutex);
+    this->d->m_task = &task;
+    this->d->m_nTasks = nTasks;
+    this->d->m_nextTask = 0;
+    this->d->m_doneTasks = 0;
+    this->d->m_batch++;
+    this->d->m_taskAvailable.notify_all();
+    this->d->runTasks(lock);
+    this->d->m_tasksDone.wait(lock, [this] () {
+        return this->d->m_doneTasks >= this->d->m_nTasks;
+    });
+    this->d->m_task = nullptr;
+}
+
+void AkVCam::WorkerPoolPrivate::startWorkers(int workers)
+{
+    this->m_quit = false;
+
+    for (int i = 0; i < workers; ++i)
+        this->m_threads.emplace_back(&WorkerPoolPrivate::workerLoop, this);
+}
+
+void AkVCam::WorkerPoolPrivate::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_quit = true;
+        this->m_taskAvailable.notify_all();
+    }
+
+    for (auto &thread: this->m_threads)
+        if (thread.joinable())
+            thread.join();
+
+    this->m_threads.clear();
+}
+
+void AkVCam::WorkerPoolPrivate::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(this->m_mutex);
+    auto batch = this->m_batch;
+
+    for (;;) {
+        this->m_taskAvailable.wait(lock, [this, batch] () {
+            return this->m_quit || this->m_batch != batch;
+        });
+
+        if (this->m_quit)
+            break;
+
+        batch = this->m_batch;
+        this->runTasks(lock);
+    }
+}
+
+void AkVCam::WorkerPoolPrivate::runTasks(std::unique_lock<std::mutex> &lock)
+{
+    while (this->m_nextTask < this->m_nTasks) {
+        auto index = this->m_nextTask++;
+        auto task = this->m_task;
+        lock.unlock();
+        (*task)(index);
+        lock.lock();
+
+        if (++this->m_doneTasks >= this->m_nTasks)
+            this->m_tasksDone.notify_all();
+    }
+}
@@ -0,0 +1,55 @@
+/* akvirtualcamera, virtual camera for Mac and Windows.
+ * Copyright (C) 2020  Gonzalo Exequiel Pedone
+ *
+ * akvirtualcamera is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * akvirtualcamera is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with akvirtualcamera. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Web-Site: http://webcamoid.github.io/
+ */
+
+#ifndef AKVCAMUTILS_WORKERPOOL_H
+#define AKVCAMUTILS_WORKERPOOL_H
+
+#include <functional>
+
+namespace AkVCam
+{
+    class WorkerPoolPrivate;
+
+    /* Set of persistent threads that runs a batch of tasks in parallel.
+     * The calling thread also takes tasks, so a pool with N workers runs up
+     * to N + 1 tasks at the same time.
+     */
+    class WorkerPool
+    {
+        public:
+            using Task = std::function<void (int index)>;
+
+            WorkerPool();
+            WorkerPool(const WorkerPool &other) = delete;
+            ~WorkerPool();
+            WorkerPool &operator =(const WorkerPool &other) = delete;
+
+            int workers() const;
+            void setWorkers(int workers);
+
+            // Calls task(index) for each index in [0, nTasks) and blocks until
+            // all of them finished.
+            void run(int nTasks, const Task &task);
+
+        private:
+            WorkerPoolPrivate *d;
+    };
+}
+
+#endif // AKVCAMUTILS_WORKERPOOL_H
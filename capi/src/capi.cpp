@@ -27,6 +27,7 @@
 #include "VCamUtils/src/ipcbridge.h"
 #include "VCamUtils/src/settings.h"
 #include "VCamUtils/src/videoformat.h"
+#include "VCamUtils/src/videoformatspec.h"
 #include "VCamUtils/src/videoframe.h"
 #include "VCamUtils/src/logger.h"
 
@@ -975,6 +976,32 @@ CAPI_EXPORT int vcam_stream_send(void *vcam,
                                  const char **data,
                                  size_t *line_size)
 {
+    return vcam_stream_send_ex(vcam,
+                               device_id,
+                               format,
+                               width,
+                               height,
+                               data,
+                               line_size,
+                               -1,
+                               0,
+                               0);
+}
+
+CAPI_EXPORT int vcam_stream_send_ex(void *vcam,
+                                    const char *device_id,
+                                    const char *format,
+                                    int width,
+                                    int height,
+                                    const char **data,
+                                    size_t *line_size,
+                                    int64_t pts,
+                                    int64_t duration,
+                                    uint64_t sequence)
+{
+    // The frame is captured when sent.
+    auto captureTime = AkVCam::VideoFrame::monotonicTime();
+
     // Validate vcam and device_id
     auto vcamApi = reinterpret_cast<VCamAPI *>(vcam);
 
@@ -1000,9 +1027,10 @@ CAPI_EXPORT int vcam_stream_send(void *vcam,
     if (fourCC == 0)
         return -EINVAL;
 
-    // Check if format is supported
+    // Check if format is supported, the frames are converted to the device
+    // format by the virtual camera, so any input format is valid
     auto formatList =
-            vcamApi->m_bridge.supportedPixelFormats(AkVCam::IpcBridge::StreamType_Output);
+            vcamApi->m_bridge.supportedPixelFormats(AkVCam::IpcBridge::StreamType_Input);
 
     if (std::find(formatList.begin(),
                   formatList.end(),
@@ -1013,24 +1041,42 @@ CAPI_EXPORT int vcam_stream_send(void *vcam,
     if (width < 1 || height < 1 || !data || !line_size)
         return -EINVAL;
 
-    // Create video format and frame
-    AkVCam::VideoFrame frame({fourCC, width, height, {30, 1}});
+    // Wrap the planes of the caller in a frame instead of copying them, the
+    // bridge copies the frame to the device before returning, so the memory
+    // is only borrowed during the call.
+    const size_t maxPlanes = 4;
+    auto nPlanes = AkVCam::VideoFormat::formatSpecs(fourCC).planes();
 
-    // Copy data to frame for each plane
-    for (size_t plane = 0; plane < frame.planes(); ++plane) {
-        if (!data[plane] || line_size[plane] < 1)
-            continue;
+    if (nPlanes < 1 || nPlanes > maxPlanes)
+        return -EINVAL;
 
-        size_t bytesPerLine = frame.lineSize(plane);
-        size_t copySize = std::min<size_t>(bytesPerLine, line_size[plane]);
+    uint8_t *planes[maxPlanes];
+    size_t lineSizes[maxPlanes];
 
-        for (int y = 0; y < height; ++y) {
-            auto line = frame.line(plane, y);
-            auto srcLine = data[plane] + y * line_size[plane];
-            std::memcpy(line, srcLine, copySize);
-        }
+    for (size_t plane = 0; plane < nPlanes; ++plane) {
+        if (!data[plane] || line_size[plane] < 1)
+            return -EINVAL;
+
+        planes[plane] =
+                reinterpret_cast<uint8_t *>(const_cast<char *>(data[plane]));
+        lineSizes[plane] = line_size[plane];
     }
 
+    AkVCam::VideoFrame frame({fourCC, width, height, {30, 1}},
+                             planes,
+                             lineSizes);
+
+    // The lines must hold all the pixels, these are read up to the end of
+    // the last line.
+    for (size_t plane = 0; plane < nPlanes; ++plane)
+        if (lineSizes[plane] < frame.bytesUsed(plane))
+            return -EINVAL;
+
+    frame.setPts(pts);
+    frame.setCaptureTime(captureTime);
+    frame.setDuration(duration);
+    frame.setSequence(sequence);
+
     // Write frame to device
     vcamApi->m_bridge.write(deviceIdStr, frame);
 
@@ -144,7 +144,9 @@ CAPI_EXPORT int vcam_load(void *vcam, const char *settings_ini);
 // Start video streaming to the virtual camera
 CAPI_EXPORT int vcam_stream_start(void *vcam, const char *device_id);
 
-// Send a video to the virtual camera
+// Send a video to the virtual camera. The planes are read without copying
+// them, and the frame is sent before returning, so the memory can be reused
+// after the call. Each line must hold all the pixels of the plane.
 CAPI_EXPORT int vcam_stream_send(void *vcam,
                                  const char *device_id,
                                  const char *format,
@@ -153,6 +155,21 @@ CAPI_EXPORT int vcam_stream_send(void *vcam,
                                  const char **data,
                                  size_t *line_size);
 
+// Same as vcam_stream_send, with the timing of the frame. The presentation
+// timestamp (pts) and the duration are in nanoseconds, and the sequence number
+// counts the frames from 1, so the clients can detect the dropped frames. Pass
+// a negative pts, a zero duration or a zero sequence number when unknown.
+CAPI_EXPORT int vcam_stream_send_ex(void *vcam,
+                                    const char *device_id,
+                                    const char *format,
+                                    int width,
+                                    int height,
+                                    const char **data,
+                                    size_t *line_size,
+                                    int64_t pts,
+                                    int64_t duration,
+                                    uint64_t sequence);
+
 // Stop video streaming
 CAPI_EXPORT int vcam_stream_stop(void *vcam, const char *device_id);
 
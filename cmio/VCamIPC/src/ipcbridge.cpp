@@ -76,6 +76,9 @@ namespace AkVCam
         bool available {false};
         bool run {false};
 
+        // Sequence number of the last frame written.
+        uint64_t sequence {0};
+
         BroadcastSlot()
         {
         }
@@ -102,6 +105,10 @@ namespace AkVCam
         PixelFormat format;
         int width;
         int height;
+        int64_t pts;
+        int64_t captureTime;
+        int64_t duration;
+        uint64_t sequence;
         uint8_t data[1];
     };
 
@@ -579,6 +586,14 @@ bool AkVCam::IpcBridge::write(const std::string &deviceId,
 
     slot.frameMutex.lock();
 
+    // Stamp the frames that don't carry their own capture time and sequence
+    // number, so the clients can measure the latency and detect the dropped
+    // frames.
+    auto captureTime = frame.captureTime() < 0?
+                           VideoFrame::monotonicTime():
+                           frame.captureTime();
+    slot.sequence = frame.sequence() > 0? frame.sequence(): slot.sequence + 1;
+
     if (slot.sharedMemory.isOpen()) {
         auto sharedFrame = reinterpret_cast<SharedFrame *>(slot.sharedMemory.lock());
 
@@ -586,21 +601,30 @@ bool AkVCam::IpcBridge::write(const std::string &deviceId,
             sharedFrame->format = frame.format().format();
             sharedFrame->width = frame.format().width();
             sharedFrame->height = frame.format().height();
-            auto dataSize =
-                    std::min(slot.sharedMemory.pageSize()
-                             - sizeof(SharedFrame)
-                             + sizeof(void *),
-                             frame.size());
-
-            if (dataSize > 0)
-                memcpy(sharedFrame->data, frame.constData(), dataSize);
-
+            sharedFrame->pts = frame.pts();
+            sharedFrame->captureTime = captureTime;
+            sharedFrame->duration = frame.duration();
+            sharedFrame->sequence = slot.sequence;
+            frame.copyTo(sharedFrame->data,
+                         slot.sharedMemory.pageSize()
+                         - sizeof(SharedFrame)
+                         + sizeof(void *));
             slot.sharedMemory.unlock();
             slot.available = true;
             slot.frameAvailable.notify_all();
         }
     } else {
-        slot.frame = frame;
+        // The borrowed memory is only valid during this call, so copy it.
+        if (frame.isBorrowed())
+            slot.frame = frame.copy(0,
+                                    0,
+                                    frame.format().width(),
+                                    frame.format().height());
+        else
+            slot.frame = frame;
+
+        slot.frame.setCaptureTime(captureTime);
+        slot.frame.setSequence(slot.sequence);
         slot.available = true;
         slot.frameAvailable.notify_all();
     }
@@ -881,10 +905,15 @@ bool AkVCam::IpcBridgePrivate::frameReady(const Message &message)
                              + sizeof(void *),
                              slot.frame.size());
 
-            if (dataSize > 0)
+            if (dataSize > 0) {
                 memcpy(slot.frame.data(), sharedFrame->data, dataSize);
-            else
+                slot.frame.setPts(sharedFrame->pts);
+                slot.frame.setCaptureTime(sharedFrame->captureTime);
+                slot.frame.setDuration(sharedFrame->duration);
+                slot.frame.setSequence(sharedFrame->sequence);
+            } else {
                 slot.frame = {};
+            }
 
             slot.sharedMemory.unlock();
         }
@@ -49,6 +49,9 @@ namespace AkVCam
             ClockPtr m_clock;
             UInt64 m_sequence;
             CMTime m_pts;
+
+            // Sequence number of the last input frame sent.
+            uint64_t m_inputSequence {0};
             SampleBufferQueuePtr m_queue;
             CMIODeviceStreamQueueAlteredProc m_queueAltered {nullptr};
             VideoFormat m_format;
@@ -305,6 +308,7 @@ bool AkVCam::Stream::start()
         return false;
 
     this->d->m_sequence = 0;
+    this->d->m_inputSequence = 0;
     memset(&this->d->m_pts, 0, sizeof(CMTime));
     this->d->m_running = this->d->startTimer();
     this->d->m_frameReady = false;
@@ -351,11 +355,22 @@ void AkVCam::Stream::frameReady(const VideoFrame &frame, bool isActive)
 
     this->d->m_mutex.lock();
 
+    if (isActive && this->d->m_frameReady) {
+        auto dropped = VideoFrame::droppedFrames(this->d->m_currentFrame,
+                                                 frame,
+                                                 this->d->m_inputSequence);
+
+        if (dropped > 0)
+            AkLogDebug("%llu frames dropped",
+                       static_cast<unsigned long long>(dropped));
+    }
+
     if (this->d->m_device->directMode()) {
         if (isActive && frame & this->d->m_format.isSameFormat(frame.format())) {
             memcpy(this->d->m_currentFrame.data(),
                    frame.constData(),
                    frame.size());
+            this->d->m_currentFrame.copyTiming(frame);
             this->d->m_frameReady = true;
         } else if (!isActive && this->d->m_testFrame) {
             this->d->m_currentFrame =
@@ -492,6 +507,14 @@ void AkVCam::StreamPrivate::sendFrame(const VideoFrame &frame)
     bool resync = false;
     UInt64 hostTime =
             std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    auto inputSequence = frame.sequence();
+    auto latency = frame.latency();
+
+    if ((inputSequence < 1 || inputSequence != this->m_inputSequence)
+        && latency >= 0)
+        AkLogDebug("Frame latency: %lld ns", static_cast<long long>(latency));
+
     auto pts = CMTimeMake(int64_t(hostTime), 1e9);
     auto ptsDiff = CMTimeGetSeconds(CMTimeSubtract(this->m_pts, pts));
 
@@ -525,8 +548,26 @@ void AkVCam::StreamPrivate::sendFrame(const VideoFrame &frame)
         return;
 
     CVPixelBufferLockBaseAddress(imageBuffer, 0);
-    auto data = CVPixelBufferGetBaseAddress(imageBuffer);
-    memcpy(data, frame.constData(), frame.size());
+    uint8_t *planes[4];
+    size_t lineSizes[4];
+
+    if (CVPixelBufferIsPlanar(imageBuffer)) {
+        auto nPlanes = std::min<size_t>(CVPixelBufferGetPlaneCount(imageBuffer), 4);
+
+        for (size_t plane = 0; plane < nPlanes; ++plane) {
+            planes[plane] =
+                    reinterpret_cast<uint8_t *>(CVPixelBufferGetBaseAddressOfPlane(imageBuffer, plane));
+            lineSizes[plane] = CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, plane);
+        }
+    } else {
+        planes[0] = reinterpret_cast<uint8_t *>(CVPixelBufferGetBaseAddress(imageBuffer));
+        lineSizes[0] = CVPixelBufferGetBytesPerRow(imageBuffer);
+    }
+
+    // Write the frame straight into the pixel buffer, honoring its stride.
+    this->m_videoConverter.begin();
+    this->m_videoConverter.convert(frame, planes, lineSizes);
+    this->m_videoConverter.end();
     CVPixelBufferUnlockBaseAddress(imageBuffer, 0);
 
     CMVideoFormatDescriptionRef format = nullptr;
@@ -558,6 +599,9 @@ void AkVCam::StreamPrivate::sendFrame(const VideoFrame &frame)
     this->m_pts = CMTimeAdd(this->m_pts, duration);
     this->m_sequence++;
 
+    if (inputSequence > 0)
+        this->m_inputSequence = inputSequence;
+
     if (this->m_queueAltered)
         this->m_queueAltered(this->self->m_objectID,
                              buffer,
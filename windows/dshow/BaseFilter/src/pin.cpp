@@ -64,6 +64,9 @@ namespace AkVCam
             IMemInputPin *m_memInputPin {nullptr};
             IMemAllocator *m_memAllocator {nullptr};
             REFERENCE_TIME m_pts {-1};
+
+            // Sequence number of the last input frame sent.
+            uint64_t m_inputSequence {0};
             REFERENCE_TIME m_start {0};
             REFERENCE_TIME m_stop {MAXLONGLONG};
             double m_rate {1.0};
@@ -243,11 +246,12 @@ HRESULT AkVCam::Pin::pause()
             std::lock_guard<std::mutex> lock(this->d->m_mutex);
 
             this->d->m_pts = 0;
+            this->d->m_inputSequence = 0;
             this->d->m_firstFrame = true;
             auto videoFormat = formatFromMediaType(this->d->m_mediaType);
             this->d->m_currentFrame = {videoFormat};
             this->d->m_videoConverter.setOutputFormat(videoFormat);
-            auto specs = VideoFormat::formatSpecs(videoFormat.format());
+            auto &specs = VideoFormat::formatSpecs(videoFormat.format());
             this->d->m_isRgb = specs.type() == VideoFormatSpec::VFT_RGB;
         }
     }
@@ -288,10 +292,11 @@ HRESULT AkVCam::Pin::run(REFERENCE_TIME tStart)
             std::lock_guard<std::mutex> lock(this->d->m_mutex);
 
             this->d->m_pts = 0;
+            this->d->m_inputSequence = 0;
             this->d->m_firstFrame = true;
             this->d->m_currentFrame = {videoFormat};
             this->d->m_videoConverter.setOutputFormat(videoFormat);
-            auto specs = VideoFormat::formatSpecs(videoFormat.format());
+            auto &specs = VideoFormat::formatSpecs(videoFormat.format());
             this->d->m_isRgb = specs.type() == VideoFormatSpec::VFT_RGB;
         }
     }
@@ -320,6 +325,16 @@ void AkVCam::Pin::frameReady(const VideoFrame &frame, bool isActive)
 
     this->d->m_mutex.lock();
 
+    if (isActive && this->d->m_frameReady) {
+        auto dropped = VideoFrame::droppedFrames(this->d->m_currentFrame,
+                                                 frame,
+                                                 this->d->m_inputSequence);
+
+        if (dropped > 0)
+            AkLogDebug("%llu frames dropped",
+                       static_cast<unsigned long long>(dropped));
+    }
+
     auto format = formatFromMediaType(this->d->m_mediaType);
 
     if (this->d->m_directMode) {
@@ -327,6 +342,7 @@ void AkVCam::Pin::frameReady(const VideoFrame &frame, bool isActive)
             memcpy(this->d->m_currentFrame.data(),
                    frame.constData(),
                    frame.size());
+            this->d->m_currentFrame.copyTiming(frame);
             this->d->m_frameReady = true;
         } else if (!isActive && this->d->m_testFrame) {
             this->d->m_currentFrame =
@@ -1154,10 +1170,20 @@ void AkVCam::PinPrivate::sendFrame(void *userData)
         return;
     }
 
+    int64_t latency = -1;
+
     {
         std::lock_guard<std::mutex> lock(self->m_mutex);
 
         if (self->m_frameReady && self->m_currentFrame.size() > 0) {
+            auto inputSequence = self->m_currentFrame.sequence();
+
+            if (inputSequence < 1 || inputSequence != self->m_inputSequence)
+                latency = self->m_currentFrame.latency();
+
+            if (inputSequence > 0)
+                self->m_inputSequence = inputSequence;
+
             if (self->m_isRgb) {
                 auto line = pData;
                 auto lineSize = self->m_currentFrame.lineSize(0);
@@ -1186,6 +1212,9 @@ void AkVCam::PinPrivate::sendFrame(void *userData)
     auto fps = format.fps();
     auto duration = REFERENCE_TIME(TIME_BASE / fps.value());
 
+    if (latency >= 0)
+        AkLogDebug("Frame latency: %lld ns", static_cast<long long>(latency));
+
     auto timeStart = self->m_pts;
     auto timeEnd = timeStart + duration;
 
@@ -81,6 +81,9 @@ namespace AkVCam
             VideoConverter m_videoConverter;
             LONGLONG m_pts {-1};
             LONGLONG m_ptsDrift {0};
+
+            // Sequence number of the last input frame sent.
+            uint64_t m_inputSequence {0};
             bool m_horizontalFlip {false};   // Controlled by client
             bool m_verticalFlip {false};
             LONG m_brightness {0};
@@ -199,6 +202,20 @@ void AkVCam::MediaStream::frameReady(const VideoFrame &frame, bool isActive)
 
     AkLogDebug("Active: %d", isActive);
 
+    if (isActive) {
+        std::lock_guard<std::mutex> lock(this->d->m_mutex);
+
+        if (this->d->m_frameReady) {
+            auto dropped = VideoFrame::droppedFrames(this->d->m_currentFrame,
+                                                     frame,
+                                                     this->d->m_inputSequence);
+
+            if (dropped > 0)
+                AkLogDebug("%llu frames dropped",
+                           static_cast<unsigned long long>(dropped));
+        }
+    }
+
     if (this->d->m_directMode) {
         std::unique_lock<std::mutex> lock(this->d->m_mutex);
 
@@ -206,6 +223,7 @@ void AkVCam::MediaStream::frameReady(const VideoFrame &frame, bool isActive)
             memcpy(this->d->m_currentFrame.data(),
                    frame.constData(),
                    frame.size());
+            this->d->m_currentFrame.copyTiming(frame);
             this->d->m_frameReady = true;
         } else if (!isActive && this->d->m_testFrame) {
             VideoFrame inputFrame = this->d->m_testFrame;
@@ -224,6 +242,7 @@ void AkVCam::MediaStream::frameReady(const VideoFrame &frame, bool isActive)
 
         {
             std::lock_guard<std::mutex> lock(this->d->m_mutex);
+
             inputFrame = isActive? frame: this->d->m_testFrame;
         }
 
@@ -306,6 +325,7 @@ HRESULT AkVCam::MediaStream::start(IMFMediaType *mediaType)
 
     this->d->m_pts = -1;
     this->d->m_ptsDrift = 0;
+    this->d->m_inputSequence = 0;
     this->d->m_format = formatFromMFMediaType(mediaType);
     this->d->m_state = MediaStreamState_Started;
     this->d->m_running = true;
@@ -321,7 +341,7 @@ HRESULT AkVCam::MediaStream::start(IMFMediaType *mediaType)
     this->d->m_mediaType = mediaType;
     this->d->m_mediaType->AddRef();
 
-    auto specs = VideoFormat::formatSpecs(this->d->m_format.format());
+    auto &specs = VideoFormat::formatSpecs(this->d->m_format.format());
     this->d->m_isRgb = specs.type() == VideoFormatSpec::VFT_RGB;
 
     if (this->d->m_bridge)
@@ -594,11 +614,20 @@ HRESULT AkVCam::MediaStreamPrivate::queueSample()
         return hr;
     }
 
+    int64_t latency = -1;
+
     {
         std::lock_guard<std::mutex> lock(this->m_mutex);
 
         if (this->m_frameReady && this->m_currentFrame.size() > 0) {
             DWORD height = this->m_format.height();
+            auto inputSequence = this->m_currentFrame.sequence();
+
+            if (inputSequence < 1 || inputSequence != this->m_inputSequence)
+                latency = this->m_currentFrame.latency();
+
+            if (inputSequence > 0)
+                this->m_inputSequence = inputSequence;
 
             if (this->m_isRgb) {
                 auto lineSize =
@@ -652,6 +681,9 @@ HRESULT AkVCam::MediaStreamPrivate::queueSample()
                         LONGLONG(TIME_BASE / fps.value()):
                         LONGLONG(TIME_BASE / 30.0);
 
+    if (latency >= 0)
+        AkLogDebug("Frame latency: %lld ns", static_cast<long long>(latency));
+
     if (this->m_pts < 0) {
         this->m_pts = 0;
         this->m_ptsDrift = this->m_pts - clock;